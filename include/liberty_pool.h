@@ -0,0 +1,45 @@
+/* SILIMATE: a pool of reference-counted blocks keyed by their content,
+   shared by the decoded numbers (PI.c) and the packed index vectors
+   (liberty_compress.c). A block embeds a liberty_pool_entry; the pool
+   hashes nothing itself, the owner fills in the hash and says when two
+   blocks are the same. */
+
+#ifndef LIBERTY_POOL_H_
+#define LIBERTY_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+struct liberty_pool_entry
+{
+	uint64_t hash;
+	int refs;
+	struct liberty_pool_entry *next;
+};
+
+struct liberty_pool
+{
+	struct liberty_pool_entry **buckets;
+	size_t size, count;
+	long refs; /* over all entries */
+	size_t initial_size; /* a power of two */
+	int (*same)(const struct liberty_pool_entry *x, const struct liberty_pool_entry *y);
+	pthread_mutex_t lock;
+};
+
+#define LIBERTY_POOL_INITIALIZER(initial_size, same) { NULL, 0, 0, 0, initial_size, same, PTHREAD_MUTEX_INITIALIZER }
+
+/* FNV-1a over n bytes, starting from h (LIBERTY_POOL_HASH_SEED for the first) */
+#define LIBERTY_POOL_HASH_SEED 14695981039346656037ull
+uint64_t liberty_pool_hash(uint64_t h, const void *p, size_t n);
+
+/* the pooled entry with e's content, with one more reference; that is e
+   itself when the pool had none, otherwise the caller frees e */
+struct liberty_pool_entry *liberty_pool_intern(struct liberty_pool *pool, struct liberty_pool_entry *e);
+
+/* drop one reference to e; 1 when that was the last and e left the pool,
+   for the caller to free */
+int liberty_pool_release(struct liberty_pool *pool, struct liberty_pool_entry *e);
+
+#endif
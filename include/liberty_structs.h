@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 /* declarations for structures to store the contents of liberty files */
+#include <stdatomic.h>
 #include "libhash.h"
 
 typedef struct liberty_name_list
@@ -61,6 +62,11 @@ struct liberty_group
 		int lineno;
 		char *filename;
 		struct liberty_group *owner;
+		_Atomic(liberty_hash_table *) type_index; /* SILIMATE: lazily built, type -> first child of that type */
+		struct liberty_group *next_of_type; /* SILIMATE: next sibling of the same type, valid while the owner's type_index is */
+		int depth;                          /* SILIMATE: 0 for a top-level group */
+		struct liberty_group *library;      /* SILIMATE: nearest enclosing library, set with owner */
+		struct liberty_group *cell;         /* SILIMATE: nearest enclosing cell, model, scaled_cell or test_cell */
 };
 
 typedef struct liberty_group liberty_group;
@@ -112,6 +118,8 @@ struct liberty_attribute
 		int lineno;
 		char *filename;
 		liberty_group *owner;
+		_Atomic(struct liberty_decoded_numbers *) decoded; /* SILIMATE: see liberty_get_decoded_numbers */
+		_Atomic(struct liberty_formula *) formula; /* SILIMATE: see liberty_get_formula */
 };
 
 typedef struct liberty_attribute liberty_attribute;
@@ -48,6 +48,8 @@ void liberty_strtable_destroy_strtable(liberty_strtable *ht);
 void liberty_strtable_resize_strtable(liberty_strtable *ht, int new_size);
 
 char *liberty_strtable_enter_string(liberty_strtable *ht, char *str);
+
+char *liberty_strtable_store_string(liberty_strtable *ht, char *str); /* SILIMATE: no hash entry */
  
 /* there's no element delete here, because it wouldn't be very useful */
 
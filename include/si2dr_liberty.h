@@ -25,6 +25,8 @@
 #ifndef SI2DR_H
 #define SI2DR_H
 
+#include <stdint.h> /* SILIMATE: for liberty_formula_eval */
+
 #ifdef SI2_ARGS
 #undef SI2_ARGS
 #endif
@@ -91,6 +93,7 @@ typedef void *si2IteratorIdT;
 #define SI2DR_MAX_INT32     2147483647
 
 #define SI2DR_MAX_STRING_LEN  1048576 /*1024*1024*/
+#define SI2DR_SNAPSHOT_VERSION 2 /* SILIMATE: bump when the snapshot image layout changes */
 
 #define SI2DR_TRUE SI2_TRUE
 #define SI2DR_FALSE SI2_FALSE
@@ -187,6 +190,29 @@ typedef struct si2drExprT
 } si2drExprT;
 
 	
+/* SILIMATE: categories of the checks made by si2drCheckLibertyLibrary; the
+   correspondence of groups to the syntax tables is always checked */
+typedef enum si2drCheckCategoryT
+{
+	SI2DR_CHECK_ATTRIBUTES = 0x01, /* attribute types and values */
+	SI2DR_CHECK_TABLES     = 0x02, /* templates and table sizes */
+	SI2DR_CHECK_TIMING     = 0x04,
+	SI2DR_CHECK_SEQUENTIAL = 0x08, /* ff, latch and their banks */
+	SI2DR_CHECK_BUSES      = 0x10, /* bus, bundle and bus_type */
+	SI2DR_CHECK_PINS       = 0x20,
+	SI2DR_CHECK_POWER      = 0x40, /* retention and level shifter cells */
+	SI2DR_CHECK_CCS        = 0x80, /* CCS waveforms and vectors */
+	SI2DR_CHECK_ALL        = 0xff
+} si2drCheckCategoryT;
+
+/* SILIMATE: the element type of the arrays liberty_get_values_data builds */
+typedef enum si2drTablePrecisionT
+{
+	SI2DR_TABLE_LONG_DOUBLE = 0, /* LONG_DOUBLE, as always */
+	SI2DR_TABLE_FLOAT64     = 1, /* double */
+	SI2DR_TABLE_FLOAT32     = 2  /* float */
+} si2drTablePrecisionT;
+
 typedef enum si2drErrorT 
 {
 	SI2DR_NO_ERROR                    	      = 0,
@@ -491,6 +517,11 @@ si2drExprT   *si2drOpExprGetRightExpr SI2_ARGS(( si2drExprT  *expr,
 	si2drGroupsIdT  si2drGroupGetGroups  SI2_ARGS(( si2drGroupIdT group,
 													si2drErrorT  *err));
 
+	/* SILIMATE: only the children of the given type, in order, via a per-group index */
+	si2drGroupsIdT  si2drGroupGetGroupsByType  SI2_ARGS(( si2drGroupIdT group,
+														  si2drStringT  type,
+														  si2drErrorT  *err));
+
 	si2drNamesIdT   si2drGroupGetNames   SI2_ARGS(( si2drGroupIdT group,
 													si2drErrorT  *err));
 
@@ -533,6 +564,18 @@ si2drExprT   *si2drOpExprGetRightExpr SI2_ARGS(( si2drExprT  *expr,
 	si2drObjectIdT   si2drObjectGetOwner          SI2_ARGS(( si2drObjectIdT object,
 															 si2drErrorT  *err));
 
+	/* SILIMATE: the nearest enclosing library, or cell (cell, model,
+	   scaled_cell or test_cell), of a group without walking its owners; a
+	   null id if there is none. The depth of a top-level group is 0. */
+	si2drGroupIdT    si2drGroupGetLibrary         SI2_ARGS(( si2drGroupIdT  group,
+															 si2drErrorT  *err));
+
+	si2drGroupIdT    si2drGroupGetCell            SI2_ARGS(( si2drGroupIdT  group,
+															 si2drErrorT  *err));
+
+	si2drInt32T      si2drGroupGetDepth           SI2_ARGS(( si2drGroupIdT  group,
+															 si2drErrorT  *err));
+
 	si2drBooleanT    si2drObjectIsNull            SI2_ARGS(( si2drObjectIdT object,
 															 si2drErrorT  *err));
 	
@@ -560,6 +603,13 @@ si2drExprT   *si2drOpExprGetRightExpr SI2_ARGS(( si2drExprT  *expr,
 	si2drVoidT       si2drReadLibertyFile         SI2_ARGS(( char *filename,
 															 si2drErrorT  *err));
 
+	/* SILIMATE: dump/reload the whole database as a relocatable image */
+	si2drVoidT       si2drWriteSnapshot           SI2_ARGS(( char *filename,
+															 si2drErrorT  *err));
+
+	si2drVoidT       si2drReadSnapshot            SI2_ARGS(( char *filename,
+															 si2drErrorT  *err));
+
 	si2drVoidT       si2drWriteLibertyFile        SI2_ARGS(( char *filename,
 															 si2drGroupIdT group, 
                                               char* cellname,
@@ -592,6 +642,55 @@ si2drExprT   *si2drOpExprGetRightExpr SI2_ARGS(( si2drExprT  *expr,
 	si2drVoidT     si2drPIUnSetNocheckMode   SI2_ARGS((si2drErrorT  *err));
 	
 	si2drBooleanT  si2drPIGetNocheckMode     SI2_ARGS((si2drErrorT  *err));
+
+	/* SILIMATE: threads used by si2drCheckLibertyLibrary; 0 means one per processor */
+	si2drVoidT     si2drPISetCheckThreads    SI2_ARGS((si2drInt32T threads,
+													   si2drErrorT  *err));
+
+	si2drInt32T    si2drPIGetCheckThreads    SI2_ARGS((si2drErrorT  *err));
+
+	/* SILIMATE: file of per-cell check results reused by si2drCheckLibertyLibrary; NULL for none */
+	si2drVoidT     si2drPISetCheckCache      SI2_ARGS((si2drStringT filename,
+													   si2drErrorT  *err));
+
+	si2drStringT   si2drPIGetCheckCache      SI2_ARGS((si2drErrorT  *err));
+
+	/* SILIMATE: "table" or "json" profile of the check routines on stderr; NULL for none */
+	si2drVoidT     si2drPISetCheckProfile    SI2_ARGS((si2drStringT format,
+													   si2drInt32T  ncells,
+													   si2drErrorT  *err));
+
+	si2drStringT   si2drPIGetCheckProfile    SI2_ARGS((si2drErrorT  *err));
+
+	si2drInt32T    si2drPIGetCheckProfileCells SI2_ARGS((si2drErrorT  *err));
+
+	/* SILIMATE: a mask of si2drCheckCategoryT; checks outside it are not made */
+	si2drVoidT     si2drPISetCheckCategories SI2_ARGS((si2drInt32T categories,
+													   si2drErrorT  *err));
+
+	si2drInt32T    si2drPIGetCheckCategories SI2_ARGS((si2drErrorT  *err));
+
+	/* SILIMATE: stop checking after max_errors errors, and stop checking a cell
+	   after cell_ms milliseconds; 0 means no limit */
+	si2drVoidT     si2drPISetCheckLimits     SI2_ARGS((si2drInt32T max_errors,
+													   si2drInt32T cell_ms,
+													   si2drErrorT  *err));
+
+	si2drInt32T    si2drPIGetCheckMaxErrors  SI2_ARGS((si2drErrorT  *err));
+
+	si2drInt32T    si2drPIGetCheckCellBudget SI2_ARGS((si2drErrorT  *err));
+
+	/* SILIMATE: check messages less severe than min_severity are not reported */
+	si2drVoidT     si2drPISetCheckSeverity   SI2_ARGS((si2drSeverityT min_severity,
+													   si2drErrorT  *err));
+
+	si2drSeverityT si2drPIGetCheckSeverity   SI2_ARGS((si2drErrorT  *err));
+
+	/* SILIMATE: the precision tables are stored in from now on */
+	si2drVoidT     si2drPISetTablePrecision  SI2_ARGS((si2drTablePrecisionT precision,
+													   si2drErrorT  *err));
+
+	si2drTablePrecisionT si2drPIGetTablePrecision SI2_ARGS((si2drErrorT  *err));
 		 
 
 	si2drVoidT     si2drGroupMoveAfter SI2_ARGS((si2drGroupIdT groupToMove, 
@@ -625,13 +724,205 @@ struct liberty_value_data
 							 starting with [0,0,...,0,0], and ending with
 							 [z-1,y-1,....b-1,a-1], where a-z are the max
 							 number of elements in each dimension. */
+	/* SILIMATE: with a FLOAT64 or FLOAT32 table precision, values and
+	   index_info are NULL and these hold the same arrays as double or float */
+	si2drTablePrecisionT precision;
+	void *narrow_values;
+	void **narrow_index_info;
 };
 
 LONG_DOUBLE liberty_get_element(struct liberty_value_data *vd, ...);  /* returns NaN if bounds exceeded */
 
+/* SILIMATE: element pos of the values, and entry i of index dim, in any precision */
+LONG_DOUBLE liberty_get_value_at(const struct liberty_value_data *vd, int pos);
+LONG_DOUBLE liberty_get_index_at(const struct liberty_value_data *vd, int dim, int i);
+
 void liberty_destroy_value_data(struct liberty_value_data *vd);
 
 struct liberty_value_data *liberty_get_values_data( si2drGroupIdT table_group);
+
+/* SILIMATE: a table prepared for interpolation, see src/liberty_interp.c */
+struct liberty_lut
+{
+	int dimensions;
+	int dim_sizes[7];
+	int strides[7];   /* of each dimension in values */
+	double *index[7];
+	double *values;   /* the last index varying fastest */
+};
+
+struct liberty_lut *liberty_lut_prepare(const struct liberty_value_data *vd); /* NULL for a table without values */
+double liberty_lut_lookup(const struct liberty_lut *t, const double *point);   /* one coordinate per dimension */
+/* coords[d][p] is coordinate d of point p; out gets npoints values */
+void liberty_lut_eval(const struct liberty_lut *t, int npoints, const double *const *coords, double *out);
+void liberty_lut_free(struct liberty_lut *t);
+/* the intervals the last lookup through this hint used; one per caller (or
+   thread) and table, zeroed to start. The result is the same as without. */
+struct liberty_lut_hint
+{
+	int interval[7];
+};
+double liberty_lut_lookup_hinted(const struct liberty_lut *t, const double *point, struct liberty_lut_hint *hint);
+
+/* SILIMATE: a compact copy of a table, see src/liberty_compress.c */
+struct liberty_packed_table
+{
+	int dimensions;
+	int dim_sizes[7];
+	unsigned affine;         /* bit d set: index[d] holds the first entry and the step */
+	const double *index[7];  /* pooled, so tables with the same breakpoints share them */
+	int nvalues;
+	int code_bits;           /* 8 or 16; 0 when values holds the exact doubles */
+	double base, scale;      /* value k is base + scale * code k */
+	double max_error;        /* the largest difference from the original values */
+	void *codes;             /* codes or values follow the table in its block */
+	double *values;
+};
+
+/* tolerance is relative to the largest magnitude among the values; 0 keeps
+   them exact. NULL for a table without values. */
+struct liberty_packed_table *liberty_pack_table(const struct liberty_value_data *vd, double tolerance);
+void liberty_free_packed_table(struct liberty_packed_table *pt);
+double liberty_packed_table_bytes(const struct liberty_packed_table *pt); /* with its share of the index vectors */
+double liberty_packed_value_at(const struct liberty_packed_table *pt, int pos);
+double liberty_packed_index_at(const struct liberty_packed_table *pt, int dim, int i);
+void liberty_unpack_values(const struct liberty_packed_table *pt, int first, int count, double *out);
+double liberty_packed_lookup(const struct liberty_packed_table *pt, const double *point); /* as liberty_lut_lookup */
+
+/* SILIMATE: all the tables under a group, packed for bulk passes, see
+   src/liberty_tables.c. Both buffers are 64-byte aligned doubles. */
+struct liberty_table_desc
+{
+	si2drGroupIdT group;
+	int template_id;        /* into template_names: the table's first name */
+	int dimensions;
+	int dim_sizes[7];
+	long index_offset[7];   /* of each index vector in index */
+	long values_offset;     /* in values, the last index varying fastest */
+	long nvalues;
+};
+
+struct liberty_table_store
+{
+	long ntables;
+	struct liberty_table_desc *tables; /* in file order */
+	double *values;
+	long nvalues;
+	double *index;
+	long nindex;
+	int ntemplates;
+	char **template_names;  /* the database's strings; "scalar" for unnamed tables */
+};
+
+struct liberty_table_store *liberty_build_table_store(si2drGroupIdT root); /* NULL if out of memory */
+void liberty_free_table_store(struct liberty_table_store *ts);
+
+/* SILIMATE: the vectors of a CCS output_current_rise or _fall group, see
+   src/liberty_ccs.c. Times are relative to each vector's reference_time. */
+struct liberty_ccs_arc
+{
+	si2drGroupIdT group;
+	int nslew, nload;
+	double *slews;          /* ascending input_net_transition breakpoints */
+	double *loads;          /* ascending total_output_net_capacitance breakpoints */
+	int *vector_at;         /* [s*nload+l]: the vector at slews[s], loads[l], or -1 */
+	int nvectors;
+	double *reference_time;
+	double *charge;         /* the integral of each vector's current */
+	long *offset;           /* nvectors+1; vector k has samples offset[k] .. offset[k+1]-1 */
+	long nsamples;
+	double *times;          /* one block: nsamples times, then nsamples currents */
+	double *currents;
+};
+
+struct liberty_ccs_arc *liberty_ccs_build(si2drGroupIdT group); /* NULL if it has no vectors */
+void liberty_ccs_free(struct liberty_ccs_arc *arc);
+/* out[q*ntimes+j] is the current at times[j] for query q (slews[q], loads[q]) */
+void liberty_ccs_eval(const struct liberty_ccs_arc *arc, int nqueries, const double *slews, const double *loads,
+					  int ntimes, const double *times, double *out);
+void liberty_ccs_charge(const struct liberty_ccs_arc *arc, int nqueries, const double *slews, const double *loads, double *out);
+/* the time each query's waveform has delivered fraction (0..1) of its charge */
+void liberty_ccs_crossing(const struct liberty_ccs_arc *arc, int nqueries, const double *slews, const double *loads,
+						  double fraction, double *out);
+
+/* SILIMATE: the numbers in the values of a complex attribute, decoded the
+   first time anyone asks and kept with the attribute until its values
+   change, so every consumer reads the same array. A string value holds as
+   many numbers as strtod finds in it (separated by commas, blanks, and
+   escaped newlines); a float or int value holds one; others hold none. */
+struct liberty_decoded_numbers
+{
+	int nvalues;
+	int *starts;  /* nvalues+1 entries; value k has nums[starts[k]] .. nums[starts[k+1]-1] */
+	double *nums;
+	int *offsets; /* where each number begins in its string value */
+};
+
+const struct liberty_decoded_numbers *liberty_get_decoded_numbers(si2drAttrIdT attr);
+/* replaces the numbers with nums, as many as were decoded; 0 if attr is
+   not a complex attribute */
+int liberty_set_decoded_numbers(si2drAttrIdT attr, const double *nums);
+/* values, index_N, curve_x/y, reference_time: the lexer stores their
+   strings without hashing them */
+int liberty_numeric_attr(const char *name);
+/* for the parser: adds a string already in the master string table */
+void liberty_complex_attr_add_entered_string(si2drAttrIdT attr, char *string);
+
+/* SILIMATE: identical decoded numbers are stored once and shared; this
+   tells how many attributes reference how many distinct blocks */
+struct liberty_decoded_stats
+{
+	long attributes;
+	long blocks;
+	long numbers_referenced;
+	long numbers_stored;
+	long bytes_referenced; /* what one copy per attribute would take */
+	long bytes_stored;
+};
+
+void liberty_get_decoded_stats(struct liberty_decoded_stats *st);
+
+/* SILIMATE: library units in SI (seconds, farads, volts, amperes, watts,
+   ohms), and normalizing a library into others, see src/liberty_units.c */
+struct liberty_units
+{
+	double time;
+	double capacitance;
+	double voltage;
+	double current;
+	double power;       /* leakage_power_unit */
+	double resistance;  /* pulling_resistance_unit */
+};
+
+/* text such as "1ns", "10ps", "1kohm" or "pf" in units of base ("s", "f",
+   "V", "A", "W", "ohm"); 0 if it is not one */
+double liberty_parse_unit(const char *text, const char *base);
+void liberty_read_units(si2drGroupIdT library, struct liberty_units *u);
+/* rescales the library into target; factors gets library unit / target unit
+   for each quantity. Returns how many numbers were rescaled. */
+long liberty_normalize_units(si2drGroupIdT library, const struct liberty_units *target, struct liberty_units *factors);
+
+/* SILIMATE: a Boolean formula compiled to a stack program over its
+   variables, numbered in order of first appearance. Evaluation takes one
+   word per variable and computes 64 input vectors at once: bit k of the
+   result is the formula applied to bit k of every variable. */
+struct liberty_formula
+{
+	int nvars;
+	char **vars;
+	int ncode;
+	int *code;
+	int depth; /* of the evaluation stack */
+};
+
+struct liberty_formula *liberty_formula_compile(const char *text, int *errpos); /* NULL on a syntax error at text[*errpos] */
+uint64_t liberty_formula_eval(const struct liberty_formula *f, const uint64_t *vars);
+void liberty_formula_truth_table(const struct liberty_formula *f, uint64_t *table); /* 2^nvars bits, at least one word */
+void liberty_formula_free(struct liberty_formula *f);
+
+/* compiled once per simple string attribute and kept until its value
+   changes; NULL if the value is not a string or does not parse */
+const struct liberty_formula *liberty_get_formula(si2drAttrIdT attr);
 	
 #ifdef __cplusplus
 }
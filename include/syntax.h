@@ -120,6 +120,13 @@ typedef struct libsynt_group_info
 		
 		struct libsynt_group_info *next;
 		struct libsynt_group_info *ref; /* if this group is really defined elsewheres */
+		/* SILIMATE: attr_hash and group_hash as arrays indexed by attr_enum and
+		   group_enum; filled in by syntax_check the first time it sees the group */
+		int enum_tables_built;
+		int attr_enum_size;
+		libsynt_attribute_info **attr_by_enum;
+		int group_enum_size;
+		struct libsynt_group_info **group_by_enum;
 		
 } libsynt_group_info;
 
@@ -15,6 +15,21 @@ int main(int argc, char *argv[]) {
 	program.add_argument("--check").help("check the Liberty file for errors").flag();
 	program.add_argument("--debug").help("enable debug mode").flag();
 	program.add_argument("--ignore-complex-attrs").help("ignore complex attributes").flag();
+	program.add_argument("--format").help("output format: json, or jsonl for a library header line and one line per cell").default_value(std::string("json")).choices("json", "jsonl");
+	program.add_argument("--manifest").help("with --format=jsonl, write the byte offset of every line to this file");
+	program.add_argument("--threads").help("number of worker threads (default: one per core)").default_value(0u).scan<'u', unsigned>();
+	program.add_argument("--outdir").help("write library.json and cells/<name>.json into this directory, skipping unchanged cells");
+	program.add_argument("--select").help("convert only the subtrees matching a path, e.g. library/cell[name=~\"DFF*\"]/pin[*]/capacitance");
+	program.add_argument("--check-cache").help("with --check, reuse the results for cells unchanged since the run that wrote this file");
+	program.add_argument("--check-profile").help("with --check, report the time spent in each check and the slowest cells on stderr").choices("table", "json");
+	program.add_argument("--check-profile-cells").help("number of slowest cells in the check profile").default_value(10u).scan<'u', unsigned>();
+	program.add_argument("--check-categories").help("with --check, the checks to make, e.g. tables,timing or all,-ccs (categories: attributes tables timing sequential buses pins power ccs)");
+	program.add_argument("--max-errors").help("with --check, stop after this many errors").default_value(0u).scan<'u', unsigned>();
+	program.add_argument("--cell-time-budget").help("with --check, stop checking a cell after this many milliseconds").default_value(0u).scan<'u', unsigned>();
+	program.add_argument("--min-severity").help("with --check, leave out messages less severe than this").default_value(std::string("note")).choices("note", "warning", "error");
+	program.add_argument("--normalize-units").help("before writing, rescale the library into SI units (\"si\") or those listed, e.g. time=1ps,capacitance=1ff; the factors are recorded in the library");
+	program.add_argument("--stats").help("report on stderr how much identical index vectors and tables are shared").flag();
+	program.add_argument("--cache-dir").help("directory for cached parse snapshots (default: $LIBERTY2JSON_CACHE_DIR)");
   try {
     program.parse_args(argc, argv);
   }
@@ -23,21 +38,69 @@ int main(int argc, char *argv[]) {
     std::cerr << program;
     return 1;
   }
+	if (program.is_used("--select") && (program.is_used("--outdir") || program.get<std::string>("--format") == "jsonl")) {
+		std::cerr << "--select cannot be combined with --outdir or --format=jsonl" << std::endl;
+		return 1;
+	}
 
 	// Parse Liberty file
 	try {
 		if (program.get<bool>("--ignore-complex-attrs")) {
 			LibertyParser::set_ignore_complex_attrs(true);
 		}
+		if (program.is_used("--cache-dir")) {
+			LibertyParser::set_cache_dir(program.get<std::string>("--cache-dir"));
+		}
 		auto parser = new LibertyParser(program.get<std::string>("filename"), program.get<bool>("--debug"));
 		if (program.get<bool>("--check")) {
-			parser->check();
+			string check_cache = program.is_used("--check-cache") ? program.get<std::string>("--check-cache") : "";
+			if (program.is_used("--check-categories")) {
+				parser->set_check_categories(program.get<std::string>("--check-categories"));
+			}
+			string severity = program.get<std::string>("--min-severity");
+			parser->set_check_severity(severity == "error" ? SI2DR_SEVERITY_ERR : severity == "warning" ? SI2DR_SEVERITY_WARN : SI2DR_SEVERITY_NOTE);
+			parser->set_check_limits(program.get<unsigned>("--max-errors"), program.get<unsigned>("--cell-time-budget"));
+			if (program.is_used("--check-profile")) {
+				parser->set_check_profile(program.get<std::string>("--check-profile"), program.get<unsigned>("--check-profile-cells"));
+			}
+			parser->check(program.get<unsigned>("--threads"), check_cache);
 		}
-		if (program.is_used("--outfile")) {
+		if (program.is_used("--normalize-units")) {
+			parser->normalize_units(program.get<std::string>("--normalize-units"));
+		}
+		if (program.is_used("--outdir")) {
+			parser->to_json_dir(program.get<std::string>("--outdir"), program.get<unsigned>("--threads"));
+		} else if (program.get<std::string>("--format") == "jsonl") {
+			unsigned threads = program.get<unsigned>("--threads");
+			string manifest = program.is_used("--manifest") ? program.get<std::string>("--manifest") : "";
+			if (program.is_used("--outfile")) {
+				std::ofstream file(program.get<std::string>("--outfile"));
+				parser->to_jsonl(file, threads, manifest);
+			} else {
+				parser->to_jsonl(std::cout, threads, manifest);
+			}
+		} else if (program.is_used("--select")) {
+			json selection = parser->select(program.get<std::string>("--select"));
+			if (program.is_used("--outfile")) {
+				std::ofstream file(program.get<std::string>("--outfile"));
+				file << selection.dump();
+			} else {
+				std::cout << selection.dump(2) << std::endl;
+			}
+		} else if (program.is_used("--outfile")) {
 			parser->to_json_file(program.get<std::string>("--outfile"));
 		} else {
 			std::cout << parser->as_json().dump(2) << std::endl;
 		}
+		if (program.get<bool>("--stats")) {
+			json stats = parser->stats();
+			long referenced = stats["bytes_referenced"], stored = stats["bytes_stored"];
+			std::cerr << "Decoded numbers: " << stats["attributes"] << " attributes share " << stats["blocks"] << " blocks" << std::endl;
+			std::cerr << "  numbers: " << stats["numbers_referenced"] << " referenced, " << stats["numbers_stored"] << " stored" << std::endl;
+			std::cerr << "  bytes:   " << referenced << " referenced, " << stored << " stored";
+			if (stored) std::cerr << " (" << (double)referenced / stored << "x smaller)";
+			std::cerr << std::endl;
+		}
 	} catch (std::exception &e) {
 		std::cerr << "FATAL: " << e.what() << std::endl;
 		return 1;
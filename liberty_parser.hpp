@@ -1,20 +1,342 @@
+#include <fnmatch.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
 #include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+#include <unistd.h>
 #include "include/si2dr_liberty.h"
 #include "lib/json.hpp"
 using string = std::string;
 using json = nlohmann::json;
 
+// A table whose dimension count is known at compile time, viewed in place
+// (see LibertyTable::view). The last index varies fastest; indexing is not
+// bounds checked, and the loops over dimensions unroll.
+template <int N, typename T = double>
+class LibertyTableView {
+	static_assert(N >= 1 && N <= 7, "tables have 1 to 7 dimensions");
+	public:
+		LibertyTableView(const T *values, const int *sizes, const T *const *index) : values(values) {
+			for (int d = 0; d < N; d++) {
+				dims[d] = sizes[d];
+				indices[d] = index[d];
+			}
+			strides[N - 1] = 1;
+			for (int d = N - 1; d > 0; d--) strides[d - 1] = strides[d] * dims[d];
+		}
+		static constexpr int dimensions() { return N; }
+		int size(int dim) const { return dims[dim]; }
+		T index(int dim, int i) const { return indices[dim][i]; }
+		template <typename... I>
+		size_t offset(I... i) const {
+			static_assert(sizeof...(I) == N, "wrong number of table indices");
+			size_t pos = 0;
+			int d = 0;
+			((pos = pos * dims[d++] + size_t(i)), ...);
+			return pos;
+		}
+		template <typename... I>
+		T operator()(I... i) const { return values[offset(i...)]; }
+		// The interpolation of liberty_lut_lookup, term for term
+		template <typename... X>
+		T interpolate(X... x) const {
+			static_assert(sizeof...(X) == N, "wrong number of table coordinates");
+			const T point[N] = {T(x)...};
+			T w[N], r = 0;
+			size_t base = 0;
+			for (int d = 0; d < N; d++) {
+				w[d] = 0;
+				if (dims[d] < 2) continue;
+				int i = _interval(indices[d], dims[d], point[d]);
+				if (indices[d][i + 1] != indices[d][i]) w[d] = (point[d] - indices[d][i]) / (indices[d][i + 1] - indices[d][i]);
+				base += size_t(i) * strides[d];
+			}
+			for (int c = 0; c < (1 << N); c++) {
+				T weight = 1;
+				size_t off = base;
+				int d;
+				for (d = 0; d < N; d++) {
+					if (c >> d & 1) {
+						if (dims[d] < 2) break;
+						weight *= w[d];
+						off += strides[d];
+					} else {
+						weight *= 1 - w[d];
+					}
+				}
+				if (d == N) r += weight * values[off];
+			}
+			return r;
+		}
+	private:
+		static int _interval(const T *idx, int n, T x) {
+			int lo = 0, hi = n - 2;
+			while (lo < hi) {
+				int mid = (lo + hi + 1) / 2;
+				if (idx[mid] <= x) lo = mid; else hi = mid - 1;
+			}
+			return lo;
+		}
+		const T *values;
+		const T *indices[N];
+		int dims[N];
+		size_t strides[N];
+};
+
+// A table packed to within a tolerance (see liberty_pack_table), for
+// keeping many corners resident; values are unpacked on access
+class LibertyPackedTable {
+	public:
+		LibertyPackedTable(const liberty_value_data *data, double tolerance) : packed(liberty_pack_table(data, tolerance), liberty_free_packed_table) {
+			if (!packed) throw std::out_of_range("table has no values");
+		}
+		int dimensions() const { return packed->dimensions; }
+		int size(int dim) const { return packed->dim_sizes[dim]; }
+		// Its own block and its share of the pooled index vectors
+		double bytes() const { return liberty_packed_table_bytes(packed.get()); }
+		double max_error() const { return packed->max_error; }
+		std::vector<double> index(int dim) const {
+			std::vector<double> result(size(dim));
+			for (int i = 0; i < size(dim); i++) result[i] = liberty_packed_index_at(packed.get(), dim, i);
+			return result;
+		}
+		std::vector<double> values() const {
+			std::vector<double> result(packed->nvalues);
+			liberty_unpack_values(packed.get(), 0, packed->nvalues, result.data());
+			return result;
+		}
+		double interpolate(const std::vector<double> &point) const {
+			if ((int)point.size() != dimensions()) throw std::out_of_range("wrong number of table coordinates");
+			return liberty_packed_lookup(packed.get(), point.data());
+		}
+	private:
+		std::unique_ptr<liberty_packed_table, void (*)(liberty_packed_table *)> packed;
+};
+
+// Decoded lookup table of a table group (cell_rise, rise_power, ...)
+class LibertyTable {
+	public:
+		explicit LibertyTable(si2drGroupIdT group) : data(liberty_get_values_data(group), liberty_destroy_value_data), lut(liberty_lut_prepare(data.get()), liberty_lut_free) {}
+		int dimensions() const { return data->dimensions; }
+		int size(int dim) const { return data->dim_sizes[dim]; }
+		std::vector<double> index(int dim) const {
+			std::vector<double> result(size(dim));
+			for (int i = 0; i < size(dim); i++) result[i] = liberty_get_index_at(data.get(), dim, i);
+			return result;
+		}
+		// All values, with the last index varying fastest
+		std::vector<double> values() const {
+			size_t n = 1;
+			for (int i = 0; i < dimensions(); i++) n *= size(i);
+			std::vector<double> result(n);
+			for (size_t i = 0; i < n; i++) result[i] = liberty_get_value_at(data.get(), (int)i);
+			return result;
+		}
+		double at(const std::vector<int> &indices) const {
+			if ((int)indices.size() != dimensions()) throw std::out_of_range("wrong number of table indices");
+			size_t pos = 0;
+			for (int i = 0; i < dimensions(); i++) {
+				if (indices[i] < 0 || indices[i] >= size(i)) throw std::out_of_range("table index out of range");
+				pos = pos * size(i) + indices[i];
+			}
+			return liberty_get_value_at(data.get(), (int)pos);
+		}
+		// A fixed-dimension view of the stored arrays when T is the element type
+		// of the table precision (see LibertyParser::set_table_precision), or of
+		// the double copy; it lives as long as this table
+		template <int N, typename T = double>
+		LibertyTableView<N, T> view() const {
+			if (dimensions() != N) throw std::out_of_range("table does not have " + std::to_string(N) + " dimensions");
+			if constexpr (std::is_same<T, LONG_DOUBLE>::value) {
+				if (data->precision == SI2DR_TABLE_LONG_DOUBLE) return LibertyTableView<N, T>(data->values, data->dim_sizes, data->index_info);
+			}
+			if (data->precision == _precision_of<T>() && data->narrow_values) {
+				return LibertyTableView<N, T>(static_cast<const T *>(data->narrow_values), data->dim_sizes, reinterpret_cast<const T *const *>(data->narrow_index_info));
+			}
+			if constexpr (std::is_same<T, double>::value) {
+				if (!lut) throw std::out_of_range("table has no values");
+				return LibertyTableView<N, T>(lut->values, lut->dim_sizes, lut->index);
+			}
+			throw std::invalid_argument("table is not stored in this precision");
+		}
+		// Multilinear interpolation, extrapolating past the ends of an index
+		double interpolate(const std::vector<double> &point) const {
+			if ((int)point.size() != dimensions()) throw std::out_of_range("wrong number of table coordinates");
+			if (!lut) throw std::out_of_range("table has no values");
+			return liberty_lut_lookup(lut.get(), point.data());
+		}
+		// The same, starting from the intervals the last lookup with this hint
+		// used; for a caller whose coordinates move slowly
+		double interpolate(const std::vector<double> &point, liberty_lut_hint &hint) const {
+			if ((int)point.size() != dimensions()) throw std::out_of_range("wrong number of table coordinates");
+			if (!lut) throw std::out_of_range("table has no values");
+			return liberty_lut_lookup_hinted(lut.get(), point.data(), &hint);
+		}
+		// A batch of points, coords[d][p] being coordinate d of point p
+		std::vector<double> interpolate(const std::vector<std::vector<double>> &coords) const {
+			if ((int)coords.size() != dimensions()) throw std::out_of_range("wrong number of table coordinates");
+			if (!lut) throw std::out_of_range("table has no values");
+			size_t n = coords.empty() ? 1 : coords[0].size();
+			std::vector<const double *> columns;
+			for (const std::vector<double> &c : coords) {
+				if (c.size() != n) throw std::invalid_argument("coordinate arrays differ in length");
+				columns.push_back(c.data());
+			}
+			std::vector<double> result(n);
+			liberty_lut_eval(lut.get(), (int)n, columns.data(), result.data());
+			return result;
+		}
+		// A compact copy, every value within tolerance times the largest
+		// magnitude of the original (0 keeps them exact)
+		LibertyPackedTable pack(double tolerance) const {
+			return LibertyPackedTable(data.get(), tolerance);
+		}
+	private:
+		template <typename T>
+		static constexpr si2drTablePrecisionT _precision_of() {
+			return std::is_same<T, float>::value ? SI2DR_TABLE_FLOAT32 : std::is_same<T, double>::value ? SI2DR_TABLE_FLOAT64 : SI2DR_TABLE_LONG_DOUBLE;
+		}
+		std::unique_ptr<liberty_value_data, void (*)(liberty_value_data *)> data;
+		std::unique_ptr<liberty_lut, void (*)(liberty_lut *)> lut;
+};
+
+// Compiled Boolean formula of a function, next_state, clear, ... attribute,
+// with each variable bound to the pin of that name in the cell (a null id
+// for an internal node such as IQ, or a bus)
+class LibertyFormula {
+	public:
+		LibertyFormula(const liberty_formula *f, std::vector<si2drGroupIdT> pins) : f(f), bound(std::move(pins)) {}
+		int size() const { return f->nvars; }
+		string variable(int var) const { return f->vars[var]; }
+		si2drGroupIdT pin(int var) const { return bound.at(var); }
+		// One word per variable; bit k of the result is the formula at bit k of
+		// every variable, so each call evaluates 64 input vectors
+		uint64_t evaluate(const std::vector<uint64_t> &vars) const {
+			if ((int)vars.size() != size()) throw std::invalid_argument("wrong number of formula variables");
+			return liberty_formula_eval(f, vars.data());
+		}
+		// Bit r is the formula with variable i set to bit i of r
+		std::vector<uint64_t> truth_table() const {
+			if (size() > 30) throw std::out_of_range("too many variables for a truth table");
+			std::vector<uint64_t> table(size() <= 6 ? 1 : size_t(1) << (size() - 6));
+			liberty_formula_truth_table(f, table.data());
+			return table;
+		}
+	private:
+		const liberty_formula *f; // kept with the attribute
+		std::vector<si2drGroupIdT> bound;
+};
+
+// Every table under a group packed into two aligned buffers of doubles (see
+// liberty_build_table_store), for passes over all of them at once
+class LibertyTableStore {
+	public:
+		explicit LibertyTableStore(si2drGroupIdT root) : store(liberty_build_table_store(root), liberty_free_table_store) {
+			if (!store) throw std::bad_alloc();
+		}
+		size_t size() const { return store->ntables; }
+		const liberty_table_desc &descriptor(size_t table) const { return store->tables[table]; }
+		string template_name(size_t table) const { return store->template_names[store->tables[table].template_id]; }
+		double *values(size_t table) { return store->values + store->tables[table].values_offset; }
+		const double *index(size_t table, int dim) const { return store->index + store->tables[table].index_offset[dim]; }
+		// All the values, table after table
+		double *values() { return store->values; }
+		size_t value_count() const { return store->nvalues; }
+		// fn(first, count) on one contiguous slice of the values per thread (0
+		// means one per core); every slice but the last is a multiple of 64 bytes
+		void for_each_chunk(const std::function<void(double *, size_t)> &fn, unsigned threads = 0) {
+			if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+			size_t n = value_count(), chunk = (n / threads + 7) & ~size_t(7);
+			if (chunk == 0) chunk = 8;
+			std::vector<std::thread> workers;
+			for (size_t first = 0; first < n; first += chunk) {
+				workers.emplace_back(fn, values() + first, std::min(chunk, n - first));
+			}
+			for (std::thread &w : workers) w.join();
+		}
+	private:
+		std::unique_ptr<liberty_table_store, void (*)(liberty_table_store *)> store;
+};
+
+// The vectors of a CCS output_current_rise or _fall group in one block (see
+// liberty_ccs_build); each call evaluates a batch of (slew, load) queries
+class LibertyCcsArc {
+	public:
+		explicit LibertyCcsArc(si2drGroupIdT group) : arc(liberty_ccs_build(group), liberty_ccs_free) {
+			if (!arc) throw std::out_of_range("no CCS vectors");
+		}
+		const liberty_ccs_arc &data() const { return *arc; }
+		// Row q holds the current of query q at each of the times, which are
+		// relative to the reference time
+		std::vector<double> waveforms(const std::vector<double> &slews, const std::vector<double> &loads, const std::vector<double> &times) const {
+			_check(slews, loads);
+			std::vector<double> result(slews.size() * times.size());
+			liberty_ccs_eval(arc.get(), (int)slews.size(), slews.data(), loads.data(), (int)times.size(), times.data(), result.data());
+			return result;
+		}
+		std::vector<double> charge(const std::vector<double> &slews, const std::vector<double> &loads) const {
+			_check(slews, loads);
+			std::vector<double> result(slews.size());
+			liberty_ccs_charge(arc.get(), (int)slews.size(), slews.data(), loads.data(), result.data());
+			return result;
+		}
+		// When each waveform has delivered fraction of its charge, e.g. 0.5 for
+		// the delay point
+		std::vector<double> crossing(const std::vector<double> &slews, const std::vector<double> &loads, double fraction = 0.5) const {
+			_check(slews, loads);
+			std::vector<double> result(slews.size());
+			liberty_ccs_crossing(arc.get(), (int)slews.size(), slews.data(), loads.data(), fraction, result.data());
+			return result;
+		}
+	private:
+		static void _check(const std::vector<double> &slews, const std::vector<double> &loads) {
+			if (slews.size() != loads.size()) throw std::invalid_argument("slew and load arrays differ in length");
+		}
+		std::unique_ptr<liberty_ccs_arc, void (*)(liberty_ccs_arc *)> arc;
+};
+
 // C++ wrapper for Synopsys Liberty parser
 class LibertyParser {
 	public:
 		LibertyParser(string filename, bool debug=false) {
 			set_debug_mode(debug);
 			si2drPIInit(&err); 
+			// Reuse the cached snapshot of an unchanged file when there is one
+			string snapshot = _snapshot_path(filename);
+			if (!snapshot.empty()) {
+				si2drReadSnapshot(const_cast<char *>(snapshot.c_str()), &err);
+				if (err == SI2DR_NO_ERROR) return;
+			}
+			// Count parser messages, so a file that draws diagnostics is never cached
+			// and its messages are repeated on every read
+			_parse_messages() = 0;
+			_parse_handler() = si2drPIGetMessageHandler(&err);
+			if (!snapshot.empty()) si2drPISetMessageHandler(_counting_handler, &err);
 			si2drReadLibertyFile(strdup(filename.c_str()), &err);
+			si2drErrorT herr;
+			si2drPISetMessageHandler(_parse_handler(), &herr);
 			if (err == SI2DR_SYNTAX_ERROR) {
 				throw std::invalid_argument(get_error_text());
 			}
+			if (!snapshot.empty() && err == SI2DR_NO_ERROR && _parse_messages() == 0) {
+				_write_snapshot(snapshot);
+			}
 		}
 		~LibertyParser() { si2drPIQuit(&err); }
 		bool get_debug_mode() {
@@ -27,16 +349,62 @@ class LibertyParser {
 				si2drPIUnSetDebugMode(&err);
 			}
 		}
-		int check() {
+		// Cells are checked on `threads` workers (0 means one per core); the
+		// messages come out in the same order whatever the count. With a
+		// cache_file, cells unchanged since the last check are not checked again.
+		int check(unsigned threads = 1, string cache_file = "") {
+			si2drPISetCheckThreads(threads, &err);
+			si2drPISetCheckCache(cache_file.empty() ? NULL : const_cast<char *>(cache_file.c_str()), &err);
 			si2drGroupsIdT groups = si2drPIGetGroups(&err);
 			si2drGroupIdT group;
 			while (!si2drObjectIsNull((group=si2drIterNextGroup(groups, &err)), &err)) {
 				si2drCheckLibertyLibrary(group, &err);
-				if (err != SI2DR_NO_ERROR) return err;
+				if (err != SI2DR_NO_ERROR) break;
 			}
-			si2drIterQuit(groups, &err);
+			si2drErrorT qerr;
+			si2drIterQuit(groups, &qerr);
 			return err;
 		}
+		// With a format ("table" or "json"), check() reports the time spent in
+		// each check routine and the slowest cells on stderr
+		void set_check_profile(string format, unsigned cells = 10) {
+			si2drPISetCheckProfile(format.empty() ? NULL : const_cast<char *>(format.c_str()), cells, &err);
+		}
+		// Turns check categories on and off: "tables,timing" makes only those
+		// checks, "all,-ccs,-power" all but those. See check_category_names.
+		void set_check_categories(string spec) {
+			int mask = spec.empty() || spec[0] == '-' ? SI2DR_CHECK_ALL : 0;
+			std::stringstream items(spec);
+			string item;
+			while (std::getline(items, item, ',')) {
+				bool off = !item.empty() && item[0] == '-';
+				string name = off ? item.substr(1) : item;
+				auto found = check_category_names.find(name);
+				if (found == check_category_names.end()) throw std::invalid_argument("unknown check category '" + name + "'");
+				mask = off ? mask & ~found->second : mask | found->second;
+			}
+			si2drPISetCheckCategories(mask, &err);
+		}
+		// check() stops after max_errors errors, and gives up on a cell after
+		// cell_ms milliseconds; 0 means no limit
+		void set_check_limits(unsigned max_errors, unsigned cell_ms = 0) {
+			si2drPISetCheckLimits(max_errors, cell_ms, &err);
+		}
+		// check() leaves out messages less severe than this
+		void set_check_severity(si2drSeverityT min_severity) {
+			si2drPISetCheckSeverity(min_severity, &err);
+		}
+		inline static const std::map<string, int> check_category_names = {
+			{"all", SI2DR_CHECK_ALL},
+			{"attributes", SI2DR_CHECK_ATTRIBUTES},
+			{"tables", SI2DR_CHECK_TABLES},
+			{"timing", SI2DR_CHECK_TIMING},
+			{"sequential", SI2DR_CHECK_SEQUENTIAL},
+			{"buses", SI2DR_CHECK_BUSES},
+			{"pins", SI2DR_CHECK_PINS},
+			{"power", SI2DR_CHECK_POWER},
+			{"ccs", SI2DR_CHECK_CCS},
+		};
 		string get_error_text() {
 			return si2drPIGetErrorText(err, &err);
 		}
@@ -47,6 +415,247 @@ class LibertyParser {
 			si2drIterQuit(groups, &err);
 			return result;
 		}
+		json as_json(si2drGroupIdT group) {
+			return _group2json(group);
+		}
+		// Indexed lookups; these walk the group hashes and the per-type child
+		// index, never the whole library. Like the converters they keep their own
+		// error slot, so several threads may query one parser at once.
+		si2drGroupIdT library() {
+			si2drErrorT err;
+			si2drGroupsIdT groups = si2drPIGetGroups(&err);
+			si2drGroupIdT group = si2drIterNextGroup(groups, &err);
+			si2drIterQuit(groups, &err);
+			if (si2drObjectIsNull(group, &err)) throw std::out_of_range("no library");
+			return group;
+		}
+		si2drGroupIdT cell(string name) {
+			return _find(library(), "cell", name);
+		}
+		si2drGroupIdT pin(string cell_name, string name) {
+			si2drErrorT err;
+			si2drGroupIdT p = _find_pin(cell(cell_name), name);
+			if (si2drObjectIsNull(p, &err)) throw std::out_of_range("no pin " + name + " in cell " + cell_name);
+			return p;
+		}
+		// Children of one type, in file order
+		std::vector<si2drGroupIdT> groups(si2drGroupIdT parent, string type) {
+			si2drErrorT err;
+			std::vector<si2drGroupIdT> result;
+			si2drGroupsIdT iter = si2drGroupGetGroupsByType(parent, const_cast<char *>(type.c_str()), &err);
+			si2drGroupIdT group;
+			while (!si2drObjectIsNull((group=si2drIterNextGroup(iter, &err)), &err)) {
+				result.push_back(group);
+			}
+			si2drIterQuit(iter, &err);
+			return result;
+		}
+		// timing groups of a pin, or of every pin under a cell, bus or bundle
+		std::vector<si2drGroupIdT> timing_arcs(si2drGroupIdT group) {
+			std::vector<si2drGroupIdT> result = groups(group, "timing");
+			for (const char *container : {"pin", "bus", "bundle"}) {
+				for (si2drGroupIdT sub : groups(group, container)) {
+					std::vector<si2drGroupIdT> arcs = timing_arcs(sub);
+					result.insert(result.end(), arcs.begin(), arcs.end());
+				}
+			}
+			return result;
+		}
+		LibertyTableStore table_store() {
+			return LibertyTableStore(library());
+		}
+		// How far identical index vectors and value tables are shared: every
+		// complex attribute is decoded first, so the counts cover the library
+		json stats() {
+			si2drGroupsIdT groups = si2drPIGetGroups(&err);
+			si2drGroupIdT group;
+			while (!si2drObjectIsNull((group=si2drIterNextGroup(groups, &err)), &err)) {
+				_decode_all(group);
+			}
+			si2drIterQuit(groups, &err);
+			liberty_decoded_stats st;
+			liberty_get_decoded_stats(&st);
+			return {
+				{"attributes", st.attributes}, {"blocks", st.blocks},
+				{"numbers_referenced", st.numbers_referenced}, {"numbers_stored", st.numbers_stored},
+				{"bytes_referenced", st.bytes_referenced}, {"bytes_stored", st.bytes_stored},
+			};
+		}
+		// Element type of the tables read from now on; FLOAT32 takes a quarter
+		// of the memory of LONG_DOUBLE
+		void set_table_precision(si2drTablePrecisionT precision) {
+			si2drPISetTablePrecision(precision, &err);
+		}
+		// Rescale the library into other units, once: "si" for seconds, farads,
+		// volts, amperes, watts and ohms, or a list such as
+		// "time=1ps,capacitance=1ff,power=1nW" (quantities left out keep the
+		// library's unit). The converted JSON of the library records the result
+		// under "unit_normalization", which this returns.
+		json normalize_units(string spec = "si") {
+			si2drGroupIdT lib = library();
+			liberty_units target, factors;
+			liberty_read_units(lib, &target);
+			if (spec == "si") {
+				target = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+			} else {
+				std::stringstream items(spec);
+				string item;
+				while (std::getline(items, item, ',')) {
+					size_t eq = item.find('=');
+					string name = item.substr(0, eq);
+					auto found = unit_quantities.find(name);
+					if (eq == string::npos || found == unit_quantities.end()) throw std::invalid_argument("unknown unit quantity '" + name + "'");
+					double si = liberty_parse_unit(item.c_str() + eq + 1, found->second.second);
+					if (si <= 0.0) throw std::invalid_argument("bad unit '" + item.substr(eq + 1) + "' for " + name);
+					target.*(found->second.first) = si;
+				}
+			}
+			long scaled = liberty_normalize_units(lib, &target, &factors);
+			json units, scale;
+			for (const auto &q : unit_quantities) {
+				units[q.first] = target.*(q.second.first);
+				scale[q.first] = factors.*(q.second.first);
+			}
+			scale["energy"] = factors.capacitance * factors.voltage * factors.voltage;
+			_units = {{"units", units}, {"factors", scale}, {"numbers", scaled}};
+			return _units;
+		}
+		inline static const std::map<string, std::pair<double liberty_units::*, const char *>> unit_quantities = {
+			{"time", {&liberty_units::time, "s"}},
+			{"capacitance", {&liberty_units::capacitance, "f"}},
+			{"voltage", {&liberty_units::voltage, "V"}},
+			{"current", {&liberty_units::current, "A"}},
+			{"power", {&liberty_units::power, "W"}},
+			{"resistance", {&liberty_units::resistance, "ohm"}},
+		};
+		LibertyTable table(si2drGroupIdT group) {
+			return LibertyTable(group);
+		}
+		// The output_current_rise or _fall group of a timing group
+		LibertyCcsArc ccs(si2drGroupIdT timing, string type="output_current_rise") {
+			std::vector<si2drGroupIdT> found = groups(timing, type);
+			if (found.empty()) throw std::out_of_range("no " + type + " group");
+			return LibertyCcsArc(found[0]);
+		}
+		// The formula in an attribute of a pin, ff, latch, ... group; parsed once
+		// per attribute, with its variables bound in the enclosing cell
+		LibertyFormula formula(si2drGroupIdT group, string attr="function") {
+			si2drErrorT err;
+			si2drAttrIdT a = si2drGroupFindAttrByName(group, const_cast<char *>(attr.c_str()), &err);
+			if (si2drObjectIsNull(a, &err)) throw std::out_of_range("no " + attr + " attribute");
+			const liberty_formula *f = liberty_get_formula(a);
+			if (!f) throw std::invalid_argument("the " + attr + " attribute is not a Boolean formula");
+			si2drGroupIdT c = si2drGroupGetCell(group, &err);
+			std::vector<si2drGroupIdT> pins;
+			for (int i = 0; i < f->nvars; i++) {
+				pins.push_back(si2drObjectIsNull(c, &err) ? c : _find_pin(c, f->vars[i]));
+			}
+			return LibertyFormula(f, pins);
+		}
+		// Convert only the subtrees a path selects, e.g.
+		//   library/cell[name=~"DFF*"]/pin[*]/capacitance
+		// Each step is a group type, optionally filtered by [*], [name="x"] (a hash
+		// lookup) or [name=~"glob"]; the last step may name an attribute instead.
+		// Returns an array of {"path": ..., "value": ...}.
+		json select(string path) {
+			std::vector<_step> steps = _parse_path(path);
+			json result = json::array();
+			si2drGroupsIdT groups = si2drPIGetGroups(&err);
+			si2drGroupIdT group;
+			while (!si2drObjectIsNull((group=si2drIterNextGroup(groups, &err)), &err)) {
+				if (si2drGroupGetGroupType(group, &err) == steps[0].type && _matches(group, steps[0])) {
+					_select(group, _step_name(group), steps, 1, result);
+				}
+			}
+			si2drIterQuit(groups, &err);
+			return result;
+		}
+		// JSON Lines: the library header (attributes, defines and every group but
+		// the cells), then one line per cell. Cells are converted on worker threads
+		// (0 = one per core) and written in file order. If manifest is given, it
+		// gets the name, byte offset and length of every line.
+		void to_jsonl(std::ostream &out, unsigned threads = 0, string manifest = "") {
+			si2drGroupIdT lib = library();
+			std::vector<si2drGroupIdT> cells = groups(lib, "cell");
+			json lines = json::array();
+			uint64_t offset = 0;
+			auto emit = [&](const string &name, const string &line) {
+				out << line << '\n';
+				lines.push_back({{"name", name}, {"offset", offset}, {"length", line.size() + 1}});
+				offset += line.size() + 1;
+			};
+			emit(_first_name(lib), _group2json(lib, "cell").dump());
+			_ordered_parallel<string>(cells.size(), threads,
+				[&](size_t i) { return _group2json(cells[i]).dump(); },
+				[&](size_t i, string &line) { emit(_first_name(cells[i]), line); });
+			if (!manifest.empty()) {
+				std::ofstream file(manifest);
+				file << json({{"format", "jsonl"}, {"lines", lines}}).dump(2) << std::endl;
+			}
+		}
+		// A directory with library.json (the same header as to_jsonl) and one
+		// cells/<name>.json per cell, written by worker threads. manifest.json keeps
+		// a content hash per file; files whose hash has not changed are not
+		// rewritten, and cells that are gone are removed. Returns the number of
+		// files written.
+		size_t to_json_dir(string dirname, unsigned threads = 0) {
+			namespace fs = std::filesystem;
+			fs::path dir(dirname);
+			fs::create_directories(dir / "cells");
+			json old_manifest;
+			std::ifstream old_file(dir / "manifest.json");
+			if (old_file) {
+				try {
+					old_file >> old_manifest;
+				} catch (json::exception &) {
+					old_manifest = json();  // unreadable: rewrite everything
+				}
+			}
+			// read-only from here on: the workers below look it up concurrently
+			const json old_files = old_manifest.is_object() && old_manifest.contains("files") && old_manifest["files"].is_object() ? old_manifest["files"] : json::object();
+			std::atomic<size_t> written(0);
+			// write unless the old manifest already has this content
+			auto put = [&](const string &rel, const string &content) {
+				string hash = _hex(_fnv1a(content.data(), content.size()));
+				fs::path path = dir / rel;
+				if (!(old_files.contains(rel) && old_files.at(rel) == hash && fs::exists(path))) {
+					fs::path tmp = path;
+					tmp += ".tmp";
+					std::ofstream file(tmp, std::ios::binary);
+					file.write(content.data(), content.size());
+					file.close();
+					if (!file) throw std::runtime_error("could not write " + tmp.string());
+					fs::rename(tmp, path);
+					written++;
+				}
+				return hash;
+			};
+
+			si2drGroupIdT lib = library();
+			std::vector<si2drGroupIdT> cells = groups(lib, "cell");
+			json files = json::object();
+			files["library.json"] = put("library.json", _group2json(lib, "cell").dump());
+			std::vector<string> rels = _cell_file_names(cells);
+			_ordered_parallel<string>(cells.size(), threads,
+				[&](size_t i) { return put(rels[i], _group2json(cells[i]).dump()); },
+				[&](size_t i, string &hash) { files[rels[i]] = hash; });
+			for (auto &old : old_files.items()) {
+				if (!files.contains(old.key()) && _inside(old.key())) fs::remove(dir / old.key());
+			}
+			std::ofstream manifest(dir / "manifest.json");
+			manifest << json({{"files", files}}).dump(2) << std::endl;
+			return written;
+		}
+		// A manifest entry names a file under the output directory; anything
+		// absolute or climbing out with ".." is not ours to remove
+		static bool _inside(const string &rel) {
+			std::filesystem::path path(rel);
+			if (rel.empty() || path.is_absolute() || path.has_root_name()) return false;
+			for (const auto &part : path) {
+				if (part == "..") return false;
+			}
+			return true;
+		}
 		void to_json_file(string filename) {
 			std::ofstream file(filename);
 			file << as_json().dump();
@@ -63,10 +672,311 @@ class LibertyParser {
 				si2drPIUnSetIgnoreComplexAttrs();
 			}
 		}
+		// Directory of parse snapshots keyed by file content; empty disables caching.
+		// Defaults to $LIBERTY2JSON_CACHE_DIR.
+		static string get_cache_dir() {
+			return _cache_dir();
+		}
+		static void set_cache_dir(string dir) {
+			_cache_dir() = dir;
+		}
 	private:
 		si2drErrorT err;
+		json _units; // set by normalize_units
 
-		json _group2json(si2drGroupIdT group) {
+		static string &_cache_dir() {
+			static string dir = getenv("LIBERTY2JSON_CACHE_DIR") ? getenv("LIBERTY2JSON_CACHE_DIR") : "";
+			return dir;
+		}
+		struct _step {
+			string type;
+			enum { ALL, NAME, GLOB } filter = ALL;
+			string pattern;
+		};
+		static std::vector<_step> _parse_path(const string &path) {
+			std::vector<_step> steps;
+			size_t i = 0;
+			auto fail = [&path](const string &why) {
+				throw std::invalid_argument("bad selection path '" + path + "': " + why);
+			};
+			while (i < path.size()) {
+				_step step;
+				size_t end = path.find_first_of("/[", i);
+				step.type = path.substr(i, end == string::npos ? string::npos : end - i);
+				if (step.type.empty()) fail("empty step");
+				i = end == string::npos ? path.size() : end;
+				if (i < path.size() && path[i] == '[') {
+					i++;
+					if (path.compare(i, 2, "*]") == 0) {
+						i += 2;
+					} else {
+						if (path.compare(i, 4, "name") != 0) fail("expected [*] or [name=...]");
+						i += 4;
+						if (path.compare(i, 2, "=~") == 0) {
+							step.filter = _step::GLOB;
+							i += 2;
+						} else if (path.compare(i, 1, "=") == 0) {
+							step.filter = _step::NAME;
+							i += 1;
+						} else {
+							fail("expected = or =~");
+						}
+						if (i < path.size() && path[i] == '"') {
+							size_t close = path.find('"', i + 1);
+							if (close == string::npos) fail("unterminated string");
+							step.pattern = path.substr(i + 1, close - i - 1);
+							i = close + 1;
+						} else {
+							size_t close = path.find(']', i);
+							if (close == string::npos) fail("missing ]");
+							step.pattern = path.substr(i, close - i);
+							i = close;
+						}
+						if (i >= path.size() || path[i] != ']') fail("missing ]");
+						i++;
+					}
+				}
+				if (i < path.size()) {
+					if (path[i] != '/') fail("expected /");
+					i++;
+				}
+				steps.push_back(step);
+			}
+			if (steps.empty()) fail("empty path");
+			return steps;
+		}
+		bool _matches(si2drGroupIdT group, const _step &step) {
+			if (step.filter == _step::ALL) return true;
+			bool found = false;
+			si2drNamesIdT names = si2drGroupGetNames(group, &err);
+			si2drStringT name;
+			while (!found && (name=si2drIterNextName(names, &err))) {
+				found = step.filter == _step::NAME ? step.pattern == name : fnmatch(step.pattern.c_str(), name, 0) == 0;
+			}
+			si2drIterQuit(names, &err);
+			return found;
+		}
+		string _step_name(si2drGroupIdT group) {
+			string result = si2drGroupGetGroupType(group, &err);
+			si2drNamesIdT names = si2drGroupGetNames(group, &err);
+			si2drStringT name;
+			string sep = "(";
+			while ((name=si2drIterNextName(names, &err))) {
+				result += sep + name;
+				sep = ",";
+			}
+			si2drIterQuit(names, &err);
+			return sep == "," ? result + ")" : result;
+		}
+		void _select(si2drGroupIdT group, const string &path, const std::vector<_step> &steps, size_t i, json &result) {
+			if (i == steps.size()) {
+				result.push_back({{"path", path}, {"value", _group2json(group)}});
+				return;
+			}
+			const _step &step = steps[i];
+			if (i + 1 == steps.size() && step.filter == _step::ALL) {
+				si2drErrorT lerr;
+				si2drAttrIdT attr = si2drGroupFindAttrByName(group, const_cast<char *>(step.type.c_str()), &lerr);
+				if (!si2drObjectIsNull(attr, &lerr)) {
+					json value = si2drAttrGetAttrType(attr, &err) == SI2DR_SIMPLE ? _simpleattr2json(attr) : _complexattr2json(attr);
+					result.push_back({{"path", path + "/" + step.type}, {"value", value}});
+					return;
+				}
+			}
+			if (step.filter == _step::NAME) {
+				si2drGroupIdT sub = _lookup(group, step.type, step.pattern);
+				if (!si2drObjectIsNull(sub, &err)) _select(sub, path + "/" + _step_name(sub), steps, i + 1, result);
+				return;
+			}
+			for (si2drGroupIdT sub : groups(group, step.type)) {
+				if (_matches(sub, step)) _select(sub, path + "/" + _step_name(sub), steps, i + 1, result);
+			}
+		}
+		// cells/<name>.json, with anything unsafe in a file name replaced and
+		// collisions numbered
+		std::vector<string> _cell_file_names(const std::vector<si2drGroupIdT> &cells) {
+			std::vector<string> result;
+			std::unordered_set<string> used;
+			for (si2drGroupIdT cell : cells) {
+				string base = _first_name(cell);
+				for (char &c : base) {
+					if (!isalnum((unsigned char)c) && c != '_' && c != '-' && c != '.') c = '_';
+				}
+				if (base.empty() || base[0] == '.') base = "_" + base;
+				string name = base;
+				for (int n = 1; !used.insert(name).second; n++) {
+					name = base + "-" + std::to_string(n);
+				}
+				result.push_back("cells/" + name + ".json");
+			}
+			return result;
+		}
+		string _first_name(si2drGroupIdT group) {
+			si2drErrorT lerr;
+			si2drNamesIdT names = si2drGroupGetNames(group, &lerr);
+			si2drStringT name = si2drIterNextName(names, &lerr);
+			si2drIterQuit(names, &lerr);
+			return name ? name : "";
+		}
+		// Run produce(i) for every i < n on worker threads and hand the results to
+		// consume(i, result) on the calling thread, in order. Workers run at most a
+		// bounded window ahead of the consumer, so memory stays flat.
+		template <typename T>
+		static void _ordered_parallel(size_t n, unsigned threads, std::function<T(size_t)> produce, std::function<void(size_t, T &)> consume) {
+			if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+			const size_t window = 8 * threads;
+			std::mutex m;
+			std::condition_variable cv;
+			std::vector<T> results(n);
+			std::vector<char> ready(n, 0);
+			size_t next = 0, consumed = 0;
+			std::exception_ptr error;
+			auto worker = [&]() {
+				for (;;) {
+					size_t i;
+					{
+						std::unique_lock<std::mutex> lock(m);
+						cv.wait(lock, [&] { return error || next >= n || next < consumed + window; });
+						if (error || next >= n) return;
+						i = next++;
+					}
+					try {
+						T result = produce(i);
+						std::lock_guard<std::mutex> lock(m);
+						results[i] = std::move(result);
+						ready[i] = 1;
+					} catch (...) {
+						std::lock_guard<std::mutex> lock(m);
+						if (!error) error = std::current_exception();
+					}
+					cv.notify_all();
+				}
+			};
+			std::vector<std::thread> pool;
+			for (unsigned t = 0; t < threads && t < n; t++) pool.emplace_back(worker);
+			for (size_t i = 0; i < n; i++) {
+				T result;
+				{
+					std::unique_lock<std::mutex> lock(m);
+					cv.wait(lock, [&] { return error || ready[i]; });
+					if (error) break;
+					result = std::move(results[i]);
+				}
+				try {
+					consume(i, result);
+				} catch (...) {
+					std::lock_guard<std::mutex> lock(m);
+					error = std::current_exception();
+				}
+				{
+					std::lock_guard<std::mutex> lock(m);
+					consumed = i + 1;
+				}
+				cv.notify_all();
+			}
+			for (std::thread &t : pool) t.join();
+			if (error) std::rethrow_exception(error);
+		}
+		// group_hash lookup that leaves err alone and returns the null id when absent
+		si2drGroupIdT _lookup(si2drGroupIdT parent, string type, string name) {
+			si2drErrorT lerr;
+			bool debug = si2drPIGetDebugMode(&lerr);
+			if (debug) si2drPIUnSetDebugMode(&lerr);
+			si2drGroupIdT group = si2drGroupFindGroupByName(parent, const_cast<char *>(name.c_str()), const_cast<char *>(type.c_str()), &lerr);
+			if (debug) si2drPISetDebugMode(&lerr);
+			return group;
+		}
+		void _decode_all(si2drGroupIdT group) {
+			si2drAttrsIdT attrs = si2drGroupGetAttrs(group, &err);
+			si2drAttrIdT attr;
+			while (!si2drObjectIsNull((attr=si2drIterNextAttr(attrs, &err)), &err)) {
+				if (si2drAttrGetAttrType(attr, &err) == SI2DR_COMPLEX) liberty_get_decoded_numbers(attr);
+			}
+			si2drIterQuit(attrs, &err);
+			si2drGroupsIdT groups = si2drGroupGetGroups(group, &err);
+			si2drGroupIdT sub;
+			while (!si2drObjectIsNull((sub=si2drIterNextGroup(groups, &err)), &err)) {
+				_decode_all(sub);
+			}
+			si2drIterQuit(groups, &err);
+		}
+		// a null id if there is no such pin
+		si2drGroupIdT _find_pin(si2drGroupIdT cell, string name) {
+			si2drErrorT err;
+			si2drGroupIdT p = _lookup(cell, "pin", name);
+			if (!si2drObjectIsNull(p, &err)) return p;
+			// bus and bundle members are pins one level down
+			for (const char *container : {"bus", "bundle"}) {
+				for (si2drGroupIdT b : groups(cell, container)) {
+					p = _lookup(b, "pin", name);
+					if (!si2drObjectIsNull(p, &err)) return p;
+				}
+			}
+			return p;
+		}
+		si2drGroupIdT _find(si2drGroupIdT parent, string type, string name) {
+			si2drErrorT err;
+			si2drGroupIdT group = _lookup(parent, type, name);
+			if (si2drObjectIsNull(group, &err)) throw std::out_of_range("no " + type + " " + name);
+			return group;
+		}
+		static int &_parse_messages() {
+			static int count = 0;
+			return count;
+		}
+		static si2drMessageHandlerT &_parse_handler() {
+			static si2drMessageHandlerT handler = nullptr;
+			return handler;
+		}
+		static si2drVoidT _counting_handler(si2drSeverityT sev, si2drErrorT errToPrint, si2drStringT auxText, si2drErrorT *err) {
+			_parse_messages()++;
+			(*_parse_handler())(sev, errToPrint, auxText, err);
+		}
+		static uint64_t _fnv1a(const char *data, size_t len, uint64_t hash = 14695981039346656037ULL) {
+			for (size_t i = 0; i < len; i++) {
+				hash ^= (unsigned char)data[i];
+				hash *= 1099511628211ULL;
+			}
+			return hash;
+		}
+		static string _hex(uint64_t hash) {
+			char buf[17];
+			snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)hash);
+			return buf;
+		}
+		// FNV-1a over the file's path and contents and everything else that shapes
+		// the database (the file names are part of it). A library that reads
+		// include files is never cached, see si2drWriteSnapshot.
+		string _snapshot_path(string filename) {
+			if (_cache_dir().empty()) return "";
+			std::ifstream file(filename, std::ios::binary);
+			if (!file) return "";
+			std::error_code ec;
+			string salt = "v" + std::to_string(SI2DR_SNAPSHOT_VERSION) + (get_ignore_complex_attrs() ? "i" : "c")
+				+ std::filesystem::absolute(filename, ec).string() + '\0' + filename + '\0';
+			uint64_t hash = _fnv1a(salt.data(), salt.size());
+			char buf[1 << 16];
+			while (file.read(buf, sizeof(buf)) || file.gcount() > 0) {
+				hash = _fnv1a(buf, file.gcount(), hash);
+			}
+			return (std::filesystem::path(_cache_dir()) / (_hex(hash) + ".snap")).string();
+		}
+		// Write to a temporary name first so concurrent readers never see a partial image
+		void _write_snapshot(string snapshot) {
+			std::error_code ec;
+			std::filesystem::create_directories(std::filesystem::path(snapshot).parent_path(), ec);
+			string tmp = snapshot + ".tmp." + std::to_string(getpid());
+			si2drErrorT serr;
+			si2drWriteSnapshot(const_cast<char *>(tmp.c_str()), &serr);
+			if (serr != SI2DR_NO_ERROR || std::rename(tmp.c_str(), snapshot.c_str()) != 0) {
+				std::remove(tmp.c_str());
+			}
+		}
+
+		// The converters keep their own error slot, so subtrees can be converted on
+		// several threads at once. skip_type leaves out children of that type.
+		json _group2json(si2drGroupIdT group, const string &skip_type = "") {
+			si2drErrorT err;
 			json j;
 			// Group names
 			si2drNamesIdT gnames = si2drGroupGetNames(group, &err);
@@ -101,15 +1011,20 @@ class LibertyParser {
 			si2drGroupsIdT groups = si2drGroupGetGroups(group, &err);
 			si2drGroupIdT group2;
 			while (!si2drObjectIsNull((group2=si2drIterNextGroup(groups, &err)), &err)) {
+				if (!skip_type.empty() && skip_type == si2drGroupGetGroupType(group2, &err)) continue;
 				j["groups"].push_back(_group2json(group2));
 			}
 			si2drIterQuit(groups, &err);
+			if (!_units.is_null() && string(si2drGroupGetGroupType(group, &err)) == "library") {
+				j["unit_normalization"] = _units;
+			}
 			json jfinal = {
 				{si2drGroupGetGroupType(group, &err), j}
 			};
 			return jfinal;
 		}
 		json _simpleattr2json(si2drAttrIdT attr) {
+			si2drErrorT err;
 			json j;
 			si2drValueTypeT type = si2drSimpleAttrGetValueType(attr, &err);
 			switch (type) {
@@ -136,6 +1051,7 @@ class LibertyParser {
 			return j;
 		}
 		json _complexattr2json(si2drAttrIdT attr) {
+			si2drErrorT err;
 			json j;
 			si2drValuesIdT values = si2drComplexAttrGetValues(attr, &err);
 			si2drValueTypeT type;
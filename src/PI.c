@@ -21,6 +21,14 @@ rights and limitations under the License.
 #include <alloca.h>
 #include <stdarg.h>
 #include <math.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "liberty_structs.h"
 #include "libhash.h"
 #include "libstrtab.h"
@@ -28,6 +36,7 @@ rights and limitations under the License.
 #include "string.h"
 #include "group_enum.h"
 #include "attr_enum.h"
+#include "liberty_pool.h"
 typedef struct libGroupMap { char *name; group_enum type; } libGroupMap;
 typedef struct libAttrMap { char *name; attr_enum type; } libAttrMap;
 
@@ -57,11 +66,105 @@ liberty_strtable *master_string_table;
 
 static si2drObjectIdT nulloid = {0,0};
 
+/* SILIMATE: images mapped by si2drReadSnapshot, unmapped at si2drPIQuit */
+typedef struct liberty_snapshot_map
+{
+   void *base;
+   size_t len;
+   struct liberty_snapshot_map *next;
+} liberty_snapshot_map;
+
+static liberty_snapshot_map *snapshot_maps;
+
+/* SILIMATE: the per-type child index. A group's type_index maps a group type to
+   its first child of that type, and those children are chained in list order
+   through next_of_type. It is built on first use, and dropped whenever the
+   group's child list changes, so parsing never pays for it. Readers may
+   build it from several threads at once: one builds it under
+   type_index_lock, and it is published with a release store only after
+   every next_of_type link is set, so a reader that sees the index through
+   an acquire load also sees the chains. */
+static pthread_mutex_t type_index_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void drop_type_index(liberty_group *g)
+{
+   liberty_hash_table *t;
+
+   if( g && (t = atomic_exchange(&g->type_index, NULL)) )
+      liberty_hash_destroy_hash_table(t);
+}
+
+/* SILIMATE: depth and enclosing library and cell, inherited from the owner
+   when a group is linked under it */
+static void set_group_owner(liberty_group *g, liberty_group *owner)
+{
+   g->owner = owner;
+   if( !owner )
+      return;
+   g->depth = owner->depth + 1;
+   g->library = owner->EVAL == LIBERTY_GROUPENUM_library ? owner : owner->library;
+   switch( owner->EVAL )
+   {
+      case LIBERTY_GROUPENUM_cell:
+      case LIBERTY_GROUPENUM_model:
+      case LIBERTY_GROUPENUM_scaled_cell:
+      case LIBERTY_GROUPENUM_test_cell:
+         g->cell = owner;
+         break;
+      default:
+         g->cell = owner->cell;
+         break;
+   }
+}
+
+static liberty_hash_table *get_type_index(liberty_group *g)
+{
+   liberty_hash_table *t;
+   liberty_group *sg, **kids;
+   si2drObjectIdT oid;
+   int n, i;
+
+   t = atomic_load_explicit(&g->type_index, memory_order_acquire);
+   if( t )
+      return t;
+   pthread_mutex_lock(&type_index_lock);
+   t = atomic_load_explicit(&g->type_index, memory_order_relaxed);
+   if( t )
+   {
+      pthread_mutex_unlock(&type_index_lock);
+      return t;
+   }
+   for(n=0, sg=g->group_list; sg; sg=sg->next)
+      n++;
+   t = liberty_hash_create_hash_table(11, 1, 0);
+   kids = (liberty_group**)malloc((n ? n : 1) * sizeof(liberty_group*));
+   for(i=0, sg=g->group_list; sg; sg=sg->next)
+      kids[i++] = sg;
+
+   /* back to front, so each child is pushed onto the head of its type's chain */
+   for(i=n-1; i>=0; i--)
+   {
+      sg = kids[i];
+      liberty_hash_lookup(t, sg->type, &oid);
+      sg->next_of_type = (liberty_group*)oid.v2;
+      if( oid.v1 != (void*)0 )
+         liberty_hash_delete_elem(t, sg->type);
+      oid.v1 = (void*)SI2DR_GROUP;
+      oid.v2 = (void*)sg;
+      liberty_hash_enter_oid(t, sg->type, oid);
+   }
+   free(kids);
+   atomic_store_explicit(&g->type_index, t, memory_order_release);
+   pthread_mutex_unlock(&type_index_lock);
+   return t;
+}
+
 typedef enum
 {
    ITER_NAME,
    ITER_VAL,
    ITER_GROUP,
+   ITER_GROUP_OF_TYPE, /* SILIMATE: follows next_of_type instead of next */
    ITER_ATTR,
    ITER_DEF,
    ITER_NOTHING
@@ -87,14 +190,27 @@ void lib__write_group(FILE *of, si2drGroupIdT group, char *indent, char *cellnam
 
 void create_floating_define_for_cell_area(si2drStringT string);
 
-static int l__iter_group_count = 0;
-static int l__iter_name_count = 0;
-static int l__iter_val_count = 0;
-static int l__iter_attr_count = 0;
-static int l__iter_def_count = 0;
+static void drop_decoded_numbers(liberty_attribute *a);
+static void drop_formula(liberty_attribute *a);
+
+/* SILIMATE: atomic, so a read-only database can be walked from several threads */
+static atomic_int l__iter_group_count = 0;
+static atomic_int l__iter_name_count = 0;
+static atomic_int l__iter_val_count = 0;
+static atomic_int l__iter_attr_count = 0;
+static atomic_int l__iter_def_count = 0;
 static int liberty___debug_mode = 0;
 static int liberty___nocheck_mode = 0;
 static int liberty___ignore_complex_attrs = 0;
+static int liberty___check_threads = 1; /* SILIMATE: worker threads for si2drCheckLibertyLibrary */
+static char *liberty___check_cache = 0; /* SILIMATE: file of cached per-cell check results */
+static char *liberty___check_profile = 0; /* SILIMATE: "table" or "json" to profile the checks */
+static int liberty___check_profile_cells = 10;
+static int liberty___check_categories = SI2DR_CHECK_ALL; /* SILIMATE: which checks si2drCheckLibertyLibrary makes */
+static int liberty___check_max_errors = 0;
+static int liberty___check_cell_ms = 0;
+static si2drSeverityT liberty___check_severity = SI2DR_SEVERITY_NOTE; /* SILIMATE: least severe check message reported */
+static si2drTablePrecisionT liberty___table_precision = SI2DR_TABLE_LONG_DOUBLE; /* SILIMATE: element type of liberty_value_data */
 static FILE *liberty___trace_mode_CFP = 0;
 static FILE *liberty___trace_mode_HFP = 0;
 
@@ -199,6 +315,7 @@ static char *iter_string(si2drIterIdT iter)
          break;
 
       case ITER_GROUP:
+      case ITER_GROUP_OF_TYPE:
          itype = "GROUP";
          break;
 
@@ -240,6 +357,7 @@ static char *itype_string(si2drIterIdT iter)
          break;
 
       case ITER_GROUP:
+      case ITER_GROUP_OF_TYPE:
          itype = "si2drGroupsIdT";
          break;
 
@@ -414,6 +532,229 @@ si2drBooleanT  si2drPIGetNocheckMode(si2drErrorT  *err)
       return SI2DR_FALSE;
 }
 
+/* SILIMATE: the cells of a library are checked on this many threads;
+   0 means one per processor */
+si2drVoidT  si2drPISetCheckThreads(si2drInt32T threads, si2drErrorT  *err)
+{
+   if( threads < 0 )
+   {
+      *err = SI2DR_INVALID_VALUE;
+      return;
+   }
+   liberty___check_threads = threads;
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPISetCheckThreads(%ld,&err);\n\n", threads);
+      inc_tracecount();
+   }
+}
+
+si2drInt32T  si2drPIGetCheckThreads(si2drErrorT  *err)
+{
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPIGetCheckThreads(&err);\n\n");
+      inc_tracecount();
+   }
+   return liberty___check_threads;
+}
+
+/* SILIMATE: si2drCheckLibertyLibrary replays the messages of unchanged cells
+   from this file and rewrites it; NULL turns the cache off */
+si2drVoidT  si2drPISetCheckCache(si2drStringT filename, si2drErrorT  *err)
+{
+   free(liberty___check_cache);
+   liberty___check_cache = filename && *filename ? strdup(filename) : 0;
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPISetCheckCache(\"%s\",&err);\n\n", filename ? filename : "");
+      inc_tracecount();
+   }
+}
+
+si2drStringT  si2drPIGetCheckCache(si2drErrorT  *err)
+{
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPIGetCheckCache(&err);\n\n");
+      inc_tracecount();
+   }
+   return liberty___check_cache;
+}
+
+/* SILIMATE: si2drCheckLibertyLibrary times its check routines and the
+   slowest ncells cells, and reports them on stderr as a "table" or "json";
+   a NULL format turns profiling off */
+si2drVoidT  si2drPISetCheckProfile(si2drStringT format, si2drInt32T ncells, si2drErrorT  *err)
+{
+   if( (format && strcmp(format,"table") && strcmp(format,"json")) || ncells < 0 )
+   {
+      *err = SI2DR_INVALID_VALUE;
+      return;
+   }
+   free(liberty___check_profile);
+   liberty___check_profile = format ? strdup(format) : 0;
+   liberty___check_profile_cells = ncells;
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPISetCheckProfile(\"%s\",%ld,&err);\n\n", format ? format : "", ncells);
+      inc_tracecount();
+   }
+}
+
+si2drStringT  si2drPIGetCheckProfile(si2drErrorT  *err)
+{
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPIGetCheckProfile(&err);\n\n");
+      inc_tracecount();
+   }
+   return liberty___check_profile;
+}
+
+si2drInt32T  si2drPIGetCheckProfileCells(si2drErrorT  *err)
+{
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPIGetCheckProfileCells(&err);\n\n");
+      inc_tracecount();
+   }
+   return liberty___check_profile_cells;
+}
+
+/* SILIMATE: si2drCheckLibertyLibrary only makes the checks in these
+   categories (a mask of si2drCheckCategoryT) */
+si2drVoidT  si2drPISetCheckCategories(si2drInt32T categories, si2drErrorT  *err)
+{
+   if( categories & ~SI2DR_CHECK_ALL )
+   {
+      *err = SI2DR_INVALID_VALUE;
+      return;
+   }
+   liberty___check_categories = categories;
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPISetCheckCategories(%ld,&err);\n\n", categories);
+      inc_tracecount();
+   }
+}
+
+si2drInt32T  si2drPIGetCheckCategories(si2drErrorT  *err)
+{
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPIGetCheckCategories(&err);\n\n");
+      inc_tracecount();
+   }
+   return liberty___check_categories;
+}
+
+/* SILIMATE: si2drCheckLibertyLibrary gives up after max_errors errors, and on
+   a cell after cell_ms milliseconds; 0 means no limit */
+si2drVoidT  si2drPISetCheckLimits(si2drInt32T max_errors, si2drInt32T cell_ms, si2drErrorT  *err)
+{
+   if( max_errors < 0 || cell_ms < 0 )
+   {
+      *err = SI2DR_INVALID_VALUE;
+      return;
+   }
+   liberty___check_max_errors = max_errors;
+   liberty___check_cell_ms = cell_ms;
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPISetCheckLimits(%ld,%ld,&err);\n\n", max_errors, cell_ms);
+      inc_tracecount();
+   }
+}
+
+si2drInt32T  si2drPIGetCheckMaxErrors(si2drErrorT  *err)
+{
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPIGetCheckMaxErrors(&err);\n\n");
+      inc_tracecount();
+   }
+   return liberty___check_max_errors;
+}
+
+si2drInt32T  si2drPIGetCheckCellBudget(si2drErrorT  *err)
+{
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPIGetCheckCellBudget(&err);\n\n");
+      inc_tracecount();
+   }
+   return liberty___check_cell_ms;
+}
+
+/* SILIMATE: si2drCheckLibertyLibrary drops messages less severe than this
+   without formatting them */
+si2drVoidT  si2drPISetCheckSeverity(si2drSeverityT min_severity, si2drErrorT  *err)
+{
+   if( min_severity < SI2DR_SEVERITY_NOTE || min_severity > SI2DR_SEVERITY_ERR )
+   {
+      *err = SI2DR_INVALID_VALUE;
+      return;
+   }
+   liberty___check_severity = min_severity;
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPISetCheckSeverity(%d,&err);\n\n", min_severity);
+      inc_tracecount();
+   }
+}
+
+si2drSeverityT  si2drPIGetCheckSeverity(si2drErrorT  *err)
+{
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPIGetCheckSeverity(&err);\n\n");
+      inc_tracecount();
+   }
+   return liberty___check_severity;
+}
+
+si2drVoidT  si2drPISetTablePrecision(si2drTablePrecisionT precision, si2drErrorT  *err)
+{
+   if( precision < SI2DR_TABLE_LONG_DOUBLE || precision > SI2DR_TABLE_FLOAT32 )
+   {
+      *err = SI2DR_INVALID_VALUE;
+      return;
+   }
+   liberty___table_precision = precision;
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPISetTablePrecision(%d,&err);\n\n", precision);
+      inc_tracecount();
+   }
+}
+
+si2drTablePrecisionT  si2drPIGetTablePrecision(si2drErrorT  *err)
+{
+   *err = SI2DR_NO_ERROR;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drPIGetTablePrecision(&err);\n\n");
+      inc_tracecount();
+   }
+   return liberty___table_precision;
+}
+
 si2drVoidT  si2drDefaultMessageHandler(si2drSeverityT sev,
       si2drErrorT errToPrint,
       si2drStringT auxText,
@@ -942,6 +1283,8 @@ si2drVoidT     si2drComplexAttrAddInt32Value        ( si2drAttrIdT attr,
    y->type = LIBERTY__VAL_INT;
    y->u.int_val = intgr;
 
+   drop_decoded_numbers(x);
+
    /* link the attr struct into the lists */
    if( x->last_value )
    {
@@ -1005,6 +1348,8 @@ si2drVoidT     si2drComplexAttrAddStringValue       ( si2drAttrIdT attr,
    y->type = LIBERTY__VAL_STRING;
    y->u.string_val = liberty_strtable_enter_string(master_string_table,string);
 
+   drop_decoded_numbers(x);
+
    /* link the attr struct into the lists */
    if( x->last_value )
    {
@@ -1023,6 +1368,55 @@ si2drVoidT     si2drComplexAttrAddStringValue       ( si2drAttrIdT attr,
 
 
 
+/* SILIMATE: the attributes whose quoted strings are lists of numbers. The
+   lexer keeps those strings out of the string table's hash: each is unique
+   text that nobody looks up, and it is decoded only when first read. */
+int liberty_numeric_attr(const char *name)
+{
+   switch( name[0] )
+   {
+   case 'v':
+      return !strcmp(name, "values");
+   case 'i':
+      return !strncmp(name, "index_", 6) && name[6] >= '1' && name[6] <= '7' && !name[7];
+   case 'c':
+      return !strcmp(name, "curve_x") || !strcmp(name, "curve_y");
+   case 'r':
+      return !strcmp(name, "reference_time");
+   default:
+      return 0;
+   }
+}
+
+/* SILIMATE: the parser's way to add a string value: the string already lives
+   in master_string_table, so it is linked in as is. */
+void liberty_complex_attr_add_entered_string(si2drAttrIdT attr, char *string)
+{
+   liberty_attribute *x = (liberty_attribute*)attr.v2;
+   liberty_attribute_value *y;
+   si2drErrorT err;
+
+   if( trace )
+   {
+      si2drComplexAttrAddStringValue(attr, string, &err);
+      return;
+   }
+   y = (liberty_attribute_value*)my_calloc(sizeof(liberty_attribute_value),1);
+   y->type = LIBERTY__VAL_STRING;
+   y->u.string_val = string;
+   drop_decoded_numbers(x);
+   if( x->last_value )
+   {
+      x->last_value->next = y;
+      x->last_value = y;
+   }
+   else
+   {
+      x->last_value = y;
+      x->value = y;
+   }
+}
+
 si2drVoidT     si2drComplexAttrAddBooleanValue      ( si2drAttrIdT attr,
       si2drBooleanT   boolval,
       si2drErrorT     *err )
@@ -1069,6 +1463,8 @@ si2drVoidT     si2drComplexAttrAddBooleanValue      ( si2drAttrIdT attr,
    y->type = LIBERTY__VAL_BOOLEAN;
    y->u.int_val = boolval;
 
+   drop_decoded_numbers(x);
+
    /* link the attr struct into the lists */
    if( x->last_value )
    {
@@ -1133,6 +1529,8 @@ si2drVoidT     si2drComplexAttrAddFloat64Value      ( si2drAttrIdT attr,
    y->type = LIBERTY__VAL_DOUBLE;
    y->u.double_val = float64;
 
+   drop_decoded_numbers(x);
+
    /* link the attr struct into the lists */
    if( x->last_value )
    {
@@ -1759,6 +2157,7 @@ si2drVoidT       si2drSimpleAttrSetInt32Value       ( si2drAttrIdT attr,
    {
       x->value = (liberty_attribute_value*)my_calloc(sizeof(liberty_attribute_value),1);
    }
+   drop_formula(x);
    x->value->type = LIBERTY__VAL_INT;
    x->value->u.int_val = intgr;
 
@@ -1812,6 +2211,7 @@ si2drVoidT       si2drSimpleAttrSetBooleanValue     ( si2drAttrIdT   attr,
    {
       x->value = (liberty_attribute_value*)my_calloc(sizeof(liberty_attribute_value),1);
    }
+   drop_formula(x);
    x->value->type = LIBERTY__VAL_BOOLEAN;
    x->value->u.bool_val = boolval;
 
@@ -1910,6 +2310,7 @@ si2drVoidT       si2drSimpleAttrSetFloat64Value     ( si2drAttrIdT attr,
    {
       x->value = (liberty_attribute_value*)my_calloc(sizeof(liberty_attribute_value),1);
    }
+   drop_formula(x);
    x->value->type = LIBERTY__VAL_DOUBLE;
    x->value->u.double_val = float64;
 
@@ -1963,6 +2364,7 @@ si2drVoidT       si2drSimpleAttrSetStringValue      ( si2drAttrIdT attr,
    {
       x->value = (liberty_attribute_value*)my_calloc(sizeof(liberty_attribute_value),1);
    }
+   drop_formula(x);
    x->value->type = LIBERTY__VAL_STRING;
    x->value->u.string_val = liberty_strtable_enter_string(master_string_table,string);
 
@@ -2284,7 +2686,7 @@ si2drGroupIdT  si2drGroupCreateGroup  ( si2drGroupIdT group,
 
    ng->names = (liberty_name_list*)my_calloc(sizeof(liberty_name_list),1);
    ng->last_name = ng->names;
-   ng->owner = g;
+   set_group_owner(ng, g);
    ng->names->prefix_len = npl;
 
    if( name && *name )
@@ -2310,6 +2712,8 @@ si2drGroupIdT  si2drGroupCreateGroup  ( si2drGroupIdT group,
    if( name && *name && !dont_addhash)
       liberty_hash_enter_oid(g->group_hash, nnb, retoid);
 
+   drop_type_index(g);
+
    /* link the attr struct into the lists */
    if( g->group_last )
    {
@@ -3171,6 +3575,65 @@ si2drGroupsIdT  si2drGroupGetGroups  ( si2drGroupIdT group,
 }
 
 
+/* SILIMATE: iterate over just the children of one type, through the type index */
+si2drGroupsIdT  si2drGroupGetGroupsByType  ( si2drGroupIdT group,
+      si2drStringT type,
+      si2drErrorT  *err)
+{
+   iterat *y;
+   liberty_group *g = (liberty_group*)group.v2;
+   si2drObjectIdT first;
+
+   if( !liberty___nocheck_mode )
+   {
+      if( (si2drObjectTypeT)(group.v1) != SI2DR_GROUP )
+      {
+         *err = SI2DR_INVALID_OBJECTTYPE;
+         if( liberty___debug_mode )
+         {
+            si2drErrorT err2;
+
+            (*si2ErrMsg)(SI2DR_SEVERITY_ERR, SI2DR_INVALID_OBJECTTYPE,
+                  "si2drGroupGetGroupsByType:", &err2);
+         }
+         return 0;
+      }
+      if( g->attr_hash == (liberty_hash_table*)NULL )
+      {
+         *err = SI2DR_UNUSABLE_OID;
+         if( liberty___debug_mode )
+         {
+            si2drErrorT err2;
+
+            (*si2ErrMsg)(SI2DR_SEVERITY_ERR, SI2DR_UNUSABLE_OID,
+                  "si2drGroupGetGroupsByType:", &err2);
+         }
+         return 0;
+      }
+   }
+
+   *err = SI2DR_NO_ERROR;
+
+   first = nulloid;
+   if( type && *type )
+      liberty_hash_lookup(get_type_index(g), type, &first);
+
+   y = (iterat*)my_calloc(sizeof(iterat),1);
+   y->owner = ITER_GROUP_OF_TYPE;
+   y->next = first.v2;
+   l__iter_group_count++;
+   if( trace )
+   {
+      outinit_iter((si2drIterIdT)y);
+
+      fprintf(tracefile1,"\n\t%s = si2drGroupGetGroupsByType(%s, \"%s\", &err);\n\n",
+            iter_string((si2drIterIdT)y), oid_string(group), type);
+      inc_tracecount();
+   }
+   return (si2drGroupsIdT)y;
+}
+
+
 
 
 si2drNamesIdT   si2drGroupGetNames   ( si2drGroupIdT group,
@@ -3383,7 +3846,7 @@ si2drGroupIdT   si2drIterNextGroup  ( si2drGroupsIdT iter,
 
    if( !liberty___nocheck_mode )
    {
-      if( y->owner != ITER_GROUP )
+      if( y->owner != ITER_GROUP && y->owner != ITER_GROUP_OF_TYPE )
       {
          *err = SI2DR_INVALID_OBJECTTYPE;
          if( liberty___debug_mode )
@@ -3411,7 +3874,10 @@ si2drGroupIdT   si2drIterNextGroup  ( si2drGroupsIdT iter,
 
    z = (liberty_group *)y->next;
 
-   y->next = (void*)z->next;
+   if( y->owner == ITER_GROUP_OF_TYPE )
+      y->next = (void*)z->next_of_type;
+   else
+      y->next = (void*)z->next;
    retoid.v1 = (void*)SI2DR_GROUP;
    retoid.v2 = (void*)z;
 
@@ -3602,6 +4068,7 @@ si2drVoidT  si2drIterQuit       ( si2drIterIdT iter,
    switch( y->owner )
    {
       case ITER_GROUP:
+      case ITER_GROUP_OF_TYPE:
          l__iter_group_count--;
          break;
       case ITER_ATTR:
@@ -3694,6 +4161,8 @@ si2drVoidT     si2drObjectDelete     ( si2drObjectIdT object,
          g->define_hash=0;
          liberty_hash_destroy_hash_table(g->group_hash);
          g->group_hash=0;
+         drop_type_index(g);
+         drop_type_index(gp);
 
          lgg = (liberty_group*)NULL;
          if( gp == (liberty_group*)NULL )
@@ -3800,6 +4269,8 @@ si2drVoidT     si2drObjectDelete     ( si2drObjectIdT object,
             laa = aa;
          }
          /* free up substructure */
+         drop_decoded_numbers(a);
+         drop_formula(a);
          for(av=a->value;av;)
          {
             av2 = av->next;
@@ -4013,6 +4484,14 @@ si2drVoidT       si2drPIQuit                  ( si2drErrorT  *err)
    }
    liberty_strtable_destroy_strtable(master_string_table);
    master_string_table = 0;
+   while( snapshot_maps )
+   {
+      liberty_snapshot_map *m = snapshot_maps;
+
+      snapshot_maps = m->next;
+      munmap(m->base, m->len);
+      free(m);
+   }
    /*my_malloc_print_totals();*/
    *err = SI2DR_NO_ERROR;
 }
@@ -4255,8 +4734,10 @@ si2drVoidT       si2drReadLibertyFile         ( char *filename,
    char comm[SI2DR_MAX_STRING_LEN];
    extern char *curr_file;
    extern int syntax_errors;
+   extern int liberty_include_count;
 
    curr_file = filename;
+   liberty_include_count = 0;
    *err = SI2DR_NO_ERROR;
 
    if( trace )
@@ -4343,11 +4824,886 @@ si2drVoidT       si2drReadLibertyFile         ( char *filename,
 
 }
 
-int lib__name_needs_to_be_quoted(char *name)
-{
-   char *s = name;
-   if( *s >= '0' && *s <= '9' )
-      return 1;
+/* ========================================================================================================================== */
+/*     SNAPSHOT ROUTINES */
+
+/* SILIMATE: a snapshot is a relocatable image of the whole PI database, so an
+   unchanged library can be reloaded without lexing and parsing it again.
+   The image is a header, a pool of NUL-terminated strings, and a stream of
+   64-bit words describing the groups, attributes and defines in tree order,
+   followed by the contents of every hash table in the order the entries were
+   made. Strings are stored as pool offsets (plus one, so 0 is NULL); on reload
+   the image is mmap'd and the strings are used in place, so nothing is
+   re-entered into the master string table. The mapping lives until si2drPIQuit. */
+
+#define LIBERTY_SNAPSHOT_MAGIC     "LIBSNAP"
+#define LIBERTY_SNAPSHOT_BYTEORDER 0x0102030405060708ULL
+
+typedef struct liberty_snapshot_header
+{
+   char     magic[8];
+   uint32_t version;
+   uint32_t flags;        /* bit 0: written with ignore_complex_attrs set */
+   uint64_t byteorder;
+   uint64_t pool_off;
+   uint64_t pool_len;
+   uint64_t rec_off;
+   uint64_t rec_len;      /* in 64-bit words */
+   uint64_t ngroups;
+   uint64_t nattrs;
+   uint64_t ndefines;
+   uint64_t file_len;
+   uint64_t layout;       /* snap_layout() of the writer */
+} liberty_snapshot_header;
+
+/* SILIMATE: a fingerprint of the structures a snapshot is read back into, so
+   an image from a build with different ones is refused even when nobody
+   remembered to bump SI2DR_SNAPSHOT_VERSION */
+static uint64_t snap_layout(void)
+{
+   const uint64_t sizes[] =
+   {
+      SI2DR_SNAPSHOT_VERSION,
+      sizeof(liberty_snapshot_header),
+      sizeof(liberty_group), offsetof(liberty_group, filename), offsetof(liberty_group, cell),
+      sizeof(liberty_attribute), sizeof(liberty_attribute_value), sizeof(liberty_define),
+      sizeof(liberty_name_list), sizeof(si2drExprT),
+      LIBERTY__VAL_UNDEFINED
+   };
+   uint64_t h = 14695981039346656037ULL;
+   size_t i;
+
+   for(i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++)
+   {
+      h ^= sizes[i];
+      h *= 1099511628211ULL;
+   }
+   return h;
+}
+
+typedef struct snap_buf
+{
+   char *data;
+   size_t used;
+   size_t allocated;
+} snap_buf;
+
+typedef struct snap_ptrmap /* open-addressed pointer -> number map */
+{
+   void **keys;
+   uint64_t *vals;
+   size_t size;
+   size_t count;
+} snap_ptrmap;
+
+typedef struct snap_writer
+{
+   snap_buf pool;
+   snap_buf recs;
+   snap_ptrmap strs;  /* string ptr -> pool offset+1 */
+   snap_ptrmap objs;  /* group/attr/define ptr -> index */
+   uint64_t ngroups;
+   uint64_t nattrs;
+   uint64_t ndefines;
+   int bad;
+} snap_writer;
+
+typedef struct snap_reader
+{
+   uint64_t *w;
+   uint64_t *end;
+   char *pool;
+   uint64_t pool_len;
+   liberty_group **groups;
+   liberty_attribute **attrs;
+   liberty_define **defines;
+   uint64_t ngroups, maxgroups;
+   uint64_t nattrs, maxattrs;
+   uint64_t ndefines, maxdefines;
+   int bad;
+} snap_reader;
+
+static void snap_buf_append(snap_writer *w, snap_buf *b, const void *data, size_t len)
+{
+   if( b->used + len > b->allocated )
+   {
+      size_t n = b->allocated ? b->allocated : 65536;
+      char *d;
+
+      while( n < b->used + len )
+         n *= 2;
+      d = (char*)realloc(b->data, n);
+      if( !d )
+      {
+         w->bad = 1;
+         return;
+      }
+      b->data = d;
+      b->allocated = n;
+   }
+   memcpy(b->data + b->used, data, len);
+   b->used += len;
+}
+
+static size_t snap_ptrmap_slot(snap_ptrmap *m, void *key)
+{
+   size_t h = ((size_t)key >> 3) * 0x9E3779B97F4A7C15ULL;
+   size_t i = h & (m->size - 1);
+
+   while( m->keys[i] && m->keys[i] != key )
+      i = (i+1) & (m->size - 1);
+   return i;
+}
+
+static int snap_ptrmap_find(snap_ptrmap *m, void *key, uint64_t *val)
+{
+   size_t i;
+
+   if( !m->size )
+      return 0;
+   i = snap_ptrmap_slot(m, key);
+   if( !m->keys[i] )
+      return 0;
+   *val = m->vals[i];
+   return 1;
+}
+
+static int snap_ptrmap_insert(snap_ptrmap *m, void *key, uint64_t val)
+{
+   size_t i;
+
+   if( (m->count+1)*2 > m->size )
+   {
+      snap_ptrmap n;
+      size_t j;
+
+      n.size = m->size ? m->size*2 : 4096;
+      n.count = m->count;
+      n.keys = (void**)calloc(n.size, sizeof(void*));
+      n.vals = (uint64_t*)calloc(n.size, sizeof(uint64_t));
+      if( !n.keys || !n.vals )
+      {
+         free(n.keys);
+         free(n.vals);
+         return 0;
+      }
+      for(j=0; j<m->size; j++)
+      {
+         if( m->keys[j] )
+         {
+            i = snap_ptrmap_slot(&n, m->keys[j]);
+            n.keys[i] = m->keys[j];
+            n.vals[i] = m->vals[j];
+         }
+      }
+      free(m->keys);
+      free(m->vals);
+      *m = n;
+   }
+   i = snap_ptrmap_slot(m, key);
+   if( !m->keys[i] )
+      m->count++;
+   m->keys[i] = key;
+   m->vals[i] = val;
+   return 1;
+}
+
+static void snap_put(snap_writer *w, uint64_t x)
+{
+   snap_buf_append(w, &w->recs, &x, sizeof(x));
+}
+
+static void snap_put_str(snap_writer *w, char *s)
+{
+   uint64_t off;
+
+   if( s == (char*)NULL )
+   {
+      snap_put(w, 0);
+      return;
+   }
+   if( !snap_ptrmap_find(&w->strs, s, &off) )
+   {
+      off = w->pool.used + 1;
+      snap_buf_append(w, &w->pool, s, strlen(s)+1);
+      if( !snap_ptrmap_insert(&w->strs, s, off) )
+         w->bad = 1;
+   }
+   snap_put(w, off);
+}
+
+static void snap_put_obj(snap_writer *w, void *obj, uint64_t index)
+{
+   if( !snap_ptrmap_insert(&w->objs, obj, index) )
+      w->bad = 1;
+}
+
+static void snap_write_expr(snap_writer *w, si2drExprT *e)
+{
+   uint64_t x = 0;
+
+   snap_put(w, (uint64_t)e->type);
+   snap_put(w, (uint64_t)e->valuetype);
+   if( e->type == SI2DR_EXPR_VAL && e->valuetype == SI2DR_STRING )
+      snap_put_str(w, e->u.s);
+   else
+   {
+      memcpy(&x, &e->u, sizeof(e->u) < sizeof(x) ? sizeof(e->u) : sizeof(x));
+      snap_put(w, x);
+   }
+   snap_put(w, e->left != 0);
+   if( e->left )
+      snap_write_expr(w, e->left);
+   snap_put(w, e->right != 0);
+   if( e->right )
+      snap_write_expr(w, e->right);
+}
+
+static void snap_write_group(snap_writer *w, liberty_group *g)
+{
+   liberty_name_list *nl;
+   liberty_attribute *a;
+   liberty_attribute_value *v;
+   liberty_define *d;
+   liberty_group *sg;
+   uint64_t n;
+
+   snap_put_obj(w, g, w->ngroups++);
+   snap_put_str(w, g->type);
+   snap_put(w, (uint64_t)g->EVAL);
+   snap_put_str(w, g->comment);
+   snap_put(w, (uint64_t)g->lineno);
+   snap_put_str(w, g->filename);
+
+   for(n=0, nl=g->names; nl; nl=nl->next)
+      n++;
+   snap_put(w, n);
+   for(nl=g->names; nl; nl=nl->next)
+   {
+      snap_put_str(w, nl->name);
+      snap_put(w, (uint64_t)nl->prefix_len);
+   }
+
+   for(n=0, a=g->attr_list; a; a=a->next)
+      n++;
+   snap_put(w, n);
+   for(a=g->attr_list; a; a=a->next)
+   {
+      snap_put_obj(w, a, w->nattrs++);
+      snap_put(w, (uint64_t)a->type);
+      snap_put_str(w, a->name);
+      snap_put_str(w, a->comment);
+      snap_put(w, (uint64_t)a->EVAL);
+      snap_put(w, (uint64_t)a->is_var);
+      snap_put(w, (uint64_t)a->lineno);
+      snap_put_str(w, a->filename);
+      for(n=0, v=a->value; v; v=v->next)
+         n++;
+      snap_put(w, n);
+      for(v=a->value; v; v=v->next)
+      {
+         snap_put(w, (uint64_t)v->type);
+         if( v->type == LIBERTY__VAL_STRING )
+            snap_put_str(w, v->u.string_val);
+         else if( v->type == LIBERTY__VAL_EXPR )
+         {
+            snap_put(w, v->u.expr_val != 0);
+            if( v->u.expr_val )
+               snap_write_expr(w, (si2drExprT*)v->u.expr_val);
+         }
+         else
+         {
+            uint64_t x = 0;
+            memcpy(&x, &v->u, sizeof(v->u) < sizeof(x) ? sizeof(v->u) : sizeof(x));
+            snap_put(w, x);
+         }
+      }
+   }
+
+   for(n=0, d=g->define_list; d; d=d->next)
+      n++;
+   snap_put(w, n);
+   for(d=g->define_list; d; d=d->next)
+   {
+      snap_put_obj(w, d, w->ndefines++);
+      snap_put_str(w, d->name);
+      snap_put_str(w, d->group_type);
+      snap_put(w, (uint64_t)d->valtype);
+      snap_put_str(w, d->comment);
+      snap_put(w, (uint64_t)d->lineno);
+      snap_put_str(w, d->filename);
+   }
+
+   for(n=0, sg=g->group_list; sg; sg=sg->next)
+      n++;
+   snap_put(w, n);
+   for(sg=g->group_list; sg; sg=sg->next)
+      snap_write_group(w, sg);
+}
+
+static void snap_write_hash(snap_writer *w, liberty_hash_table *ht)
+{
+   liberty_hash_bucket *hb;
+   uint64_t index;
+
+   snap_put(w, (uint64_t)ht->entry_count);
+   /* the all list is newest first; replay it in the order it was entered */
+   for(hb=ht->all_last; hb; hb=hb->all_prev)
+   {
+      if( !snap_ptrmap_find(&w->objs, hb->item.v2, &index) )
+      {
+         w->bad = 1;
+         index = 0;
+      }
+      snap_put_str(w, hb->name);
+      snap_put(w, index);
+   }
+}
+
+static void snap_write_group_hashes(snap_writer *w, liberty_group *g)
+{
+   liberty_group *sg;
+
+   snap_write_hash(w, g->attr_hash);
+   snap_write_hash(w, g->define_hash);
+   snap_write_hash(w, g->group_hash);
+   for(sg=g->group_list; sg; sg=sg->next)
+      snap_write_group_hashes(w, sg);
+}
+
+si2drVoidT       si2drWriteSnapshot           ( char *filename,
+      si2drErrorT  *err)
+{
+   extern int liberty_include_count;
+   snap_writer w;
+   liberty_snapshot_header h;
+   liberty_group *g;
+   uint64_t n;
+   static const char pad[8] = {0};
+   FILE *of;
+
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drWriteSnapshot(\"%s\",&err);\n\n", filename);
+      inc_tracecount();
+   }
+   if( !master_group_hash )
+   {
+      *err = SI2DR_PIINIT_NOT_CALLED;
+      return;
+   }
+   /* an image has no record of the include files it was read from, so it
+      could not tell when one of them changes */
+   if( liberty_include_count )
+   {
+      *err = SI2DR_INVALID_VALUE;
+      if( liberty___debug_mode )
+      {
+         si2drErrorT err2;
+
+         (*si2ErrMsg)(SI2DR_SEVERITY_ERR, SI2DR_INVALID_VALUE,
+               "si2drWriteSnapshot: The library reads include files; not writing a snapshot!", &err2);
+      }
+      return;
+   }
+   memset(&w, 0, sizeof(w));
+
+   for(n=0, g=master_group_list; g; g=g->next)
+      n++;
+   snap_put(&w, n);
+   for(g=master_group_list; g; g=g->next)
+      snap_write_group(&w, g);
+   for(g=master_group_list; g; g=g->next)
+      snap_write_group_hashes(&w, g);
+   snap_write_hash(&w, master_group_hash);
+   snap_write_hash(&w, master_define_hash);
+
+   memset(&h, 0, sizeof(h));
+   memcpy(h.magic, LIBERTY_SNAPSHOT_MAGIC, sizeof(LIBERTY_SNAPSHOT_MAGIC));
+   h.version = SI2DR_SNAPSHOT_VERSION;
+   h.flags = liberty___ignore_complex_attrs ? 1 : 0;
+   h.byteorder = LIBERTY_SNAPSHOT_BYTEORDER;
+   h.pool_off = sizeof(h);
+   h.pool_len = w.pool.used;
+   h.rec_off = (h.pool_off + h.pool_len + 7) & ~(uint64_t)7;
+   h.rec_len = w.recs.used / sizeof(uint64_t);
+   h.ngroups = w.ngroups;
+   h.nattrs = w.nattrs;
+   h.ndefines = w.ndefines;
+   h.file_len = h.rec_off + w.recs.used;
+   h.layout = snap_layout();
+
+   *err = SI2DR_NO_ERROR;
+   if( w.bad )
+      *err = SI2DR_INTERNAL_SYSTEM_ERROR;
+   else if( (of = fopen(filename, "wb")) == (FILE*)NULL )
+      *err = SI2DR_INVALID_NAME;
+   else
+   {
+      if( fwrite(&h, sizeof(h), 1, of) != 1
+            || (w.pool.used && fwrite(w.pool.data, w.pool.used, 1, of) != 1)
+            || fwrite(pad, h.rec_off - h.pool_off - h.pool_len, 1, of) > 1
+            || (w.recs.used && fwrite(w.recs.data, w.recs.used, 1, of) != 1) )
+         *err = SI2DR_INTERNAL_SYSTEM_ERROR;
+      if( fclose(of) != 0 )
+         *err = SI2DR_INTERNAL_SYSTEM_ERROR;
+   }
+   if( *err != SI2DR_NO_ERROR && liberty___debug_mode )
+   {
+      si2drErrorT err2;
+
+      (*si2ErrMsg)(SI2DR_SEVERITY_ERR, *err,
+            "si2drWriteSnapshot: Could not write the snapshot!", &err2);
+   }
+   free(w.pool.data);
+   free(w.recs.data);
+   free(w.strs.keys);
+   free(w.strs.vals);
+   free(w.objs.keys);
+   free(w.objs.vals);
+}
+
+static uint64_t snap_get(snap_reader *r)
+{
+   if( r->w >= r->end )
+   {
+      r->bad = 1;
+      return 0;
+   }
+   return *r->w++;
+}
+
+/* a count is only plausible if at least that many words are left */
+static uint64_t snap_get_count(snap_reader *r)
+{
+   uint64_t n = snap_get(r);
+
+   if( n > (uint64_t)(r->end - r->w) )
+   {
+      r->bad = 1;
+      return 0;
+   }
+   return n;
+}
+
+static char *snap_get_str(snap_reader *r)
+{
+   uint64_t off = snap_get(r);
+
+   if( off == 0 )
+      return (char*)NULL;
+   if( off > r->pool_len )
+   {
+      r->bad = 1;
+      return (char*)NULL;
+   }
+   return r->pool + off - 1;
+}
+
+static si2drExprT *snap_read_expr(snap_reader *r)
+{
+   si2drExprT *e = (si2drExprT *)calloc(sizeof(si2drExprT), 1);
+   uint64_t x;
+
+   e->type = (si2drExprTypeT)snap_get(r);
+   e->valuetype = (si2drValueTypeT)snap_get(r);
+   if( e->type == SI2DR_EXPR_VAL && e->valuetype == SI2DR_STRING )
+      e->u.s = snap_get_str(r);
+   else
+   {
+      x = snap_get(r);
+      memcpy(&e->u, &x, sizeof(e->u) < sizeof(x) ? sizeof(e->u) : sizeof(x));
+   }
+   if( snap_get(r) && !r->bad )
+      e->left = snap_read_expr(r);
+   if( snap_get(r) && !r->bad )
+      e->right = snap_read_expr(r);
+   return e;
+}
+
+static liberty_group *snap_read_group(snap_reader *r, liberty_group *owner)
+{
+   liberty_group *g;
+   uint64_t i, n, nv, j;
+
+   if( r->ngroups >= r->maxgroups )
+   {
+      r->bad = 1;
+      return (liberty_group*)NULL;
+   }
+   g = (liberty_group*)my_calloc(sizeof(liberty_group),1);
+   r->groups[r->ngroups++] = g;
+   g->type = snap_get_str(r);
+   g->EVAL = (int)snap_get(r);
+   set_group_owner(g, owner);
+   g->comment = snap_get_str(r);
+   g->lineno = (int)snap_get(r);
+   g->filename = snap_get_str(r);
+
+   /* same initial sizes as si2drPICreateGroup/si2drGroupCreateGroup, so
+      the tables grow the same way when the entries are replayed */
+   if( owner )
+   {
+      g->attr_hash = liberty_hash_create_hash_table(3, 1, 0);
+      g->define_hash = liberty_hash_create_hash_table(3, 1, 0);
+      g->group_hash = liberty_hash_create_hash_table(3, 1, 0);
+   }
+   else
+   {
+      g->attr_hash = liberty_hash_create_hash_table(503, 1, 0);
+      g->define_hash = liberty_hash_create_hash_table(53, 1, 0);
+      g->group_hash = liberty_hash_create_hash_table(2011, 1, 0);
+   }
+
+   n = snap_get_count(r);
+   for(i=0; i<n && !r->bad; i++)
+   {
+      liberty_name_list *nl = (liberty_name_list*)my_calloc(sizeof(liberty_name_list),1);
+
+      nl->name = snap_get_str(r);
+      nl->prefix_len = (int)snap_get(r);
+      if( g->last_name )
+         g->last_name->next = nl;
+      else
+         g->names = nl;
+      g->last_name = nl;
+   }
+
+   n = snap_get_count(r);
+   for(i=0; i<n && !r->bad; i++)
+   {
+      liberty_attribute *a;
+
+      if( r->nattrs >= r->maxattrs )
+      {
+         r->bad = 1;
+         break;
+      }
+      a = (liberty_attribute*)my_calloc(sizeof(liberty_attribute),1);
+      r->attrs[r->nattrs++] = a;
+      a->owner = g;
+      a->type = (liberty_attribute_type)snap_get(r);
+      a->name = snap_get_str(r);
+      a->comment = snap_get_str(r);
+      a->EVAL = (int)snap_get(r);
+      a->is_var = (int)snap_get(r);
+      a->lineno = (int)snap_get(r);
+      a->filename = snap_get_str(r);
+      if( g->attr_last )
+         g->attr_last->next = a;
+      else
+         g->attr_list = a;
+      g->attr_last = a;
+
+      nv = snap_get_count(r);
+      for(j=0; j<nv && !r->bad; j++)
+      {
+         liberty_attribute_value *v = (liberty_attribute_value*)my_calloc(sizeof(liberty_attribute_value),1);
+
+         v->type = (liberty_attribute_value_type)snap_get(r);
+         if( v->type == LIBERTY__VAL_STRING )
+            v->u.string_val = snap_get_str(r);
+         else if( v->type == LIBERTY__VAL_EXPR )
+         {
+            if( snap_get(r) && !r->bad )
+               v->u.expr_val = snap_read_expr(r);
+         }
+         else
+         {
+            uint64_t x = snap_get(r);
+            memcpy(&v->u, &x, sizeof(v->u) < sizeof(x) ? sizeof(v->u) : sizeof(x));
+         }
+         if( a->last_value )
+            a->last_value->next = v;
+         else
+            a->value = v;
+         a->last_value = v;
+      }
+   }
+
+   n = snap_get_count(r);
+   for(i=0; i<n && !r->bad; i++)
+   {
+      liberty_define *d;
+
+      if( r->ndefines >= r->maxdefines )
+      {
+         r->bad = 1;
+         break;
+      }
+      d = (liberty_define*)my_calloc(sizeof(liberty_define),1);
+      r->defines[r->ndefines++] = d;
+      d->owner = g;
+      d->name = snap_get_str(r);
+      d->group_type = snap_get_str(r);
+      d->valtype = (liberty_attribute_value_type)snap_get(r);
+      d->comment = snap_get_str(r);
+      d->lineno = (int)snap_get(r);
+      d->filename = snap_get_str(r);
+      if( g->define_last )
+         g->define_last->next = d;
+      else
+         g->define_list = d;
+      g->define_last = d;
+   }
+
+   n = snap_get_count(r);
+   for(i=0; i<n && !r->bad; i++)
+   {
+      liberty_group *sg = snap_read_group(r, g);
+
+      if( !sg )
+         break;
+      if( g->group_last )
+         g->group_last->next = sg;
+      else
+         g->group_list = sg;
+      g->group_last = sg;
+   }
+   return g;
+}
+
+/* read one hash table's entries; with ht NULL, only check them */
+static void snap_read_hash(snap_reader *r, liberty_hash_table *ht, si2drObjectTypeT type)
+{
+   uint64_t i, n, index, max;
+   void **objs;
+   si2drObjectIdT oid;
+   char *name;
+
+   switch( type )
+   {
+      case SI2DR_GROUP:
+         objs = (void**)r->groups;
+         max = r->ngroups;
+         break;
+      case SI2DR_ATTR:
+         objs = (void**)r->attrs;
+         max = r->nattrs;
+         break;
+      default:
+         objs = (void**)r->defines;
+         max = r->ndefines;
+         break;
+   }
+   n = snap_get_count(r);
+   for(i=0; i<n && !r->bad; i++)
+   {
+      name = snap_get_str(r);
+      index = snap_get(r);
+      if( index >= max )
+      {
+         r->bad = 1;
+         break;
+      }
+      if( ht )
+      {
+         oid.v1 = (void*)type;
+         oid.v2 = objs[index];
+         liberty_hash_enter_oid(ht, name, oid);
+      }
+   }
+}
+
+/* free a partially read group tree; none of it is in a parent's or a master hash yet */
+static void snap_free_group(liberty_group *g)
+{
+   liberty_attribute *a, *an;
+   liberty_attribute_value *v, *vn;
+   liberty_define *d, *dn;
+   liberty_name_list *nl, *nln;
+   liberty_group *sg, *sgn;
+   si2drErrorT err;
+
+   for(a=g->attr_list; a; a=an)
+   {
+      an = a->next;
+      drop_decoded_numbers(a);
+      drop_formula(a);
+      for(v=a->value; v; v=vn)
+      {
+         vn = v->next;
+         if( v->type == LIBERTY__VAL_EXPR && v->u.expr_val )
+            si2drExprDestroy((si2drExprT*)v->u.expr_val, &err);
+         my_free(v);
+      }
+      my_free(a);
+   }
+   for(d=g->define_list; d; d=dn)
+   {
+      dn = d->next;
+      my_free(d);
+   }
+   for(nl=g->names; nl; nl=nln)
+   {
+      nln = nl->next;
+      my_free(nl);
+   }
+   for(sg=g->group_list; sg; sg=sgn)
+   {
+      sgn = sg->next;
+      snap_free_group(sg);
+   }
+   liberty_hash_destroy_hash_table(g->attr_hash);
+   liberty_hash_destroy_hash_table(g->define_hash);
+   liberty_hash_destroy_hash_table(g->group_hash);
+   drop_type_index(g);
+   my_free(g);
+}
+
+si2drVoidT       si2drReadSnapshot            ( char *filename,
+      si2drErrorT  *err)
+{
+   liberty_snapshot_header *h;
+   liberty_snapshot_map *m;
+   liberty_group **tops = 0;
+   struct stat st;
+   snap_reader r;
+   uint64_t i, ntops = 0;
+   uint64_t *mark;
+   void *base;
+   int fd;
+
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drReadSnapshot(\"%s\",&err);\n\n", filename);
+      inc_tracecount();
+   }
+   if( !master_group_hash )
+   {
+      *err = SI2DR_PIINIT_NOT_CALLED;
+      return;
+   }
+   if( (fd = open(filename, O_RDONLY)) < 0 )
+   {
+      *err = SI2DR_INVALID_NAME;
+      return;
+   }
+   if( fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(liberty_snapshot_header) )
+   {
+      close(fd);
+      *err = SI2DR_INVALID_VALUE;
+      return;
+   }
+   /* private and writable, so nobody scribbling on a string can touch the file */
+   base = mmap(0, st.st_size, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if( base == MAP_FAILED )
+   {
+      *err = SI2DR_INTERNAL_SYSTEM_ERROR;
+      return;
+   }
+
+   h = (liberty_snapshot_header*)base;
+   memset(&r, 0, sizeof(r));
+   if( memcmp(h->magic, LIBERTY_SNAPSHOT_MAGIC, sizeof(LIBERTY_SNAPSHOT_MAGIC))
+         || h->version != SI2DR_SNAPSHOT_VERSION
+         || h->layout != snap_layout()
+         || h->byteorder != LIBERTY_SNAPSHOT_BYTEORDER
+         || h->flags != (uint32_t)(liberty___ignore_complex_attrs ? 1 : 0)
+         || h->file_len != (uint64_t)st.st_size
+         || h->pool_off > h->file_len || h->pool_len > h->file_len - h->pool_off
+         || (h->pool_len && ((char*)base)[h->pool_off + h->pool_len - 1] != 0)
+         || h->rec_off % sizeof(uint64_t) || h->rec_off > h->file_len
+         || h->rec_len != (h->file_len - h->rec_off) / sizeof(uint64_t)
+         || h->ngroups > h->rec_len || h->nattrs > h->rec_len || h->ndefines > h->rec_len )
+   {
+      munmap(base, st.st_size);
+      *err = SI2DR_INVALID_VALUE;
+      if( liberty___debug_mode )
+      {
+         si2drErrorT err2;
+
+         (*si2ErrMsg)(SI2DR_SEVERITY_ERR, SI2DR_INVALID_VALUE,
+               "si2drReadSnapshot: Not a usable snapshot!", &err2);
+      }
+      return;
+   }
+
+   r.w = (uint64_t*)((char*)base + h->rec_off);
+   r.end = r.w + h->rec_len;
+   r.pool = (char*)base + h->pool_off;
+   r.pool_len = h->pool_len;
+   r.maxgroups = h->ngroups;
+   r.maxattrs = h->nattrs;
+   r.maxdefines = h->ndefines;
+   r.groups = (liberty_group**)malloc((h->ngroups+1) * sizeof(liberty_group*));
+   r.attrs = (liberty_attribute**)malloc((h->nattrs+1) * sizeof(liberty_attribute*));
+   r.defines = (liberty_define**)malloc((h->ndefines+1) * sizeof(liberty_define*));
+   if( !r.groups || !r.attrs || !r.defines )
+      r.bad = 1;
+
+   if( !r.bad )
+   {
+      ntops = snap_get_count(&r);
+      tops = (liberty_group**)calloc(ntops+1, sizeof(liberty_group*));
+   }
+   for(i=0; i<ntops && !r.bad; i++)
+      tops[i] = snap_read_group(&r, (liberty_group*)NULL);
+
+   for(i=0; i<r.ngroups && !r.bad; i++)
+   {
+      snap_read_hash(&r, r.groups[i]->attr_hash, SI2DR_ATTR);
+      snap_read_hash(&r, r.groups[i]->define_hash, SI2DR_DEFINE);
+      snap_read_hash(&r, r.groups[i]->group_hash, SI2DR_GROUP);
+   }
+
+   /* check the master entries before making any, so a bad image
+      leaves the master tables alone */
+   mark = r.w;
+   if( !r.bad )
+   {
+      snap_read_hash(&r, (liberty_hash_table*)NULL, SI2DR_GROUP);
+      snap_read_hash(&r, (liberty_hash_table*)NULL, SI2DR_DEFINE);
+   }
+   if( r.bad || r.w != r.end )
+   {
+      for(i=0; i<ntops && tops[i]; i++)
+         snap_free_group(tops[i]);
+      free(tops);
+      free(r.groups);
+      free(r.attrs);
+      free(r.defines);
+      munmap(base, st.st_size);
+      *err = SI2DR_INVALID_VALUE;
+      if( liberty___debug_mode )
+      {
+         si2drErrorT err2;
+
+         (*si2ErrMsg)(SI2DR_SEVERITY_ERR, SI2DR_INVALID_VALUE,
+               "si2drReadSnapshot: Corrupt snapshot!", &err2);
+      }
+      return;
+   }
+   r.w = mark;
+   snap_read_hash(&r, master_group_hash, SI2DR_GROUP);
+   snap_read_hash(&r, master_define_hash, SI2DR_DEFINE);
+
+   /* keep the original order at the head of the master list */
+   for(i=ntops; i>0; i--)
+   {
+      tops[i-1]->next = master_group_list;
+      master_group_list = tops[i-1];
+   }
+
+   m = (liberty_snapshot_map*)my_calloc(sizeof(liberty_snapshot_map),1);
+   m->base = base;
+   m->len = st.st_size;
+   m->next = snapshot_maps;
+   snapshot_maps = m;
+
+   free(tops);
+   free(r.groups);
+   free(r.attrs);
+   free(r.defines);
+   *err = SI2DR_NO_ERROR;
+}
+
+int lib__name_needs_to_be_quoted(char *name)
+{
+   char *s = name;
+   if( *s >= '0' && *s <= '9' )
+      return 1;
    while( *s )
    {
       if( *s == ' ' )
@@ -5150,23 +6506,96 @@ si2drObjectIdT   si2drObjectGetOwner( si2drObjectIdT object,
          retoid.v1 = (void*)SI2DR_GROUP;
          break;
 
-      case SI2DR_ATTR:
-         a = (liberty_attribute*)object.v2;
-         retoid.v2 = (void*) a->owner;
-         retoid.v1 = (void*)SI2DR_GROUP;
-         break;
+      case SI2DR_ATTR:
+         a = (liberty_attribute*)object.v2;
+         retoid.v2 = (void*) a->owner;
+         retoid.v1 = (void*)SI2DR_GROUP;
+         break;
+
+      case SI2DR_DEFINE:
+         d = (liberty_define*)object.v2;
+         retoid.v2 = (void*) d->owner;
+         retoid.v1 = (void*)SI2DR_GROUP;
+         break;
+
+      default:
+         *err = SI2DR_INVALID_OBJECTTYPE;
+         return nulloid;
+   }
+   return retoid;
+}
+
+
+si2drGroupIdT    si2drGroupGetLibrary( si2drGroupIdT group,
+      si2drErrorT  *err)
+{
+   liberty_group *g = (liberty_group*)group.v2;
+   si2drGroupIdT retoid;
+
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drGroupGetLibrary(%s,&err);\n\n",
+            oid_string(group));
+      inc_tracecount();
+   }
+   if( (si2drObjectTypeT)(group.v1) != SI2DR_GROUP )
+   {
+      *err = SI2DR_INVALID_OBJECTTYPE;
+      return nulloid;
+   }
+   *err = SI2DR_NO_ERROR;
+   if( !g->library )
+      return nulloid;
+   retoid.v1 = (void*)SI2DR_GROUP;
+   retoid.v2 = (void*)g->library;
+   return retoid;
+}
+
+
+si2drGroupIdT    si2drGroupGetCell( si2drGroupIdT group,
+      si2drErrorT  *err)
+{
+   liberty_group *g = (liberty_group*)group.v2;
+   si2drGroupIdT retoid;
+
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drGroupGetCell(%s,&err);\n\n",
+            oid_string(group));
+      inc_tracecount();
+   }
+   if( (si2drObjectTypeT)(group.v1) != SI2DR_GROUP )
+   {
+      *err = SI2DR_INVALID_OBJECTTYPE;
+      return nulloid;
+   }
+   *err = SI2DR_NO_ERROR;
+   if( !g->cell )
+      return nulloid;
+   retoid.v1 = (void*)SI2DR_GROUP;
+   retoid.v2 = (void*)g->cell;
+   return retoid;
+}
+
 
-      case SI2DR_DEFINE:
-         d = (liberty_define*)object.v2;
-         retoid.v2 = (void*) d->owner;
-         retoid.v1 = (void*)SI2DR_GROUP;
-         break;
+si2drInt32T      si2drGroupGetDepth( si2drGroupIdT group,
+      si2drErrorT  *err)
+{
+   liberty_group *g = (liberty_group*)group.v2;
 
-      default:
-         *err = SI2DR_INVALID_OBJECTTYPE;
-         return nulloid;
+   if( trace )
+   {
+      fprintf(tracefile1,"\n\tsi2drGroupGetDepth(%s,&err);\n\n",
+            oid_string(group));
+      inc_tracecount();
    }
-   return retoid;
+   if( (si2drObjectTypeT)(group.v1) != SI2DR_GROUP )
+   {
+      *err = SI2DR_INVALID_OBJECTTYPE;
+      return 0;
+   }
+   *err = SI2DR_NO_ERROR;
+   return g->depth;
 }
 
 
@@ -5333,6 +6762,7 @@ si2drVoidT si2drGroupMoveBefore(si2drGroupIdT groupToMove,
    }
 
    *err = SI2DR_NO_ERROR;
+   drop_type_index(go);
 
    if( gm != go->group_list )
    {
@@ -5498,6 +6928,7 @@ si2drVoidT si2drGroupMoveAfter(si2drGroupIdT groupToMove,
    }
 
    *err = SI2DR_NO_ERROR;
+   drop_type_index(go);
 
    if( gm != go->group_list )
    {
@@ -5658,6 +7089,7 @@ si2drVoidT       si2drSimpleAttrSetExprValue( si2drAttrIdT   attr,
    {
       x->value = (liberty_attribute_value*)my_calloc(sizeof(liberty_attribute_value),1);
    }
+   drop_formula(x);
    x->value->type = LIBERTY__VAL_EXPR;
    x->value->u.expr_val = expr;
 
@@ -5774,9 +7206,13 @@ si2drExprT  *si2drCreateUnaryOpExpr( si2drExprTypeT optype,
    return x;
 }
 
+static pthread_mutex_t expr_string_lock = PTHREAD_MUTEX_INITIALIZER;
+
 si2drStringT   si2drExprToString( si2drExprT *expr,
       si2drErrorT *err)
 {
+   si2drStringT str;
+
    *err = SI2DR_NO_ERROR;
    if( expr->type != SI2DR_EXPR_VAL
          && expr->type != SI2DR_EXPR_OP_ADD
@@ -5792,7 +7228,11 @@ si2drStringT   si2drExprToString( si2drExprT *expr,
       *err = SI2DR_INVALID_OBJECTTYPE;
       return "";
    }
-   return expr_string(expr);
+   /* SILIMATE: expr_string enters its results in the master string table */
+   pthread_mutex_lock(&expr_string_lock);
+   str = expr_string(expr);
+   pthread_mutex_unlock(&expr_string_lock);
+   return str;
 }
 
 si2drExprTypeT si2drExprGetType( si2drExprT  *expr,
@@ -5961,7 +7401,550 @@ LONG_DOUBLE liberty_get_element(struct liberty_value_data *vd, ...)  /* returns
       pos = vd->dim_sizes[i] * pos + indices[i];
    }
 
-   return vd->values[pos];
+   return liberty_get_value_at(vd, pos);
+}
+
+LONG_DOUBLE liberty_get_value_at(const struct liberty_value_data *vd, int pos)
+{
+   switch( vd->precision )
+   {
+      case SI2DR_TABLE_FLOAT64:
+         return ((double*)vd->narrow_values)[pos];
+      case SI2DR_TABLE_FLOAT32:
+         return ((float*)vd->narrow_values)[pos];
+      default:
+         return vd->values[pos];
+   }
+}
+
+LONG_DOUBLE liberty_get_index_at(const struct liberty_value_data *vd, int dim, int i)
+{
+   switch( vd->precision )
+   {
+      case SI2DR_TABLE_FLOAT64:
+         return ((double*)vd->narrow_index_info[dim])[i];
+      case SI2DR_TABLE_FLOAT32:
+         return ((float*)vd->narrow_index_info[dim])[i];
+      default:
+         return vd->index_info[dim][i];
+   }
+}
+
+/* SILIMATE: the tables are built as LONG_DOUBLE and, in a FLOAT64 or
+   FLOAT32 session, converted once at the end */
+static void *narrow_array(LONG_DOUBLE *a, int n, si2drTablePrecisionT precision)
+{
+   void *r;
+   int i;
+
+   if( !a )
+      return 0;
+   if( precision == SI2DR_TABLE_FLOAT64 )
+   {
+      r = malloc((n > 0 ? n : 1)*sizeof(double));
+      for(i=0; i<n; i++)
+         ((double*)r)[i] = a[i];
+   }
+   else
+   {
+      r = malloc((n > 0 ? n : 1)*sizeof(float));
+      for(i=0; i<n; i++)
+         ((float*)r)[i] = a[i];
+   }
+   free(a);
+   return r;
+}
+
+static struct liberty_value_data *narrow_value_data(struct liberty_value_data *vd, int numels)
+{
+   int i;
+
+   vd->precision = liberty___table_precision;
+   if( vd->precision == SI2DR_TABLE_LONG_DOUBLE )
+      return vd;
+   vd->narrow_values = narrow_array(vd->values, numels, vd->precision);
+   vd->values = 0;
+   vd->narrow_index_info = (void**)calloc(sizeof(void*), vd->dimensions > 0 ? vd->dimensions : 1);
+   for(i=0; i<vd->dimensions; i++)
+      vd->narrow_index_info[i] = narrow_array(vd->index_info[i], vd->dim_sizes[i], vd->precision);
+   free(vd->index_info);
+   vd->index_info = 0;
+   return vd;
+}
+
+/* SILIMATE: the powers of ten a double holds exactly */
+static const double exact_pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+/* SILIMATE: strtod for the plain decimals tables are made of. When the
+   digits fit in 2^53 and the power of ten is within 10^22 both are exact
+   doubles, so one multiply or divide gives the correctly rounded result
+   (Clinger's fast path); anything else goes to strtod. */
+static double decode_double(char *str, char **end)
+{
+   char *p = str;
+   uint64_t m = 0;
+   int neg = 0, digits = 0, e = 0, ndig = 0;
+   double x;
+
+   if( *p == '-' || *p == '+' )
+      neg = (*p++ == '-');
+   for( ; *p >= '0' && *p <= '9'; p++, ndig++ )
+   {
+      if( m || *p != '0' )
+         digits++;
+      m = m*10 + (*p - '0');
+   }
+   if( *p == '.' )
+   {
+      for( p++; *p >= '0' && *p <= '9'; p++, ndig++ )
+      {
+         if( m || *p != '0' )
+            digits++;
+         m = m*10 + (*p - '0');
+         e--;
+      }
+   }
+   if( ndig == 0 || digits > 15 )
+      return strtod(str, end);
+   if( *p == 'e' || *p == 'E' )
+   {
+      char *q = p+1;
+      int eneg = 0, ev = 0;
+      if( *q == '-' || *q == '+' )
+         eneg = (*q++ == '-');
+      if( *q >= '0' && *q <= '9' )
+      {
+         for( ; *q >= '0' && *q <= '9'; q++ )
+            if( ev < 10000 )
+               ev = ev*10 + (*q - '0');
+         e += eneg ? -ev : ev;
+         p = q;
+      }
+   }
+   if( e < -22 || e > 22 || *p == 'x' || *p == 'X' )
+      return strtod(str, end);
+   x = (double)m;
+   x = e < 0 ? x / exact_pow10[-e] : x * exact_pow10[e];
+   *end = p;
+   return neg ? -x : x;
+}
+
+/* SILIMATE: decoded numbers are kept in a pool keyed by their content, so
+   the index_1 of a thousand cell_rise groups, or the values two drive
+   strengths share, are held once and referenced by every attribute that
+   decodes to them */
+typedef struct decoded_pool_entry
+{
+   struct liberty_decoded_numbers dn; /* first, so the two pointers convert */
+   struct liberty_pool_entry link;
+} decoded_pool_entry;
+
+#define DECODED_ENTRY(l) ((decoded_pool_entry*)((char*)(l) - offsetof(decoded_pool_entry, link)))
+
+static size_t decoded_total(const struct liberty_decoded_numbers *dn)
+{
+   return dn->starts[dn->nvalues];
+}
+
+static uint64_t decoded_hash(const struct liberty_decoded_numbers *dn)
+{
+   uint64_t h = LIBERTY_POOL_HASH_SEED;
+
+   h = liberty_pool_hash(h, &dn->nvalues, sizeof(int));
+   h = liberty_pool_hash(h, dn->starts, (dn->nvalues+1)*sizeof(int));
+   h = liberty_pool_hash(h, dn->nums, decoded_total(dn)*sizeof(double));
+   return liberty_pool_hash(h, dn->offsets, decoded_total(dn)*sizeof(int));
+}
+
+static int decoded_same(const struct liberty_pool_entry *a, const struct liberty_pool_entry *b)
+{
+   const struct liberty_decoded_numbers *x = &DECODED_ENTRY(a)->dn, *y = &DECODED_ENTRY(b)->dn;
+   size_t n = decoded_total(x);
+
+   return x->nvalues == y->nvalues
+      && !memcmp(x->starts, y->starts, (x->nvalues+1)*sizeof(int))
+      && !memcmp(x->nums, y->nums, n*sizeof(double))
+      && !memcmp(x->offsets, y->offsets, n*sizeof(int));
+}
+
+static struct liberty_pool decoded_pool = LIBERTY_POOL_INITIALIZER(1024, decoded_same);
+
+static void free_decoded_numbers(struct liberty_decoded_numbers *dn);
+
+/* the pooled copy of dn, which is freed if there already was one */
+static struct liberty_decoded_numbers *intern_decoded_numbers(struct liberty_decoded_numbers *dn)
+{
+   decoded_pool_entry *e = (decoded_pool_entry*)dn, *x;
+
+   e->link.hash = decoded_hash(dn);
+   x = DECODED_ENTRY(liberty_pool_intern(&decoded_pool, &e->link));
+   if( x != e )
+      free_decoded_numbers(dn);
+   return &x->dn;
+}
+
+/* one attribute lets go of its reference */
+static void release_decoded_numbers(struct liberty_decoded_numbers *dn)
+{
+   if( dn && liberty_pool_release(&decoded_pool, &((decoded_pool_entry*)dn)->link) )
+      free_decoded_numbers(dn);
+}
+
+void liberty_get_decoded_stats(struct liberty_decoded_stats *st)
+{
+   struct liberty_pool_entry *l;
+   decoded_pool_entry *x;
+   size_t i, n;
+
+   memset(st, 0, sizeof(*st));
+   pthread_mutex_lock(&decoded_pool.lock);
+   st->attributes = decoded_pool.refs;
+   st->blocks = decoded_pool.count;
+   for(i=0; i<decoded_pool.size; i++)
+   {
+      for(l=decoded_pool.buckets[i]; l; l=l->next)
+      {
+         x = DECODED_ENTRY(l);
+         n = decoded_total(&x->dn);
+         st->numbers_stored += n;
+         st->numbers_referenced += n * l->refs;
+         st->bytes_stored += sizeof(decoded_pool_entry) + (x->dn.nvalues+1)*sizeof(int) + n*(sizeof(double)+sizeof(int));
+         st->bytes_referenced += (sizeof(decoded_pool_entry) + (x->dn.nvalues+1)*sizeof(int) + n*(sizeof(double)+sizeof(int))) * l->refs;
+      }
+   }
+   pthread_mutex_unlock(&decoded_pool.lock);
+}
+
+/* SILIMATE: decoded numbers are published with a compare-and-swap, so
+   check threads that meet the same template attribute can both decode it;
+   the loser drops its reference */
+static struct liberty_decoded_numbers *decode_numbers(liberty_attribute *a)
+{
+   struct liberty_decoded_numbers *dn = (struct liberty_decoded_numbers*)calloc(sizeof(decoded_pool_entry),1);
+   liberty_attribute_value *v;
+   int k, total = 0, max = 16;
+   char *p, *t;
+   double x;
+
+   for(v=a->value; v; v=v->next)
+      dn->nvalues++;
+   dn->starts = (int*)malloc((dn->nvalues+1)*sizeof(int));
+   dn->nums = (double*)malloc(max*sizeof(double));
+   dn->offsets = (int*)malloc(max*sizeof(int));
+   for(v=a->value, k=0; v; v=v->next, k++)
+   {
+      dn->starts[k] = total;
+      switch( v->type )
+      {
+         case LIBERTY__VAL_STRING:
+            if( !v->u.string_val )
+               break;
+            p = v->u.string_val;
+            while( (x = decode_double(p,&t)), t != p )
+            {
+               if( total == max )
+               {
+                  max *= 2;
+                  dn->nums = (double*)realloc(dn->nums, max*sizeof(double));
+                  dn->offsets = (int*)realloc(dn->offsets, max*sizeof(int));
+               }
+               dn->nums[total] = x;
+               dn->offsets[total++] = p - v->u.string_val;
+
+               if( *t == 0 )
+                  break;
+
+               /* skip over intervening stuff to the next number */
+               while( *t == ',' || *t == ' ' || *t == '\t' || *t == '\n' || *t == '\r' || *t == '\\' )
+               {
+                  if( *t == '\\' && *(t+1) == '\n' ) /*skip over line escapes */
+                     t++;
+                  t++;
+               }
+               p = t;
+            }
+            break;
+
+         case LIBERTY__VAL_DOUBLE:
+         case LIBERTY__VAL_INT:
+            if( total == max )
+            {
+               max *= 2;
+               dn->nums = (double*)realloc(dn->nums, max*sizeof(double));
+               dn->offsets = (int*)realloc(dn->offsets, max*sizeof(int));
+            }
+            dn->nums[total] = v->type == LIBERTY__VAL_DOUBLE ? v->u.double_val : v->u.int_val;
+            dn->offsets[total++] = 0;
+            break;
+
+         default:
+            break;
+      }
+   }
+   dn->starts[dn->nvalues] = total;
+   return intern_decoded_numbers(dn);
+}
+
+static void free_decoded_numbers(struct liberty_decoded_numbers *dn)
+{
+   if( !dn )
+      return;
+   free(dn->starts);
+   free(dn->nums);
+   free(dn->offsets);
+   free(dn);
+}
+
+/* the values changed, or the attribute is going away */
+static void drop_decoded_numbers(liberty_attribute *a)
+{
+   release_decoded_numbers(atomic_exchange(&a->decoded, NULL));
+}
+
+const struct liberty_decoded_numbers *liberty_get_decoded_numbers(si2drAttrIdT attr)
+{
+   liberty_attribute *a = (liberty_attribute*)attr.v2;
+   struct liberty_decoded_numbers *dn, *expected = NULL;
+
+   if( !a || (si2drObjectTypeT)(attr.v1) != SI2DR_ATTR || a->type != LIBERTY__COMPLEX )
+      return NULL;
+   dn = atomic_load_explicit(&a->decoded, memory_order_acquire);
+   if( dn )
+      return dn;
+   dn = decode_numbers(a);
+   if( !atomic_compare_exchange_strong_explicit(&a->decoded, &expected, dn, memory_order_acq_rel, memory_order_acquire) )
+   {
+      release_decoded_numbers(dn);
+      dn = expected;
+   }
+   return dn;
+}
+
+/* SILIMATE: the shortest of printf's %.15g, %.16g and %.17g that reads
+   back as x, without their cost. With x = M*2^E and a power of ten within
+   10^22, x*10^s is a ratio A/B of 128-bit integers, so the digits are
+   rounded exactly (ties to even, as printf does) and each candidate is
+   checked against half an ulp of x; anything else goes to snprintf. */
+#ifdef __SIZEOF_INT128__
+static int format_digits(double ax, int n, int *ep, uint64_t *mp, int *exact)
+{
+   static const uint64_t pow5[] = { 1ull, 5ull, 25ull, 125ull, 625ull, 3125ull, 15625ull, 78125ull,
+                                    390625ull, 1953125ull, 9765625ull, 48828125ull, 244140625ull,
+                                    1220703125ull, 6103515625ull, 30517578125ull, 152587890625ull,
+                                    762939453125ull, 3814697265625ull, 19073486328125ull,
+                                    95367431640625ull, 476837158203125ull, 2384185791015625ull };
+   unsigned __int128 a, b, d, r, x4, c4, h4, l4;
+   uint64_t m;
+   int e2, sh, s, i, e = *ep;
+
+   m = (uint64_t)ldexp(frexp(ax, &e2), 53);
+   e2 -= 53;
+   for(i=0; i<2; i++)
+   {
+      s = n - 1 - e;
+      if( s > 22 || s < -22 )
+         return 0;
+      sh = e2 + s;
+      if( sh > 60 || sh < -60 )
+         return 0;
+      a = (unsigned __int128)m * pow5[s > 0 ? s : 0];
+      b = pow5[s < 0 ? -s : 0];
+      if( sh > 0 )
+         a <<= sh;
+      else
+         b <<= -sh;
+      d = a / b;
+      r = a % b;
+      if( 2*r > b || (2*r == b && (d & 1)) )
+         d++;
+      if( d >= (unsigned __int128)exact_pow10[n] )
+         e++;
+      else if( d < (unsigned __int128)exact_pow10[n-1] )
+         e--;
+      else
+         break;
+   }
+   if( i == 2 )
+      return 0;
+   /* in units of 1/(4b): x, the candidate, and the half ulps above and
+      below x (the one below is narrower at a power of two) */
+   x4 = a << 2;
+   c4 = (d * b) << 2;
+   h4 = (unsigned __int128)2 * pow5[s > 0 ? s : 0] << (sh > 0 ? sh : 0);
+   l4 = m == (1ull << 52) ? h4 >> 1 : h4;
+   if( c4 >= x4 )
+      *exact = c4 - x4 < h4 || (c4 - x4 == h4 && !(m & 1));
+   else
+      *exact = x4 - c4 < l4 || (x4 - c4 == l4 && !(m & 1));
+   *ep = e;
+   *mp = (uint64_t)d;
+   return 1;
+}
+#endif
+
+static int format_number(char *buf, double x)
+{
+   char digits[20], *p = buf, *t;
+   double ax = fabs(x);
+   uint64_t m = 0;
+   int e, n, i, exact = 0;
+
+   if( x == 0.0 && !signbit(x) )
+   {
+      strcpy(buf, "0");
+      return 1;
+   }
+   if( !(ax >= 1e-200 && ax < 1e200) )
+      n = 0;
+   else
+   {
+#ifdef __SIZEOF_INT128__
+      e = (int)floor(log10(ax));
+      for(n=15; n<=17; n++)
+      {
+         if( !format_digits(ax, n, &e, &m, &exact) )
+         {
+            n = 0;
+            break;
+         }
+         if( exact )
+            break;
+      }
+#else
+      n = 0;
+#endif
+   }
+   if( n == 0 || n > 17 )
+   {
+      for(n=15; n<17; n++)
+      {
+         i = snprintf(buf, 32, "%.*g", n, x);
+         if( strtod(buf, &t) == x || x != x )
+            return i;
+      }
+      return snprintf(buf, 32, "%.17g", x);
+   }
+   for(i=n; i>0; i--, m/=10)
+      digits[i-1] = (char)('0' + m%10);
+   for(i=n; i>1 && digits[i-1] == '0'; i--)
+      ;
+   if( x < 0 )
+      *p++ = '-';
+   if( e < -4 || e >= n )
+   {
+      *p++ = digits[0];
+      if( i > 1 )
+      {
+         *p++ = '.';
+         memcpy(p, digits+1, i-1);
+         p += i-1;
+      }
+      p += sprintf(p, "e%c%02d", e < 0 ? '-' : '+', e < 0 ? -e : e);
+   }
+   else if( e < 0 )
+   {
+      *p++ = '0';
+      *p++ = '.';
+      for(n=-1; n>e; n--)
+         *p++ = '0';
+      memcpy(p, digits, i);
+      p += i;
+   }
+   else
+   {
+      for(n=0; n<=e; n++)
+         *p++ = n < i ? digits[n] : '0';
+      if( i > e+1 )
+      {
+         *p++ = '.';
+         memcpy(p, digits+e+1, i-e-1);
+         p += i-e-1;
+      }
+   }
+   *p = 0;
+   return (int)(p - buf);
+}
+
+static void append_text(char **buf, size_t *used, size_t *cap, const char *p, size_t n)
+{
+   if( *used + n + 1 > *cap )
+   {
+      *cap = (*used + n + 1) * 2;
+      *buf = (char*)realloc(*buf, *cap);
+   }
+   memcpy(*buf + *used, p, n);
+   *used += n;
+   (*buf)[*used] = 0;
+}
+
+/* SILIMATE: put nums in place of the numbers liberty_get_decoded_numbers
+   finds in a complex attribute, leaving the text around them as it was.
+   Numbers are written with as few digits as read back exactly. */
+int liberty_set_decoded_numbers(si2drAttrIdT attr, const double *nums)
+{
+   liberty_attribute *a = (liberty_attribute*)attr.v2;
+   const struct liberty_decoded_numbers *dn = liberty_get_decoded_numbers(attr);
+   liberty_attribute_value *v;
+   char *buf = NULL, *s, *t, num[32];
+   size_t cap = 0, used, pos;
+   int k, j;
+
+   if( !dn )
+      return 0;
+   for(v=a->value, k=0; v; v=v->next, k++)
+   {
+      if( dn->starts[k] == dn->starts[k+1] )
+         continue;
+      if( v->type != LIBERTY__VAL_STRING )
+      {
+         v->type = LIBERTY__VAL_DOUBLE;
+         v->u.double_val = nums[dn->starts[k]];
+         continue;
+      }
+      s = v->u.string_val;
+      used = pos = 0;
+      for(j=dn->starts[k]; j<dn->starts[k+1]; j++)
+      {
+         append_text(&buf, &used, &cap, s + pos, dn->offsets[j] - pos);
+         append_text(&buf, &used, &cap, num, format_number(num, nums[j]));
+         decode_double(s + dn->offsets[j], &t);
+         pos = t - s;
+      }
+      append_text(&buf, &used, &cap, s + pos, strlen(s + pos));
+      v->u.string_val = liberty_strtable_store_string(master_string_table, buf);
+   }
+   free(buf);
+   drop_decoded_numbers(a);
+   return 1;
+}
+
+/* SILIMATE: formulas are published the same way as decoded numbers */
+static void drop_formula(liberty_attribute *a)
+{
+   liberty_formula_free(atomic_exchange(&a->formula, NULL));
+}
+
+const struct liberty_formula *liberty_get_formula(si2drAttrIdT attr)
+{
+   liberty_attribute *a = (liberty_attribute*)attr.v2;
+   struct liberty_formula *f, *expected = NULL;
+
+   if( !a || (si2drObjectTypeT)(attr.v1) != SI2DR_ATTR || a->type != LIBERTY__SIMPLE
+       || !a->value || a->value->type != LIBERTY__VAL_STRING || !a->value->u.string_val )
+      return NULL;
+   f = atomic_load_explicit(&a->formula, memory_order_acquire);
+   if( f )
+      return f;
+   f = liberty_formula_compile(a->value->u.string_val, NULL);
+   if( !f )
+      return NULL;
+   if( !atomic_compare_exchange_strong_explicit(&a->formula, &expected, f, memory_order_acq_rel, memory_order_acquire) )
+   {
+      liberty_formula_free(f);
+      f = expected;
+   }
+   return f;
 }
 
 void liberty_destroy_value_data(struct liberty_value_data *vd)
@@ -5990,6 +7973,13 @@ void liberty_destroy_value_data(struct liberty_value_data *vd)
       free(vd->index_info);
       vd->index_info = 0;
    }
+   if( vd->narrow_index_info )
+   {
+      for(i=0; i< vd->dimensions; i++)
+         free(vd->narrow_index_info[i]);
+      free(vd->narrow_index_info);
+   }
+   free(vd->narrow_values);
    vd->dimensions = 0;
    free(vd);
 }
@@ -6004,9 +7994,8 @@ static void liberty_get_index_info(si2drAttrIdT index_x, struct liberty_value_da
    si2drStringT    string;
    si2drBooleanT   bool;
    si2drExprT      *expr;
-   char *p,*t =NULL;
+   const struct liberty_decoded_numbers *dn;
    int numcount,i2;
-   LONG_DOUBLE x;
 
 
    if( !si2drObjectIsNull(index_x,&err) )
@@ -6050,77 +8039,19 @@ static void liberty_get_index_info(si2drAttrIdT index_x, struct liberty_value_da
          return;
       }
 
-      p = string;
-      numcount=0;
-
-      while( (x = (LONG_DOUBLE)strtod(p,&t)), t != p )
-      {
-         numcount++;
-
-         if( t && *t == 0 )
-            break;
-
-         /* skip over intervening stuff to the next number */
-         while( t && (*t == ',' || *t == ' ' || *t == '\t' || *t == '\n' || *t == '\r' || *t == '\\' ))
-         {
-            if( *t == '\\' && *(t+1) == '\n' ) /*skip over line escapes */
-               t++;
-            t++;
-         }
-         p = t;
-      }
+      dn = liberty_get_decoded_numbers(index_x);
+      numcount = dn->starts[1] - dn->starts[0];
       if( numcount )
       {
          vd->index_info[dimno] = (LONG_DOUBLE *)calloc(sizeof(LONG_DOUBLE),numcount);
          vd->dim_sizes[dimno] = numcount;
 
-         p = string;
-         i2 = 0;
-
-         while( (x = strtod(p,&t)), t != p )
-         {
-            LONG_DOUBLE *pg = vd->index_info[dimno];
-
-            pg[i2] = x;
-            if( t && *t == 0 )
-               break;
-
-            i2++;
-            /* skip over intervening stuff to the next number */
-            while( *t == ',' || *t == ' ' || *t == '\t' || *t == '\n' || *t == '\r' || *t == '\\' )
-            {
-               if( *t == '\\' && *(t+1) == '\n' ) /*skip over line escapes */
-                  t++;
-               t++;
-            }
-            p = t;
-         }
+         for(i2=0; i2<numcount; i2++)
+            vd->index_info[dimno][i2] = dn->nums[dn->starts[0]+i2];
       }
    }
 }
 
-static si2drGroupIdT get_containing_group(si2drGroupIdT group, si2drStringT type)
-{
-   si2drErrorT err;
-   const struct libGroupMap *lgm;
-   si2drGroupIdT gup = group;
-   group_enum gt = 0;
-   lgm = lookup_group_name (type, strlen(type));
-   if( lgm )
-      gt = lgm->type;
-   else
-   {
-      fprintf(stderr,"BAD type (%s) handed to get_containing_group!", type);
-   }
-
-   while( !si2drObjectIsNull((gup = si2drObjectGetOwner(gup,&err)),&err) )
-   {
-      if( si2drGroupGetID(gup,&err) == gt )
-         return gup;
-   }
-   return si2drPIGetNullId(&err);
-}
-
 struct liberty_value_data *liberty_get_values_data( si2drGroupIdT table_group)
 {
    si2drErrorT err;
@@ -6144,14 +8075,12 @@ struct liberty_value_data *liberty_get_values_data( si2drGroupIdT table_group)
    si2drStringT    string;
    si2drBooleanT   bool;
    si2drExprT      *expr;
-   char *p,*t;
-   LONG_DOUBLE x;
    struct liberty_value_data *vd = (struct liberty_value_data *)calloc(sizeof(struct liberty_value_data),1);
    int numels;
    si2drStringT  refname;
 
    /* find the template, fill in any missing index vals! */
-   libr = get_containing_group(table_group,"library");
+   libr = si2drGroupGetLibrary(table_group,&err);
 
    names = si2drGroupGetNames(table_group, &err);
    refname = si2drIterNextName(names,&err);
@@ -6392,16 +8321,18 @@ struct liberty_value_data *liberty_get_values_data( si2drGroupIdT table_group)
    if( !si2drObjectIsNull(valuesd,&err) )
    {
       int totalcount = 0;
-      int numcount;
+      int numcount, i, k = 0;
       int first = 1;
+      const struct liberty_decoded_numbers *dn;
 
       /* should be a string with a list of comma/space sep'd numbers */
       if( si2drAttrGetAttrType(valuesd,&err) != SI2DR_COMPLEX )
       {
          fprintf(stderr,"The 'values' attribute is not a complex attribute.\n");
-         return vd; /* this will already be reported */
+         return narrow_value_data(vd, numels); /* this will already be reported */
       }
 
+      dn = liberty_get_decoded_numbers(valuesd);
       vals = si2drComplexAttrGetValues(valuesd,&err);
       do
       {
@@ -6427,28 +8358,11 @@ struct liberty_value_data *liberty_get_values_data( si2drGroupIdT table_group)
             break;
          }
 
-         p = string;
-         numcount=0;
-
-         while( (x = strtod(p,&t)), t != p )
-         {
-            vd->values[totalcount+numcount] = x;
-
-            numcount++;
-
-            if( t && *t == 0 )
-               break;
-
-            /* skip over intervening stuff to the next number */
-            while( *t == ',' || *t == ' ' || *t == '\t' || *t == '\n' || *t == '\r' || *t == '\\' )
-            {
-               if( *t == '\\' && *(t+1) == '\n' ) /*skip over line escapes */
-                  t++;
-               t++;
-            }
-            p = t;
-         }
+         numcount = dn->starts[k+1] - dn->starts[k];
+         for(i=0; i<numcount && totalcount+i < numels; i++)
+            vd->values[totalcount+i] = dn->nums[dn->starts[k]+i];
          totalcount += numcount;
+         k++;
 
       }
       while( vtype != SI2DR_UNDEFINED_VALUETYPE );
@@ -6464,7 +8378,7 @@ struct liberty_value_data *liberty_get_values_data( si2drGroupIdT table_group)
    {
       fprintf(stderr,"The group contains no 'values' attribute.\n");
    }
-   return vd;
+   return narrow_value_data(vd, numels);
 }
 
 si2drVoidT     si2drComplexAttrAddExprValue        ( si2drAttrIdT attr,
@@ -6514,6 +8428,8 @@ si2drVoidT     si2drComplexAttrAddExprValue        ( si2drAttrIdT attr,
    y->type = LIBERTY__VAL_EXPR;
    y->u.expr_val = expr;
 
+   drop_decoded_numbers(x);
+
    /* link the attr struct into the lists */
    if( x->last_value )
    {
@@ -0,0 +1,375 @@
+/* SILIMATE: the vectors of a CCS output_current_rise or _fall group in one
+   block. The slew and load breakpoints of all its vectors form one sorted
+   grid, the samples of every vector lie back to back with their times made
+   relative to the vector's reference_time, and each vector's charge is
+   integrated once. A (slew, load) query then blends the up to four vectors
+   around it with bilinear weights, clamped to the grid; grid points that
+   have no vector are left out and the other weights scaled up. A waveform
+   is zero outside its own time range, and linear between its samples. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "si2dr_liberty.h"
+
+typedef struct ccs_raw_vector
+{
+   double slew, load, reference_time;
+   struct liberty_value_data *vd;
+} ccs_raw_vector;
+
+static int ccs_compare_doubles(const void *a, const void *b)
+{
+   double x = *(const double*)a, y = *(const double*)b;
+
+   return x < y ? -1 : x > y;
+}
+
+/* sorts the n values and drops duplicates; returns how many are left */
+static int ccs_unique(double *v, int n)
+{
+   int i, m = 0;
+
+   qsort(v, n, sizeof(double), ccs_compare_doubles);
+   for(i=0; i<n; i++)
+   {
+      if( m == 0 || v[i] != v[m-1] )
+         v[m++] = v[i];
+   }
+   return m;
+}
+
+static int ccs_find(const double *v, int n, double x)
+{
+   int lo = 0, hi = n-1, mid;
+
+   while( lo < hi )
+   {
+      mid = (lo+hi)/2;
+      if( v[mid] < x )
+         lo = mid+1;
+      else
+         hi = mid;
+   }
+   return lo;
+}
+
+/* whether the vector's template lists the load before the slew */
+static int ccs_load_first(si2drGroupIdT vector)
+{
+   si2drErrorT err;
+   si2drNamesIdT names = si2drGroupGetNames(vector, &err);
+   si2drStringT name = si2drIterNextName(names, &err);
+   si2drGroupIdT libr = si2drGroupGetLibrary(vector, &err);
+   si2drGroupIdT template;
+   si2drAttrIdT var1;
+   int result = 0;
+
+   si2drIterQuit(names, &err);
+   if( !name || si2drObjectIsNull(libr, &err) )
+      return 0;
+   template = si2drGroupFindGroupByName(libr, name, "output_current_template", &err);
+   if( si2drObjectIsNull(template, &err) )
+      return 0;
+   var1 = si2drGroupFindAttrByName(template, "variable_1", &err);
+   if( !si2drObjectIsNull(var1, &err) && si2drAttrGetAttrType(var1, &err) == SI2DR_SIMPLE
+       && si2drSimpleAttrGetValueType(var1, &err) == SI2DR_STRING )
+      result = !strcmp(si2drSimpleAttrGetStringValue(var1, &err), "total_output_net_capacitance");
+   return result;
+}
+
+struct liberty_ccs_arc *liberty_ccs_build(si2drGroupIdT group)
+{
+   si2drErrorT err;
+   si2drGroupsIdT vectors = si2drGroupGetGroupsByType(group, "vector", &err);
+   si2drGroupIdT vector;
+   si2drAttrIdT ref;
+   struct liberty_ccs_arc *arc;
+   struct liberty_value_data *vd;
+   ccs_raw_vector *raw = 0;
+   double *slews, *loads;
+   long nsamples = 0, at;
+   int n = 0, cap = 0, k, i, g, load_first = -1;
+
+   while( !si2drObjectIsNull((vector = si2drIterNextGroup(vectors, &err)), &err) )
+   {
+      vd = liberty_get_values_data(vector);
+      if( !vd || vd->dimensions != 3 || vd->dim_sizes[0] != 1 || vd->dim_sizes[1] != 1 || vd->dim_sizes[2] < 1 )
+      {
+         if( vd )
+            liberty_destroy_value_data(vd);
+         continue;
+      }
+      if( load_first < 0 )
+         load_first = ccs_load_first(vector);
+      if( n == cap )
+      {
+         cap = cap ? cap*2 : 64;
+         raw = (ccs_raw_vector*)realloc(raw, cap*sizeof(ccs_raw_vector));
+      }
+      raw[n].slew = liberty_get_index_at(vd, load_first, 0);
+      raw[n].load = liberty_get_index_at(vd, !load_first, 0);
+      raw[n].reference_time = 0.0;
+      ref = si2drGroupFindAttrByName(vector, "reference_time", &err);
+      if( !si2drObjectIsNull(ref, &err) && si2drAttrGetAttrType(ref, &err) == SI2DR_SIMPLE )
+      {
+         if( si2drSimpleAttrGetValueType(ref, &err) == SI2DR_FLOAT64 )
+            raw[n].reference_time = si2drSimpleAttrGetFloat64Value(ref, &err);
+         else if( si2drSimpleAttrGetValueType(ref, &err) == SI2DR_INT32 )
+            raw[n].reference_time = si2drSimpleAttrGetInt32Value(ref, &err);
+      }
+      raw[n].vd = vd;
+      nsamples += vd->dim_sizes[2];
+      n++;
+   }
+   si2drIterQuit(vectors, &err);
+   if( n == 0 )
+   {
+      free(raw);
+      return NULL;
+   }
+
+   arc = (struct liberty_ccs_arc*)calloc(sizeof(struct liberty_ccs_arc),1);
+   arc->group = group;
+   slews = (double*)malloc(n*sizeof(double));
+   loads = (double*)malloc(n*sizeof(double));
+   for(k=0; k<n; k++)
+   {
+      slews[k] = raw[k].slew;
+      loads[k] = raw[k].load;
+   }
+   arc->nslew = ccs_unique(slews, n);
+   arc->nload = ccs_unique(loads, n);
+   arc->slews = slews;
+   arc->loads = loads;
+   arc->vector_at = (int*)malloc(arc->nslew*arc->nload*sizeof(int));
+   for(g=0; g<arc->nslew*arc->nload; g++)
+      arc->vector_at[g] = -1;
+
+   arc->nvectors = n;
+   arc->reference_time = (double*)malloc(n*sizeof(double));
+   arc->charge = (double*)malloc(n*sizeof(double));
+   arc->offset = (long*)malloc((n+1)*sizeof(long));
+   arc->times = (double*)malloc(2*nsamples*sizeof(double));
+   arc->currents = arc->times + nsamples;
+   at = 0;
+   for(k=0; k<n; k++)
+   {
+      vd = raw[k].vd;
+      g = ccs_find(slews, arc->nslew, raw[k].slew)*arc->nload + ccs_find(loads, arc->nload, raw[k].load);
+      if( arc->vector_at[g] < 0 )
+         arc->vector_at[g] = k; /* a repeated grid point keeps its first vector */
+      arc->reference_time[k] = raw[k].reference_time;
+      arc->offset[k] = at;
+      arc->charge[k] = 0.0;
+      for(i=0; i<vd->dim_sizes[2]; i++, at++)
+      {
+         arc->times[at] = liberty_get_index_at(vd, 2, i) - raw[k].reference_time;
+         arc->currents[at] = liberty_get_value_at(vd, i);
+         if( i > 0 )
+            arc->charge[k] += 0.5 * (arc->currents[at-1] + arc->currents[at]) * (arc->times[at] - arc->times[at-1]);
+      }
+      liberty_destroy_value_data(vd);
+   }
+   arc->offset[n] = at;
+   arc->nsamples = at;
+   free(raw);
+   return arc;
+}
+
+void liberty_ccs_free(struct liberty_ccs_arc *arc)
+{
+   if( !arc )
+      return;
+   free(arc->slews);
+   free(arc->loads);
+   free(arc->vector_at);
+   free(arc->reference_time);
+   free(arc->charge);
+   free(arc->offset);
+   free(arc->times);
+   free(arc);
+}
+
+/* the interval [v[i], v[i+1]] holding x, and x's weight toward v[i+1],
+   clamped to 0..1 */
+static int ccs_interval(const double *v, int n, double x, double *w)
+{
+   int i;
+
+   *w = 0.0;
+   if( n < 2 )
+      return 0;
+   i = ccs_find(v, n, x);
+   if( i > 0 )
+      i--;
+   if( i > n-2 )
+      i = n-2;
+   if( x <= v[i] )
+      *w = 0.0;
+   else if( x >= v[i+1] )
+      *w = 1.0;
+   else
+      *w = (x - v[i]) / (v[i+1] - v[i]);
+   return i;
+}
+
+/* the vectors around (slew, load) and their weights; returns how many */
+static int ccs_corners(const struct liberty_ccs_arc *arc, double slew, double load, int *vec, double *w)
+{
+   double ws, wl, cw, sum = 0.0;
+   int s, l, c, k, m = 0;
+
+   s = ccs_interval(arc->slews, arc->nslew, slew, &ws);
+   l = ccs_interval(arc->loads, arc->nload, load, &wl);
+   for(c=0; c<4; c++)
+   {
+      if( (c & 1 && s+1 >= arc->nslew) || (c & 2 && l+1 >= arc->nload) )
+         continue;
+      cw = (c & 1 ? ws : 1.0 - ws) * (c & 2 ? wl : 1.0 - wl);
+      k = arc->vector_at[(s + (c & 1))*arc->nload + l + (c >> 1)];
+      if( cw == 0.0 || k < 0 )
+         continue;
+      vec[m] = k;
+      w[m++] = cw;
+      sum += cw;
+   }
+   for(c=0; c<m; c++)
+      w[c] /= sum;
+   return m;
+}
+
+/* the current of vector k at time t */
+static double ccs_sample(const struct liberty_ccs_arc *arc, int k, double t)
+{
+   const double *times = arc->times + arc->offset[k];
+   const double *currents = arc->currents + arc->offset[k];
+   int n = arc->offset[k+1] - arc->offset[k], i;
+
+   if( t < times[0] || t > times[n-1] )
+      return 0.0;
+   if( n == 1 )
+      return currents[0];
+   i = ccs_find(times, n, t);
+   if( i == 0 )
+      return currents[0];
+   if( times[i] == times[i-1] )
+      return currents[i];
+   return currents[i-1] + (currents[i] - currents[i-1]) * (t - times[i-1]) / (times[i] - times[i-1]);
+}
+
+void liberty_ccs_eval(const struct liberty_ccs_arc *arc, int nqueries, const double *slews, const double *loads,
+                      int ntimes, const double *times, double *out)
+{
+   double w[4], r;
+   int vec[4], q, j, c, m;
+
+   for(q=0; q<nqueries; q++)
+   {
+      m = ccs_corners(arc, slews[q], loads[q], vec, w);
+      for(j=0; j<ntimes; j++)
+      {
+         r = m ? 0.0 : NAN;
+         for(c=0; c<m; c++)
+            r += w[c] * ccs_sample(arc, vec[c], times[j]);
+         out[(long)q*ntimes + j] = r;
+      }
+   }
+}
+
+void liberty_ccs_charge(const struct liberty_ccs_arc *arc, int nqueries, const double *slews, const double *loads, double *out)
+{
+   double w[4], r;
+   int vec[4], q, c, m;
+
+   for(q=0; q<nqueries; q++)
+   {
+      m = ccs_corners(arc, slews[q], loads[q], vec, w);
+      r = m ? 0.0 : NAN;
+      for(c=0; c<m; c++)
+         r += w[c] * arc->charge[vec[c]];
+      out[q] = r;
+   }
+}
+
+/* the time the blended waveform has delivered fraction of its charge. The
+   walk goes over the merged sample times of the vectors; on each segment
+   [a, b] between two of them, a vector is linear between the samples its
+   cursor straddles, or zero outside its range. */
+static double ccs_crossing_one(const struct liberty_ccs_arc *arc, int m, const int *vec, const double *w, double fraction)
+{
+   const double *times = arc->times, *currents = arc->currents;
+   long pos[4], first[4], end[4], i;
+   double total = 0.0, sign, target, done = 0.0, a = 0.0, b, ya, yb, span, area, slope, disc, s;
+   int c, started = 0;
+
+   for(c=0; c<m; c++)
+   {
+      total += w[c] * arc->charge[vec[c]];
+      pos[c] = first[c] = arc->offset[vec[c]];
+      end[c] = arc->offset[vec[c]+1];
+   }
+   if( m == 0 || total == 0.0 )
+      return NAN;
+   sign = total < 0.0 ? -1.0 : 1.0;
+   target = fraction * total * sign;
+   for(;;)
+   {
+      b = INFINITY;
+      for(c=0; c<m; c++)
+      {
+         if( pos[c] < end[c] && times[pos[c]] < b )
+            b = times[pos[c]];
+      }
+      if( b == INFINITY )
+         break;
+      if( started )
+      {
+         ya = yb = 0.0;
+         for(c=0; c<m; c++)
+         {
+            i = pos[c];
+            if( i == first[c] || i == end[c] || (span = times[i] - times[i-1]) <= 0.0 )
+               continue;
+            ya += w[c] * (currents[i-1] + (currents[i] - currents[i-1]) * (a - times[i-1]) / span);
+            yb += w[c] * (currents[i-1] + (currents[i] - currents[i-1]) * (b - times[i-1]) / span);
+         }
+         ya *= sign;
+         yb *= sign;
+         area = 0.5 * (ya + yb) * (b - a);
+         if( done + area >= target && area > 0.0 )
+         {
+            /* done + ya s + slope s^2 / 2 = target, for s in [0, b-a] */
+            slope = (yb - ya) / (b - a);
+            disc = ya*ya + 2.0*slope*(target - done);
+            s = disc > 0.0 && ya + sqrt(disc) > 0.0 ? 2.0*(target - done) / (ya + sqrt(disc)) : b - a;
+            return a + (s < 0.0 ? 0.0 : s > b - a ? b - a : s);
+         }
+         done += area;
+      }
+      else if( target <= 0.0 )
+         return b;
+      started = 1;
+      a = b;
+      for(c=0; c<m; c++)
+      {
+         while( pos[c] < end[c] && times[pos[c]] <= b )
+            pos[c]++;
+      }
+   }
+   return a; /* rounding kept the sum just short of the total */
+}
+
+void liberty_ccs_crossing(const struct liberty_ccs_arc *arc, int nqueries, const double *slews, const double *loads,
+                          double fraction, double *out)
+{
+   double w[4];
+   int vec[4], q, m;
+
+   for(q=0; q<nqueries; q++)
+   {
+      m = ccs_corners(arc, slews[q], loads[q], vec, w);
+      out[q] = ccs_crossing_one(arc, m, vec, w, fraction);
+   }
+}
@@ -0,0 +1,374 @@
+/* SILIMATE: a compact copy of a decoded table for libraries kept resident
+   in numbers (many corners at once). An index vector of evenly spaced
+   breakpoints is stored as its first entry and step, and index vectors are
+   pooled by content, so the tables of one template share theirs. The
+   values, in the same block as the table, are stored
+   as a base and a scale with one unsigned 8- or 16-bit code each, value k
+   being base + scale * code[k], with the narrowest code that keeps every
+   value within the tolerance; a table no code fits keeps its doubles.
+   Every reconstructed number is compared with the original before the
+   packing is accepted, so max_error is a measured bound, not an estimate. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+#include <pthread.h>
+#include "si2dr_liberty.h"
+#include "liberty_pool.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define PACK_HAVE_AVX2_KERNEL 1
+#endif
+
+/* index breakpoints this close to a straight line, relative to their
+   largest magnitude, are taken as evenly spaced */
+#define PACK_INDEX_TOLERANCE 1e-12
+
+static double pack_code_value(const struct liberty_packed_table *pt, int pos)
+{
+   if( pt->code_bits == 8 )
+      return pt->base + pt->scale * (double)((const uint8_t*)pt->codes)[pos];
+   return pt->base + pt->scale * (double)((const uint16_t*)pt->codes)[pos];
+}
+
+typedef struct pack_index_entry
+{
+   struct liberty_pool_entry link;
+   int n;
+   double v[1]; /* n of them */
+} pack_index_entry;
+
+static int pack_index_same(const struct liberty_pool_entry *a, const struct liberty_pool_entry *b)
+{
+   const pack_index_entry *x = (const pack_index_entry*)a, *y = (const pack_index_entry*)b;
+
+   return x->n == y->n && !memcmp(x->v, y->v, x->n*sizeof(double));
+}
+
+static struct liberty_pool pack_index_pool = LIBERTY_POOL_INITIALIZER(256, pack_index_same);
+
+/* the pooled copy of the n doubles */
+static const double *pack_intern_index(const double *v, int n)
+{
+   pack_index_entry *e = (pack_index_entry*)malloc(sizeof(pack_index_entry) + (n > 1 ? n-1 : 0)*sizeof(double)), *x;
+
+   e->link.hash = liberty_pool_hash(LIBERTY_POOL_HASH_SEED, v, n*sizeof(double));
+   e->n = n;
+   memcpy(e->v, v, n*sizeof(double));
+   x = (pack_index_entry*)liberty_pool_intern(&pack_index_pool, &e->link);
+   if( x != e )
+      free(e);
+   return x->v;
+}
+
+static void pack_release_index(const double *v)
+{
+   pack_index_entry *e;
+
+   if( !v )
+      return;
+   e = (pack_index_entry*)((char*)v - offsetof(pack_index_entry, v));
+   if( liberty_pool_release(&pack_index_pool, &e->link) )
+      free(e);
+}
+
+static void pack_index(struct liberty_packed_table *pt, const struct liberty_value_data *vd, int d)
+{
+   int i, n = vd->dim_sizes[d];
+   double *v = (double*)malloc((n > 2 ? n : 2)*sizeof(double)), step = 0.0, mag = 0.0;
+
+   for(i=0; i<n; i++)
+   {
+      v[i] = liberty_get_index_at(vd, d, i);
+      if( fabs(v[i]) > mag )
+         mag = fabs(v[i]);
+   }
+   if( n > 2 )
+   {
+      step = (v[n-1] - v[0]) / (n-1);
+      for(i=0; i<n; i++)
+      {
+         if( !(fabs(v[0] + step*i - v[i]) <= PACK_INDEX_TOLERANCE*mag) )
+            break;
+      }
+      if( i == n )
+      {
+         v[1] = step;
+         n = 2;
+         pt->affine |= 1u << d;
+      }
+   }
+   pt->index[d] = pack_intern_index(v, n);
+   free(v);
+}
+
+/* codes of the given width for the n values in v, the scale going into
+   *scale; 0 if some value would be off by more than tol, otherwise the
+   largest error goes into *worst */
+static int pack_try_codes(const double *v, int n, int bits, double lo, double hi, double tol,
+                          void *codes, double *scale, double *worst)
+{
+   struct liberty_packed_table probe;
+   int k, top = (1 << bits) - 1;
+   double q, err;
+
+   probe.code_bits = bits;
+   probe.base = lo;
+   probe.scale = *scale = (hi - lo) / top;
+   probe.codes = codes;
+   *worst = 0.0;
+   for(k=0; k<n; k++)
+   {
+      q = probe.scale > 0.0 ? floor((v[k] - lo) / probe.scale + 0.5) : 0.0;
+      if( q > top )
+         q = top;
+      if( bits == 8 )
+         ((uint8_t*)codes)[k] = (uint8_t)q;
+      else
+         ((uint16_t*)codes)[k] = (uint16_t)q;
+      err = fabs(pack_code_value(&probe, k) - v[k]);
+      if( !(err <= tol) )
+         return 0;
+      if( err > *worst )
+         *worst = err;
+   }
+   return 1;
+}
+
+struct liberty_packed_table *liberty_pack_table(const struct liberty_value_data *vd, double tolerance)
+{
+   struct liberty_packed_table *pt;
+   double *v, lo, hi, mag = 0.0, tol, scale = 0.0, worst = 0.0;
+   void *codes;
+   int d, k, n = 1, bits = 0;
+
+   if( !vd || !(vd->values || vd->narrow_values) || vd->dimensions < 0 || vd->dimensions > 7 )
+      return NULL;
+   for(d=0; d<vd->dimensions; d++)
+      n *= vd->dim_sizes[d];
+   if( n == 0 )
+      return NULL;
+
+   v = (double*)malloc(n*sizeof(double));
+   lo = hi = liberty_get_value_at(vd, 0);
+   for(k=0; k<n; k++)
+   {
+      v[k] = liberty_get_value_at(vd, k);
+      if( !isfinite(v[k]) )
+         break;
+      if( v[k] < lo )
+         lo = v[k];
+      if( v[k] > hi )
+         hi = v[k];
+      if( fabs(v[k]) > mag )
+         mag = fabs(v[k]);
+   }
+   tol = tolerance * mag;
+   codes = malloc(n*sizeof(uint16_t));
+   if( k == n && isfinite(hi - lo) && (tolerance > 0.0 || lo == hi) )
+   {
+      if( pack_try_codes(v, n, 8, lo, hi, tol, codes, &scale, &worst) )
+         bits = 8;
+      else if( pack_try_codes(v, n, 16, lo, hi, tol, codes, &scale, &worst) )
+         bits = 16;
+   }
+
+   /* the values or codes follow the table in its block */
+   pt = (struct liberty_packed_table*)calloc(sizeof(struct liberty_packed_table) + (long)n*(bits ? bits/8 : sizeof(double)), 1);
+   pt->dimensions = vd->dimensions;
+   pt->nvalues = n;
+   pt->code_bits = bits;
+   pt->base = lo;
+   pt->scale = scale;
+   pt->max_error = worst;
+   if( bits )
+   {
+      pt->codes = pt + 1;
+      memcpy(pt->codes, codes, (long)n*(bits/8));
+   }
+   else
+   {
+      pt->values = (double*)(pt + 1);
+      memcpy(pt->values, v, n*sizeof(double));
+   }
+   for(d=0; d<vd->dimensions; d++)
+   {
+      pt->dim_sizes[d] = vd->dim_sizes[d];
+      pack_index(pt, vd, d);
+   }
+   free(codes);
+   free(v);
+   return pt;
+}
+
+void liberty_free_packed_table(struct liberty_packed_table *pt)
+{
+   int d;
+
+   if( !pt )
+      return;
+   for(d=0; d<pt->dimensions; d++)
+      pack_release_index(pt->index[d]);
+   free(pt);
+}
+
+/* the table's block, and its share of the pooled index vectors */
+double liberty_packed_table_bytes(const struct liberty_packed_table *pt)
+{
+   double bytes = sizeof(struct liberty_packed_table) + (double)pt->nvalues*(pt->code_bits ? pt->code_bits/8 : sizeof(double));
+   pack_index_entry *e;
+   int d;
+
+   pthread_mutex_lock(&pack_index_pool.lock);
+   for(d=0; d<pt->dimensions; d++)
+   {
+      e = (pack_index_entry*)((char*)pt->index[d] - offsetof(pack_index_entry, v));
+      bytes += (sizeof(pack_index_entry) + (e->n-1)*sizeof(double)) / (double)e->link.refs;
+   }
+   pthread_mutex_unlock(&pack_index_pool.lock);
+   return bytes;
+}
+
+static double pack_value(const struct liberty_packed_table *pt, int pos)
+{
+   if( !pt->code_bits )
+      return pt->values[pos];
+   return pack_code_value(pt, pos);
+}
+
+static double pack_index_value(const struct liberty_packed_table *pt, int dim, int i)
+{
+   if( pt->affine >> dim & 1 )
+      return pt->index[dim][0] + pt->index[dim][1]*i;
+   return pt->index[dim][i];
+}
+
+double liberty_packed_value_at(const struct liberty_packed_table *pt, int pos)
+{
+   return pack_value(pt, pos);
+}
+
+double liberty_packed_index_at(const struct liberty_packed_table *pt, int dim, int i)
+{
+   return pack_index_value(pt, dim, i);
+}
+
+#ifdef PACK_HAVE_AVX2_KERNEL
+/* the same product and sum as pack_code_value, four values at a time;
+   returns how many it did */
+__attribute__((target("avx2")))
+static int pack_unpack_avx2(const struct liberty_packed_table *pt, int first, int count, double *out)
+{
+   const __m256d base = _mm256_set1_pd(pt->base);
+   const __m256d scale = _mm256_set1_pd(pt->scale);
+   __m128i c;
+   int32_t bytes;
+   int k;
+
+   for(k=0; k+4<=count; k+=4)
+   {
+      if( pt->code_bits == 8 )
+      {
+         memcpy(&bytes, (const uint8_t*)pt->codes + first + k, 4);
+         c = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes));
+      }
+      else
+         c = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)((const uint16_t*)pt->codes + first + k)));
+      _mm256_storeu_pd(out + k, _mm256_add_pd(base, _mm256_mul_pd(scale, _mm256_cvtepi32_pd(c))));
+   }
+   return k;
+}
+#endif
+
+void liberty_unpack_values(const struct liberty_packed_table *pt, int first, int count, double *out)
+{
+   int k = 0;
+
+   if( !pt->code_bits )
+   {
+      memcpy(out, pt->values + first, count*sizeof(double));
+      return;
+   }
+#ifdef PACK_HAVE_AVX2_KERNEL
+   if( __builtin_cpu_supports("avx2") )
+      k = pack_unpack_avx2(pt, first, count, out);
+#endif
+   for(; k<count; k++)
+      out[k] = pack_code_value(pt, first + k);
+}
+
+/* the interval to interpolate x in, as lut_interval in liberty_interp.c */
+static int pack_interval(const struct liberty_packed_table *pt, int d, double x)
+{
+   int lo = 0, hi = pt->dim_sizes[d]-2, mid;
+   double at;
+
+   if( pt->affine >> d & 1 && pt->index[d][1] > 0.0 )
+   {
+      /* evenly spaced: the interval is a division away, then checked
+         against the same breakpoints the search would compare */
+      at = floor((x - pt->index[d][0]) / pt->index[d][1]);
+      lo = !(at > 0.0) ? 0 : at > hi ? hi : (int)at;
+      while( lo > 0 && pack_index_value(pt, d, lo) > x )
+         lo--;
+      while( lo < hi && pack_index_value(pt, d, lo+1) <= x )
+         lo++;
+      return lo;
+   }
+   while( lo < hi )
+   {
+      mid = (lo+hi+1)/2;
+      if( pack_index_value(pt, d, mid) <= x )
+         lo = mid;
+      else
+         hi = mid-1;
+   }
+   return lo;
+}
+
+double liberty_packed_lookup(const struct liberty_packed_table *pt, const double *point)
+{
+   double w[7], weight, lo, hi, r = 0.0;
+   int strides[7], d, c, i, off, base = 0, n = 1;
+
+   for(d=pt->dimensions-1; d>=0; d--)
+   {
+      strides[d] = n;
+      n *= pt->dim_sizes[d];
+   }
+   for(d=0; d<pt->dimensions; d++)
+   {
+      w[d] = 0.0;
+      if( pt->dim_sizes[d] < 2 )
+         continue;
+      i = pack_interval(pt, d, point[d]);
+      lo = pack_index_value(pt, d, i);
+      hi = pack_index_value(pt, d, i+1);
+      if( hi != lo )
+         w[d] = (point[d] - lo) / (hi - lo);
+      base += i * strides[d];
+   }
+   for(c=0; c < 1<<pt->dimensions; c++)
+   {
+      weight = 1.0;
+      off = base;
+      for(d=0; d<pt->dimensions; d++)
+      {
+         if( c >> d & 1 )
+         {
+            if( pt->dim_sizes[d] < 2 )
+               break;
+            weight *= w[d];
+            off += strides[d];
+         }
+         else
+            weight *= 1.0 - w[d];
+      }
+      if( d == pt->dimensions )
+         r += weight * pack_value(pt, off);
+   }
+   return r;
+}
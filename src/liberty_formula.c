@@ -0,0 +1,295 @@
+/* SILIMATE: Boolean formulas (function, next_state, clear, preset, ...)
+   compiled once into a small stack program and evaluated 64 input vectors
+   at a time. Operators, loosest first: | + (or), & * or a blank (and),
+   ^ (xor), and ! prefix or ' postfix (not); 0 and 1 are constants. A
+   variable is any run of other characters, as the checks have always
+   tokenized them. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "si2dr_liberty.h"
+
+enum formula_op
+{
+   FORMULA_VAR,   /* push variable code>>3 */
+   FORMULA_ZERO,
+   FORMULA_ONE,
+   FORMULA_NOT,
+   FORMULA_AND,
+   FORMULA_OR,
+   FORMULA_XOR
+};
+
+#define FORMULA_OP_BITS 3
+
+struct formula_parser
+{
+   const char *text;
+   const char *p;
+   struct liberty_formula *f;
+   int capacity; /* of f->code */
+   int varcap;   /* of f->vars */
+   int error;
+};
+
+static int formula_separator(int c)
+{
+   return c == '(' || c == ')' || c == ' ' || c == '\t' || c == '\n' || c == '\r'
+      || c == '&' || c == '|' || c == '*' || c == '!' || c == '^' || c == '+' || c == '\'';
+}
+
+static void formula_skip_blanks(struct formula_parser *fp)
+{
+   for(;;)
+   {
+      if( *fp->p == ' ' || *fp->p == '\t' || *fp->p == '\n' || *fp->p == '\r' )
+         fp->p++;
+      else if( *fp->p == '\\' && (fp->p[1] == '\n' || (fp->p[1] == '\r' && fp->p[2] == '\n')) )
+         fp->p += fp->p[1] == '\n' ? 2 : 3; /* escaped newline */
+      else
+         break;
+   }
+}
+
+static void formula_emit(struct formula_parser *fp, int op)
+{
+   if( fp->f->ncode == fp->capacity )
+   {
+      fp->capacity = fp->capacity ? fp->capacity*2 : 16;
+      fp->f->code = (int*)realloc(fp->f->code, fp->capacity*sizeof(int));
+   }
+   fp->f->code[fp->f->ncode++] = op;
+}
+
+static int formula_var_index(struct formula_parser *fp, const char *name, int len)
+{
+   struct liberty_formula *f = fp->f;
+   int i;
+
+   for(i=0; i<f->nvars; i++)
+   {
+      if( !strncmp(f->vars[i], name, len) && f->vars[i][len] == 0 )
+         return i;
+   }
+   if( f->nvars == fp->varcap )
+   {
+      fp->varcap = fp->varcap ? fp->varcap*2 : 8;
+      f->vars = (char**)realloc(f->vars, fp->varcap*sizeof(char*));
+   }
+   f->vars[f->nvars] = (char*)malloc(len+1);
+   memcpy(f->vars[f->nvars], name, len);
+   f->vars[f->nvars][len] = 0;
+   return f->nvars++;
+}
+
+static void formula_or(struct formula_parser *fp);
+
+/* operand: a name, a constant, or a parenthesized formula, each with any
+   number of ' suffixes; or ! applied to an operand */
+static void formula_operand(struct formula_parser *fp)
+{
+   const char *start;
+
+   formula_skip_blanks(fp);
+   if( *fp->p == '!' )
+   {
+      fp->p++;
+      formula_operand(fp);
+      formula_emit(fp, FORMULA_NOT);
+      return;
+   }
+   if( *fp->p == '(' )
+   {
+      fp->p++;
+      formula_or(fp);
+      if( fp->error )
+         return;
+      formula_skip_blanks(fp);
+      if( *fp->p != ')' )
+      {
+         fp->error = 1;
+         return;
+      }
+      fp->p++;
+   }
+   else
+   {
+      start = fp->p;
+      while( *fp->p && !formula_separator(*fp->p) && !(*fp->p == '\\' && fp->p[1] == '\n') )
+         fp->p++;
+      if( fp->p == start )
+      {
+         fp->error = 1;
+         return;
+      }
+      if( fp->p - start == 1 && (*start == '0' || *start == '1') )
+         formula_emit(fp, *start == '0' ? FORMULA_ZERO : FORMULA_ONE);
+      else
+         formula_emit(fp, FORMULA_VAR | formula_var_index(fp, start, fp->p - start) << FORMULA_OP_BITS);
+   }
+   for(;;)
+   {
+      formula_skip_blanks(fp);
+      if( *fp->p != '\'' )
+         break;
+      fp->p++;
+      formula_emit(fp, FORMULA_NOT);
+   }
+}
+
+static void formula_xor(struct formula_parser *fp)
+{
+   formula_operand(fp);
+   while( !fp->error )
+   {
+      formula_skip_blanks(fp);
+      if( *fp->p != '^' )
+         break;
+      fp->p++;
+      formula_operand(fp);
+      formula_emit(fp, FORMULA_XOR);
+   }
+}
+
+static void formula_and(struct formula_parser *fp)
+{
+   formula_xor(fp);
+   while( !fp->error )
+   {
+      formula_skip_blanks(fp);
+      if( *fp->p == '&' || *fp->p == '*' )
+         fp->p++;
+      else if( !*fp->p || *fp->p == ')' || *fp->p == '|' || *fp->p == '+' )
+         break;
+      /* anything else starts another operand: a blank means and */
+      formula_xor(fp);
+      formula_emit(fp, FORMULA_AND);
+   }
+}
+
+static void formula_or(struct formula_parser *fp)
+{
+   formula_and(fp);
+   while( !fp->error )
+   {
+      formula_skip_blanks(fp);
+      if( *fp->p != '|' && *fp->p != '+' )
+         break;
+      fp->p++;
+      formula_and(fp);
+      formula_emit(fp, FORMULA_OR);
+   }
+}
+
+struct liberty_formula *liberty_formula_compile(const char *text, int *errpos)
+{
+   struct formula_parser fp;
+   int i, depth = 0;
+
+   memset(&fp, 0, sizeof(fp));
+   fp.text = fp.p = text;
+   fp.f = (struct liberty_formula*)calloc(sizeof(struct liberty_formula),1);
+   formula_or(&fp);
+   if( !fp.error )
+   {
+      formula_skip_blanks(&fp);
+      if( *fp.p )
+         fp.error = 1; /* an unmatched ')' */
+   }
+   if( fp.error )
+   {
+      if( errpos )
+         *errpos = fp.p - text;
+      liberty_formula_free(fp.f);
+      return NULL;
+   }
+   for(i=0; i<fp.f->ncode; i++)
+   {
+      switch( fp.f->code[i] & ((1<<FORMULA_OP_BITS)-1) )
+      {
+         case FORMULA_VAR:
+         case FORMULA_ZERO:
+         case FORMULA_ONE:
+            if( ++depth > fp.f->depth )
+               fp.f->depth = depth;
+            break;
+         case FORMULA_NOT:
+            break;
+         default:
+            depth--;
+            break;
+      }
+   }
+   return fp.f;
+}
+
+uint64_t liberty_formula_eval(const struct liberty_formula *f, const uint64_t *vars)
+{
+   uint64_t small[32], *stack;
+   uint64_t result;
+   int i, sp = 0, op;
+
+   if( f->ncode <= 0 || f->depth <= 0 )
+      return 0; /* an empty program is false */
+   stack = f->depth <= 32 ? small : (uint64_t*)malloc(f->depth*sizeof(uint64_t));
+   for(i=0; i<f->ncode; i++)
+   {
+      op = f->code[i];
+      switch( op & ((1<<FORMULA_OP_BITS)-1) )
+      {
+         case FORMULA_VAR:  stack[sp++] = vars[op >> FORMULA_OP_BITS]; break;
+         case FORMULA_ZERO: stack[sp++] = 0; break;
+         case FORMULA_ONE:  stack[sp++] = ~(uint64_t)0; break;
+         case FORMULA_NOT:  stack[sp-1] = ~stack[sp-1]; break;
+         case FORMULA_AND:  sp--; stack[sp-1] &= stack[sp]; break;
+         case FORMULA_OR:   sp--; stack[sp-1] |= stack[sp]; break;
+         case FORMULA_XOR:  sp--; stack[sp-1] ^= stack[sp]; break;
+      }
+   }
+   result = stack[0];
+   if( stack != small )
+      free(stack);
+   return result;
+}
+
+/* bit r of word r/64 is the value of the formula with variable i set to
+   bit i of r */
+void liberty_formula_truth_table(const struct liberty_formula *f, uint64_t *table)
+{
+   static const uint64_t low[6] =
+   {
+      0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+      0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull
+   };
+   uint64_t small[32], *vars = f->nvars <= 32 ? small : (uint64_t*)malloc(f->nvars*sizeof(uint64_t));
+   uint64_t w, nwords = f->nvars <= 6 ? 1 : (uint64_t)1 << (f->nvars - 6);
+   int i;
+
+   for(i=0; i<f->nvars && i<6; i++)
+      vars[i] = low[i];
+   for(w=0; w<nwords; w++)
+   {
+      for(i=6; i<f->nvars; i++)
+         vars[i] = (w >> (i-6)) & 1 ? ~(uint64_t)0 : 0;
+      table[w] = liberty_formula_eval(f, vars);
+   }
+   if( f->nvars < 6 )
+      table[0] &= ((uint64_t)1 << (1 << f->nvars)) - 1;
+   if( vars != small )
+      free(vars);
+}
+
+void liberty_formula_free(struct liberty_formula *f)
+{
+   int i;
+
+   if( !f )
+      return;
+   for(i=0; i<f->nvars; i++)
+      free(f->vars[i]);
+   free(f->vars);
+   free(f->code);
+   free(f);
+}
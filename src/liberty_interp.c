@@ -0,0 +1,243 @@
+/* SILIMATE: multilinear interpolation in lookup tables. A table is copied
+   once into double arrays; each query point then takes an interval search
+   per dimension and a weighted sum of the 2^dimensions surrounding values.
+   Points outside the index range are extrapolated from the first or last
+   interval, and a dimension of one entry is constant. Two-dimensional
+   batches (the NLDM delay, transition and power tables) go four points at
+   a time through an AVX2 kernel when the processor has it. The kernel
+   evaluates the same expression in the same order as the scalar code, so
+   the two agree to the last bit unless the scalar code is built with fused
+   multiply-adds. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "si2dr_liberty.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define LUT_HAVE_AVX2_KERNEL 1
+#endif
+
+struct liberty_lut *liberty_lut_prepare(const struct liberty_value_data *vd)
+{
+   struct liberty_lut *t;
+   int d, i, n = 1;
+
+   if( !vd || !(vd->values || vd->narrow_values) || vd->dimensions < 0 || vd->dimensions > 7 )
+      return NULL;
+   t = (struct liberty_lut*)calloc(sizeof(struct liberty_lut),1);
+   t->dimensions = vd->dimensions;
+   for(d=vd->dimensions-1; d>=0; d--)
+   {
+      t->dim_sizes[d] = vd->dim_sizes[d];
+      t->strides[d] = n;
+      n *= vd->dim_sizes[d];
+      t->index[d] = (double*)malloc((vd->dim_sizes[d] > 0 ? vd->dim_sizes[d] : 1)*sizeof(double));
+      for(i=0; i<vd->dim_sizes[d]; i++)
+         t->index[d][i] = liberty_get_index_at(vd, d, i);
+   }
+   t->values = (double*)malloc((n > 0 ? n : 1)*sizeof(double));
+   for(i=0; i<n; i++)
+      t->values[i] = liberty_get_value_at(vd, i);
+   if( n == 0 )
+   {
+      liberty_lut_free(t);
+      return NULL;
+   }
+   return t;
+}
+
+void liberty_lut_free(struct liberty_lut *t)
+{
+   int d;
+
+   if( !t )
+      return;
+   for(d=0; d<t->dimensions; d++)
+      free(t->index[d]);
+   free(t->values);
+   free(t);
+}
+
+/* the last i in lo..hi with idx[i] <= x, or lo */
+static int lut_search(const double *idx, int lo, int hi, double x)
+{
+   int mid;
+
+   while( lo < hi )
+   {
+      mid = (lo+hi+1)/2;
+      if( idx[mid] <= x )
+         lo = mid;
+      else
+         hi = mid-1;
+   }
+   return lo;
+}
+
+/* the interval [idx[i], idx[i+1]] to interpolate x in: the last one
+   starting at or below x, or the first one */
+static int lut_interval(const double *idx, int n, double x)
+{
+   return lut_search(idx, 0, n-2, x);
+}
+
+/* lut_interval, starting from the interval *hint: a slowly moving
+   coordinate is found in it or a neighbour, and one that jumped is
+   bracketed by steps of 1, 2, 4, ... away from it before the search */
+static int lut_interval_hinted(const double *idx, int n, double x, int *hint)
+{
+   int i = *hint < 0 ? 0 : *hint > n-2 ? n-2 : *hint, lo, hi, step = 1;
+
+   if( (i == 0 || idx[i] <= x) && (i == n-2 || idx[i+1] > x) )
+      return *hint = i;
+   if( i < n-2 && idx[i+1] <= x )
+   {
+      lo = i+1; /* idx[lo] <= x */
+      while( lo+step <= n-2 && idx[lo+step] <= x )
+      {
+         lo += step;
+         step *= 2;
+      }
+      hi = lo+step-1 < n-2 ? lo+step-1 : n-2;
+   }
+   else
+   {
+      hi = i-1; /* idx[hi+1] > x */
+      lo = hi-step < 0 ? 0 : hi-step+1;
+      while( lo > 0 && idx[lo] > x )
+      {
+         hi = lo-1;
+         step *= 2;
+         lo = hi-step+1 < 0 ? 0 : hi-step+1;
+      }
+   }
+   return *hint = lut_search(idx, lo, hi, x);
+}
+
+static double lut_lookup(const struct liberty_lut *t, const double *point, struct liberty_lut_hint *hint)
+{
+   double w[7], weight, r = 0.0;
+   int d, c, i, off, base = 0;
+
+   for(d=0; d<t->dimensions; d++)
+   {
+      w[d] = 0.0;
+      if( t->dim_sizes[d] < 2 )
+         continue;
+      if( hint )
+         i = lut_interval_hinted(t->index[d], t->dim_sizes[d], point[d], &hint->interval[d]);
+      else
+         i = lut_interval(t->index[d], t->dim_sizes[d], point[d]);
+      if( t->index[d][i+1] != t->index[d][i] )
+         w[d] = (point[d] - t->index[d][i]) / (t->index[d][i+1] - t->index[d][i]);
+      base += i * t->strides[d];
+   }
+   for(c=0; c < 1<<t->dimensions; c++)
+   {
+      weight = 1.0;
+      off = base;
+      for(d=0; d<t->dimensions; d++)
+      {
+         if( c >> d & 1 )
+         {
+            if( t->dim_sizes[d] < 2 )
+               break;
+            weight *= w[d];
+            off += t->strides[d];
+         }
+         else
+            weight *= 1.0 - w[d];
+      }
+      if( d == t->dimensions )
+         r += weight * t->values[off];
+   }
+   return r;
+}
+
+double liberty_lut_lookup(const struct liberty_lut *t, const double *point)
+{
+   return lut_lookup(t, point, NULL);
+}
+
+double liberty_lut_lookup_hinted(const struct liberty_lut *t, const double *point, struct liberty_lut_hint *hint)
+{
+   return lut_lookup(t, point, hint);
+}
+
+#ifdef LUT_HAVE_AVX2_KERNEL
+/* the interval of four points at once: the number of inner breakpoints at
+   or below x, which is what lut_interval finds in an ascending index */
+__attribute__((target("avx2")))
+static __m256i lut_interval4(const double *idx, int n, __m256d x)
+{
+   __m256i i = _mm256_setzero_si256();
+   int k;
+
+   for(k=1; k<n-1; k++)
+      i = _mm256_sub_epi64(i, _mm256_castpd_si256(_mm256_cmp_pd(_mm256_set1_pd(idx[k]), x, _CMP_LE_OQ)));
+   return i;
+}
+
+__attribute__((target("avx2")))
+static __m256d lut_weight4(const double *idx, __m256i i, __m256d x)
+{
+   __m256d lo = _mm256_i64gather_pd(idx, i, 8);
+   __m256d hi = _mm256_i64gather_pd(idx + 1, i, 8);
+   __m256d span = _mm256_sub_pd(hi, lo);
+   __m256d w = _mm256_div_pd(_mm256_sub_pd(x, lo), span);
+
+   return _mm256_blendv_pd(w, _mm256_setzero_pd(), _mm256_cmp_pd(span, _mm256_setzero_pd(), _CMP_EQ_OQ));
+}
+
+/* both dimensions have at least two entries; returns how many points it did */
+__attribute__((target("avx2")))
+static int lut_eval2_avx2(const struct liberty_lut *t, int npoints, const double *const *coords, double *out)
+{
+   const __m256d one = _mm256_set1_pd(1.0);
+   const __m256i stride0 = _mm256_set1_epi64x(t->strides[0]);
+   int p;
+
+   for(p=0; p+4<=npoints; p+=4)
+   {
+      __m256d x0 = _mm256_loadu_pd(coords[0] + p);
+      __m256d x1 = _mm256_loadu_pd(coords[1] + p);
+      __m256i i0 = lut_interval4(t->index[0], t->dim_sizes[0], x0);
+      __m256i i1 = lut_interval4(t->index[1], t->dim_sizes[1], x1);
+      __m256d w0 = lut_weight4(t->index[0], i0, x0);
+      __m256d w1 = lut_weight4(t->index[1], i1, x1);
+      __m256d a0 = _mm256_sub_pd(one, w0);
+      __m256d a1 = _mm256_sub_pd(one, w1);
+      __m256i off = _mm256_add_epi64(_mm256_mul_epu32(i0, stride0), i1);
+      __m256i off0 = _mm256_add_epi64(off, stride0);
+      __m256d r;
+
+      /* corners in the scalar order: (i0,i1) (i0+1,i1) (i0,i1+1) (i0+1,i1+1) */
+      r = _mm256_add_pd(_mm256_setzero_pd(), _mm256_mul_pd(_mm256_mul_pd(a0, a1), _mm256_i64gather_pd(t->values, off, 8)));
+      r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_mul_pd(w0, a1), _mm256_i64gather_pd(t->values, off0, 8)));
+      r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_mul_pd(a0, w1), _mm256_i64gather_pd(t->values + 1, off, 8)));
+      r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_mul_pd(w0, w1), _mm256_i64gather_pd(t->values + 1, off0, 8)));
+      _mm256_storeu_pd(out + p, r);
+   }
+   return p;
+}
+#endif
+
+void liberty_lut_eval(const struct liberty_lut *t, int npoints, const double *const *coords, double *out)
+{
+   struct liberty_lut_hint hint;
+   double point[7];
+   int p = 0, d;
+
+#ifdef LUT_HAVE_AVX2_KERNEL
+   if( t->dimensions == 2 && t->dim_sizes[0] > 1 && t->dim_sizes[1] > 1 && __builtin_cpu_supports("avx2") )
+      p = lut_eval2_avx2(t, npoints, coords, out);
+#endif
+   memset(&hint, 0, sizeof(hint));
+   for(; p<npoints; p++)
+   {
+      for(d=0; d<t->dimensions; d++)
+         point[d] = coords[d][p];
+      out[p] = lut_lookup(t, point, &hint);
+   }
+}
@@ -579,8 +579,8 @@ void make_complex(liberty_head *h)
    {
       if( v->type == LIBERTY__VAL_BOOLEAN )
          si2drComplexAttrAddBooleanValue(curr_attr,v->u.bool_val,&err);
-      else if( v->type == LIBERTY__VAL_STRING )
-         si2drComplexAttrAddStringValue(curr_attr,v->u.string_val,&err);		
+      else if( v->type == LIBERTY__VAL_STRING && liberty_numeric_attr(h->name) )
+         liberty_complex_attr_add_entered_string(curr_attr,v->u.string_val); /* SILIMATE: number lists, already stored by the lexer */
       else if( v->type == LIBERTY__VAL_DOUBLE )
          si2drComplexAttrAddFloat64Value(curr_attr,v->u.double_val,&err);
       else if(v->type ==LIBERTY__VAL_INT)
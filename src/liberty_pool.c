@@ -0,0 +1,75 @@
+/* SILIMATE: the content pool of liberty_pool.h, an open hash table of
+   chained entries that doubles when it is as full as it is long */
+
+#include <stdlib.h>
+#include "liberty_pool.h"
+
+uint64_t liberty_pool_hash(uint64_t h, const void *p, size_t n)
+{
+   const unsigned char *c = (const unsigned char*)p;
+
+   while( n-- )
+      h = (h ^ *c++) * 1099511628211ull;
+   return h;
+}
+
+struct liberty_pool_entry *liberty_pool_intern(struct liberty_pool *pool, struct liberty_pool_entry *e)
+{
+   struct liberty_pool_entry *x, *nx, **grown;
+   size_t i, size;
+
+   pthread_mutex_lock(&pool->lock);
+   if( pool->count >= pool->size )
+   {
+      size = pool->size ? pool->size*2 : pool->initial_size;
+      grown = (struct liberty_pool_entry**)calloc(size, sizeof(struct liberty_pool_entry*));
+      for(i=0; i<pool->size; i++)
+      {
+         for(x=pool->buckets[i]; x; x=nx)
+         {
+            nx = x->next;
+            x->next = grown[x->hash & (size-1)];
+            grown[x->hash & (size-1)] = x;
+         }
+      }
+      free(pool->buckets);
+      pool->buckets = grown;
+      pool->size = size;
+   }
+   for(x=pool->buckets[e->hash & (pool->size-1)]; x; x=x->next)
+   {
+      if( x->hash == e->hash && (*pool->same)(x, e) )
+         break;
+   }
+   if( !x )
+   {
+      x = e;
+      x->refs = 0;
+      x->next = pool->buckets[x->hash & (pool->size-1)];
+      pool->buckets[x->hash & (pool->size-1)] = x;
+      pool->count++;
+   }
+   x->refs++;
+   pool->refs++;
+   pthread_mutex_unlock(&pool->lock);
+   return x;
+}
+
+int liberty_pool_release(struct liberty_pool *pool, struct liberty_pool_entry *e)
+{
+   struct liberty_pool_entry **p;
+
+   pthread_mutex_lock(&pool->lock);
+   pool->refs--;
+   if( --e->refs > 0 )
+   {
+      pthread_mutex_unlock(&pool->lock);
+      return 0;
+   }
+   for(p=&pool->buckets[e->hash & (pool->size-1)]; *p != e; p=&(*p)->next)
+      ;
+   *p = e->next;
+   pool->count--;
+   pthread_mutex_unlock(&pool->lock);
+   return 1;
+}
@@ -0,0 +1,146 @@
+/* SILIMATE: every table of a library decoded into two large buffers of
+   doubles, the values and the index vectors, each table's arrays back to
+   back in file order. A pass over all the tables (scaling, min/max, a NaN
+   scan, a unit conversion) then walks one array, and threads can split it
+   at any boundary. The descriptors tell which slice belongs to which
+   group. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "si2dr_liberty.h"
+
+#define TABLE_STORE_ALIGN 64
+
+typedef struct table_store_builder
+{
+   struct liberty_table_store *ts;
+   struct liberty_value_data **vds;
+   long cap;
+} table_store_builder;
+
+static int table_store_template_id(struct liberty_table_store *ts, const char *name)
+{
+   int i;
+
+   if( !name )
+      name = "scalar";
+   for(i=ts->ntemplates-1; i>=0; i--)
+   {
+      if( ts->template_names[i] == name || !strcmp(ts->template_names[i], name) )
+         return i;
+   }
+   if( (ts->ntemplates & (ts->ntemplates-1)) == 0 )
+      ts->template_names = (char**)realloc(ts->template_names, (ts->ntemplates ? ts->ntemplates*2 : 1)*sizeof(char*));
+   ts->template_names[ts->ntemplates] = (char*)name;
+   return ts->ntemplates++;
+}
+
+static void table_store_collect(table_store_builder *b, si2drGroupIdT group)
+{
+   struct liberty_table_store *ts = b->ts;
+   struct liberty_table_desc *td;
+   struct liberty_value_data *vd;
+   si2drErrorT err;
+   si2drAttrIdT values = si2drGroupFindAttrByName(group, "values", &err);
+   si2drGroupsIdT groups;
+   si2drGroupIdT sub;
+   si2drNamesIdT names;
+   int d;
+
+   if( !si2drObjectIsNull(values, &err) && si2drAttrGetAttrType(values, &err) == SI2DR_COMPLEX )
+   {
+      vd = liberty_get_values_data(group);
+      if( vd && vd->dimensions > 0 && vd->dimensions <= 7 )
+      {
+         if( ts->ntables == b->cap )
+         {
+            b->cap = b->cap ? b->cap*2 : 256;
+            b->vds = (struct liberty_value_data**)realloc(b->vds, b->cap*sizeof(struct liberty_value_data*));
+            ts->tables = (struct liberty_table_desc*)realloc(ts->tables, b->cap*sizeof(struct liberty_table_desc));
+         }
+         td = &ts->tables[ts->ntables];
+         memset(td, 0, sizeof(*td));
+         td->group = group;
+         names = si2drGroupGetNames(group, &err);
+         td->template_id = table_store_template_id(ts, si2drIterNextName(names, &err));
+         si2drIterQuit(names, &err);
+         td->dimensions = vd->dimensions;
+         td->nvalues = 1;
+         for(d=0; d<vd->dimensions; d++)
+         {
+            td->dim_sizes[d] = vd->dim_sizes[d];
+            td->index_offset[d] = ts->nindex;
+            ts->nindex += vd->dim_sizes[d];
+            td->nvalues *= vd->dim_sizes[d];
+         }
+         td->values_offset = ts->nvalues;
+         ts->nvalues += td->nvalues;
+         b->vds[ts->ntables++] = vd;
+      }
+      else if( vd )
+         liberty_destroy_value_data(vd);
+   }
+
+   groups = si2drGroupGetGroups(group, &err);
+   while( !si2drObjectIsNull((sub = si2drIterNextGroup(groups, &err)), &err) )
+      table_store_collect(b, sub);
+   si2drIterQuit(groups, &err);
+}
+
+static double *table_store_alloc(long n)
+{
+   void *p = 0;
+
+   if( posix_memalign(&p, TABLE_STORE_ALIGN, (n > 0 ? n : 1)*sizeof(double)) )
+      return 0;
+   return (double*)p;
+}
+
+struct liberty_table_store *liberty_build_table_store(si2drGroupIdT root)
+{
+   struct liberty_table_store *ts = (struct liberty_table_store*)calloc(sizeof(struct liberty_table_store),1);
+   table_store_builder b;
+   struct liberty_table_desc *td;
+   struct liberty_value_data *vd;
+   long t, i;
+   int d;
+
+   memset(&b, 0, sizeof(b));
+   b.ts = ts;
+   table_store_collect(&b, root);
+   ts->values = table_store_alloc(ts->nvalues);
+   ts->index = table_store_alloc(ts->nindex);
+   for(t=0; t<ts->ntables; t++)
+   {
+      td = &ts->tables[t];
+      vd = b.vds[t];
+      if( ts->values && ts->index )
+      {
+         for(d=0; d<td->dimensions; d++)
+            for(i=0; i<td->dim_sizes[d]; i++)
+               ts->index[td->index_offset[d]+i] = liberty_get_index_at(vd, d, (int)i);
+         for(i=0; i<td->nvalues; i++)
+            ts->values[td->values_offset+i] = liberty_get_value_at(vd, (int)i);
+      }
+      liberty_destroy_value_data(vd);
+   }
+   free(b.vds);
+   if( !ts->values || !ts->index )
+   {
+      liberty_free_table_store(ts);
+      return 0;
+   }
+   return ts;
+}
+
+void liberty_free_table_store(struct liberty_table_store *ts)
+{
+   if( !ts )
+      return;
+   free(ts->tables);
+   free(ts->values);
+   free(ts->index);
+   free(ts->template_names);
+   free(ts);
+}
@@ -0,0 +1,565 @@
+/* SILIMATE: rescaling a library into other units once, after it is read.
+   The library's time_unit, capacitive_load_unit, voltage_unit,
+   current_unit, leakage_power_unit and pulling_resistance_unit say what its
+   numbers mean; every attribute and table whose quantity is known is
+   multiplied by library unit / target unit, and the unit attributes are
+   rewritten to the targets. Table values take their quantity from the
+   table group (a vector's from the group around it), and index vectors
+   from the template's variable_N. Internal
+   power tables are energies, in capacitive_load_unit * voltage_unit^2.
+   The numbers of all tables are gathered into one array, scaled in one
+   pass, and written back into their attributes. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "si2dr_liberty.h"
+#include "attr_enum.h"
+#include "group_enum.h"
+
+extern group_enum si2drGroupGetID(si2drGroupIdT group, si2drErrorT *err);
+extern attr_enum si2drAttrGetID(si2drAttrIdT attr, si2drErrorT *err);
+
+enum unit_quantity
+{
+   UNIT_NONE,
+   UNIT_TIME,
+   UNIT_CAPACITANCE,
+   UNIT_VOLTAGE,
+   UNIT_CURRENT,
+   UNIT_POWER,
+   UNIT_RESISTANCE,
+   UNIT_ENERGY,
+   UNIT_QUANTITIES
+};
+
+typedef struct unit_template
+{
+   char *type;
+   char *name;
+   int variable[7]; /* the quantity of each index */
+} unit_template;
+
+typedef struct unit_sweep
+{
+   double factor[UNIT_QUANTITIES];
+   unit_template *templates;
+   int ntemplates;
+   si2drAttrIdT *attrs; /* complex attributes to scale */
+   int *quantity;
+   long nattrs, cap;
+} unit_sweep;
+
+static const struct { const char *prefix; double scale; } unit_prefixes[] =
+{
+   {"f", 1e-15}, {"p", 1e-12}, {"n", 1e-9}, {"u", 1e-6}, {"m", 1e-3},
+   {"", 1.0}, {"k", 1e3}, {"K", 1e3}, {"M", 1e6}
+};
+
+double liberty_parse_unit(const char *text, const char *base)
+{
+   const char *p;
+   char *end;
+   double n = strtod(text, &end);
+   size_t i, len;
+
+   if( end == text )
+      n = 1.0;
+   for(p=end; *p == ' '; p++)
+      ;
+   len = strlen(p);
+   if( len < strlen(base) || strcasecmp(p + len - strlen(base), base) )
+      return 0.0;
+   len -= strlen(base);
+   for(i=0; i<sizeof(unit_prefixes)/sizeof(unit_prefixes[0]); i++)
+   {
+      if( strlen(unit_prefixes[i].prefix) == len && !strncmp(p, unit_prefixes[i].prefix, len) )
+         return n * unit_prefixes[i].scale;
+   }
+   return 0.0;
+}
+
+/* "1ps" for 1e-12 and "s" */
+static void unit_text(double si, const char *base, char *buf, size_t size)
+{
+   int i;
+
+   for(i=sizeof(unit_prefixes)/sizeof(unit_prefixes[0])-1; i>0; i--)
+   {
+      if( unit_prefixes[i].prefix[0] != 'K' && si >= unit_prefixes[i].scale * (1.0 - 1e-9) )
+         break;
+   }
+   snprintf(buf, size, "%.15g%s%s", si / unit_prefixes[i].scale, unit_prefixes[i].prefix, base);
+}
+
+static si2drStringT unit_string_attr(si2drGroupIdT library, const char *name, si2drAttrIdT *attr)
+{
+   si2drErrorT err;
+
+   *attr = si2drGroupFindAttrByName(library, (char*)name, &err);
+   if( si2drObjectIsNull(*attr, &err) || si2drAttrGetAttrType(*attr, &err) != SI2DR_SIMPLE
+       || si2drSimpleAttrGetValueType(*attr, &err) != SI2DR_STRING )
+      return NULL;
+   return si2drSimpleAttrGetStringValue(*attr, &err);
+}
+
+/* capacitive_load_unit (n, pf) in farads, and pf in farads into *unit */
+static double unit_capacitance(si2drGroupIdT library, double *unit)
+{
+   si2drErrorT err;
+   si2drAttrIdT attr = si2drGroupFindAttrByName(library, "capacitive_load_unit", &err);
+   si2drValuesIdT vals;
+   si2drValueTypeT type;
+   si2drInt32T i;
+   si2drFloat64T f, n = 1.0;
+   si2drStringT s;
+   si2drBooleanT b;
+   si2drExprT *e;
+   int k;
+
+   *unit = 1e-12;
+   if( si2drObjectIsNull(attr, &err) || si2drAttrGetAttrType(attr, &err) != SI2DR_COMPLEX )
+      return 1e-12;
+   vals = si2drComplexAttrGetValues(attr, &err);
+   for(k=0; k<2; k++)
+   {
+      si2drIterNextComplexValue(vals, &type, &i, &f, &s, &b, &e, &err);
+      if( k == 0 && type == SI2DR_FLOAT64 )
+         n = f;
+      else if( k == 0 && type == SI2DR_INT32 )
+         n = i;
+      else if( k == 1 && type == SI2DR_STRING && liberty_parse_unit(s, "f") > 0.0 )
+         *unit = liberty_parse_unit(s, "f");
+   }
+   si2drIterQuit(vals, &err);
+   return n * *unit;
+}
+
+void liberty_read_units(si2drGroupIdT library, struct liberty_units *u)
+{
+   si2drAttrIdT attr;
+   si2drStringT s;
+   double unit;
+
+   /* the usual defaults, for a library that leaves a unit out */
+   u->time = 1e-9;
+   u->voltage = 1.0;
+   u->current = 1e-3;
+   u->power = 1e-6;
+   u->resistance = 1e3;
+   if( (s = unit_string_attr(library, "time_unit", &attr)) && liberty_parse_unit(s, "s") > 0.0 )
+      u->time = liberty_parse_unit(s, "s");
+   if( (s = unit_string_attr(library, "voltage_unit", &attr)) && liberty_parse_unit(s, "V") > 0.0 )
+      u->voltage = liberty_parse_unit(s, "V");
+   if( (s = unit_string_attr(library, "current_unit", &attr)) && liberty_parse_unit(s, "A") > 0.0 )
+      u->current = liberty_parse_unit(s, "A");
+   if( (s = unit_string_attr(library, "leakage_power_unit", &attr)) && liberty_parse_unit(s, "W") > 0.0 )
+      u->power = liberty_parse_unit(s, "W");
+   if( (s = unit_string_attr(library, "pulling_resistance_unit", &attr)) && liberty_parse_unit(s, "ohm") > 0.0 )
+      u->resistance = liberty_parse_unit(s, "ohm");
+   u->capacitance = unit_capacitance(library, &unit);
+}
+
+static int unit_of_variable(const char *var)
+{
+   static const struct { const char *name; int quantity; } variables[] =
+   {
+      {"input_net_transition", UNIT_TIME}, {"constrained_pin_transition", UNIT_TIME},
+      {"related_pin_transition", UNIT_TIME}, {"input_transition_time", UNIT_TIME},
+      {"output_pin_transition", UNIT_TIME}, {"connect_delay", UNIT_TIME},
+      {"time", UNIT_TIME}, {"input_noise_width", UNIT_TIME}, {"rc_product", UNIT_TIME},
+      {"total_output_net_capacitance", UNIT_CAPACITANCE}, {"output_net_wire_cap", UNIT_CAPACITANCE},
+      {"output_net_pin_cap", UNIT_CAPACITANCE}, {"related_out_total_output_net_capacitance", UNIT_CAPACITANCE},
+      {"equal_or_opposite_output_net_capacitance", UNIT_CAPACITANCE},
+      {"input_voltage", UNIT_VOLTAGE}, {"output_voltage", UNIT_VOLTAGE}, {"input_noise_height", UNIT_VOLTAGE},
+      {"iv_output_voltage", UNIT_VOLTAGE}
+   };
+   size_t i;
+
+   for(i=0; i<sizeof(variables)/sizeof(variables[0]); i++)
+   {
+      if( !strcmp(var, variables[i].name) )
+         return variables[i].quantity;
+   }
+   return UNIT_NONE;
+}
+
+/* the quantity of the values of a table group, or UNIT_NONE. A vector
+   holds what the group around it does: voltages in output_voltage_rise and
+   _fall and in propagated_noise_high and _low, currents elsewhere. */
+static int unit_of_table(si2drGroupIdT group, group_enum type)
+{
+   si2drErrorT err;
+
+   switch( type )
+   {
+      case LIBERTY_GROUPENUM_cell_rise:
+      case LIBERTY_GROUPENUM_cell_fall:
+      case LIBERTY_GROUPENUM_rise_transition:
+      case LIBERTY_GROUPENUM_fall_transition:
+      case LIBERTY_GROUPENUM_rise_constraint:
+      case LIBERTY_GROUPENUM_fall_constraint:
+      case LIBERTY_GROUPENUM_rise_propagation:
+      case LIBERTY_GROUPENUM_fall_propagation:
+      case LIBERTY_GROUPENUM_retaining_rise:
+      case LIBERTY_GROUPENUM_retaining_fall:
+      case LIBERTY_GROUPENUM_retain_rise_slew:
+      case LIBERTY_GROUPENUM_retain_fall_slew:
+      case LIBERTY_GROUPENUM_cell_degradation:
+      case LIBERTY_GROUPENUM_normalized_driver_waveform:
+      case LIBERTY_GROUPENUM_propagated_noise_width_high:
+      case LIBERTY_GROUPENUM_propagated_noise_width_low:
+      case LIBERTY_GROUPENUM_propagated_noise_width_above_high:
+      case LIBERTY_GROUPENUM_propagated_noise_width_below_low:
+         return UNIT_TIME;
+      case LIBERTY_GROUPENUM_receiver_capacitance1_rise:
+      case LIBERTY_GROUPENUM_receiver_capacitance1_fall:
+      case LIBERTY_GROUPENUM_receiver_capacitance2_rise:
+      case LIBERTY_GROUPENUM_receiver_capacitance2_fall:
+         return UNIT_CAPACITANCE;
+      case LIBERTY_GROUPENUM_rise_power:
+      case LIBERTY_GROUPENUM_fall_power:
+      case LIBERTY_GROUPENUM_power:
+         return UNIT_ENERGY;
+      case LIBERTY_GROUPENUM_propagated_noise_height_high:
+      case LIBERTY_GROUPENUM_propagated_noise_height_low:
+      case LIBERTY_GROUPENUM_propagated_noise_height_above_high:
+      case LIBERTY_GROUPENUM_propagated_noise_height_below_low:
+      case LIBERTY_GROUPENUM_noise_immunity_high:
+      case LIBERTY_GROUPENUM_noise_immunity_low:
+      case LIBERTY_GROUPENUM_noise_immunity_above_high:
+      case LIBERTY_GROUPENUM_noise_immunity_below_low:
+         return UNIT_VOLTAGE;
+      case LIBERTY_GROUPENUM_vector:
+         switch( si2drGroupGetID(si2drObjectGetOwner(group, &err), &err) )
+         {
+            case LIBERTY_GROUPENUM_output_voltage_rise:
+            case LIBERTY_GROUPENUM_output_voltage_fall:
+            case LIBERTY_GROUPENUM_propagated_noise_high:
+            case LIBERTY_GROUPENUM_propagated_noise_low:
+               return UNIT_VOLTAGE;
+            default:
+               return UNIT_CURRENT;
+         }
+      case LIBERTY_GROUPENUM_steady_state_current_high:
+      case LIBERTY_GROUPENUM_steady_state_current_low:
+      case LIBERTY_GROUPENUM_steady_state_current_tristate:
+         return UNIT_CURRENT;
+      default:
+         return UNIT_NONE;
+   }
+}
+
+/* the quantity of a simple attribute, or of a complex one that is not a
+   table's index or values */
+static int unit_of_attr(attr_enum attr, group_enum group)
+{
+   switch( attr )
+   {
+      case LIBERTY_ATTRENUM_max_transition:
+      case LIBERTY_ATTRENUM_min_transition:
+      case LIBERTY_ATTRENUM_default_max_transition:
+      case LIBERTY_ATTRENUM_reference_time:
+      case LIBERTY_ATTRENUM_min_pulse_width_high:
+      case LIBERTY_ATTRENUM_min_pulse_width_low:
+      case LIBERTY_ATTRENUM_min_period:
+         return UNIT_TIME;
+      case LIBERTY_ATTRENUM_capacitance:
+      case LIBERTY_ATTRENUM_rise_capacitance:
+      case LIBERTY_ATTRENUM_fall_capacitance:
+      case LIBERTY_ATTRENUM_max_capacitance:
+      case LIBERTY_ATTRENUM_min_capacitance:
+      case LIBERTY_ATTRENUM_default_max_capacitance:
+      case LIBERTY_ATTRENUM_default_inout_pin_cap:
+      case LIBERTY_ATTRENUM_default_input_pin_cap:
+      case LIBERTY_ATTRENUM_default_output_pin_cap:
+      case LIBERTY_ATTRENUM_rise_capacitance_range:
+      case LIBERTY_ATTRENUM_fall_capacitance_range:
+         return UNIT_CAPACITANCE;
+      case LIBERTY_ATTRENUM_voltage:
+      case LIBERTY_ATTRENUM_nom_voltage:
+      case LIBERTY_ATTRENUM_vil:
+      case LIBERTY_ATTRENUM_vih:
+      case LIBERTY_ATTRENUM_vimin:
+      case LIBERTY_ATTRENUM_vimax:
+      case LIBERTY_ATTRENUM_vol:
+      case LIBERTY_ATTRENUM_voh:
+      case LIBERTY_ATTRENUM_vomin:
+      case LIBERTY_ATTRENUM_vomax:
+      case LIBERTY_ATTRENUM_voltage_map:
+         return UNIT_VOLTAGE;
+      case LIBERTY_ATTRENUM_cell_leakage_power:
+      case LIBERTY_ATTRENUM_default_cell_leakage_power:
+         return UNIT_POWER;
+      case LIBERTY_ATTRENUM_value:
+         return group == LIBERTY_GROUPENUM_leakage_power ? UNIT_POWER : UNIT_NONE;
+      case LIBERTY_ATTRENUM_pulling_resistance:
+         return UNIT_RESISTANCE;
+      default:
+         return UNIT_NONE;
+   }
+}
+
+static int unit_is_template(si2drGroupIdT group)
+{
+   si2drErrorT err;
+   const char *type = si2drGroupGetGroupType(group, &err);
+   size_t n = strlen(type);
+
+   return n > 9 && !strcmp(type + n - 9, "_template");
+}
+
+static void unit_add_template(unit_sweep *sw, si2drGroupIdT group)
+{
+   si2drErrorT err;
+   si2drNamesIdT names = si2drGroupGetNames(group, &err);
+   si2drStringT name = si2drIterNextName(names, &err);
+   si2drAttrIdT var;
+   unit_template *t;
+   char attr[16];
+   int d;
+
+   si2drIterQuit(names, &err);
+   if( !name )
+      return;
+   if( (sw->ntemplates & (sw->ntemplates-1)) == 0 )
+      sw->templates = (unit_template*)realloc(sw->templates, (sw->ntemplates ? sw->ntemplates*2 : 1)*sizeof(unit_template));
+   t = &sw->templates[sw->ntemplates++];
+   t->type = si2drGroupGetGroupType(group, &err);
+   t->name = name;
+   for(d=0; d<7; d++)
+   {
+      sprintf(attr, "variable_%d", d+1);
+      var = si2drGroupFindAttrByName(group, attr, &err);
+      t->variable[d] = UNIT_NONE;
+      if( !si2drObjectIsNull(var, &err) && si2drAttrGetAttrType(var, &err) == SI2DR_SIMPLE
+          && si2drSimpleAttrGetValueType(var, &err) == SI2DR_STRING )
+         t->variable[d] = unit_of_variable(si2drSimpleAttrGetStringValue(var, &err));
+   }
+}
+
+/* the template of a table: a power table's is a power_lut_template, a
+   vector's an output_current_template or pg_current_template, and any
+   other's preferably an lu_table_template. A template finds itself. */
+static unit_template *unit_find_template(unit_sweep *sw, si2drGroupIdT table, int values)
+{
+   si2drErrorT err;
+   const char *own = unit_is_template(table) ? si2drGroupGetGroupType(table, &err) : NULL;
+   si2drNamesIdT names = si2drGroupGetNames(table, &err);
+   si2drStringT name = si2drIterNextName(names, &err);
+   unit_template *found = NULL;
+   int i, rank, best = 0;
+
+   si2drIterQuit(names, &err);
+   if( !name )
+      return NULL;
+   for(i=0; i<sw->ntemplates; i++)
+   {
+      if( strcmp(sw->templates[i].name, name) )
+         continue;
+      if( own )
+         rank = !strcmp(sw->templates[i].type, own) ? 3 : 0;
+      else if( values == UNIT_ENERGY )
+         rank = !strcmp(sw->templates[i].type, "power_lut_template") ? 3 : 1;
+      else if( values == UNIT_CURRENT )
+         rank = strstr(sw->templates[i].type, "current_template") ? 3 : 1;
+      else
+         rank = !strcmp(sw->templates[i].type, "lu_table_template") ? 3 : 2;
+      if( rank > best )
+      {
+         best = rank;
+         found = &sw->templates[i];
+      }
+   }
+   return found;
+}
+
+static void unit_add_attr(unit_sweep *sw, si2drAttrIdT attr, int quantity)
+{
+   if( sw->factor[quantity] == 1.0 )
+      return;
+   if( sw->nattrs == sw->cap )
+   {
+      sw->cap = sw->cap ? sw->cap*2 : 1024;
+      sw->attrs = (si2drAttrIdT*)realloc(sw->attrs, sw->cap*sizeof(si2drAttrIdT));
+      sw->quantity = (int*)realloc(sw->quantity, sw->cap*sizeof(int));
+   }
+   sw->attrs[sw->nattrs] = attr;
+   sw->quantity[sw->nattrs++] = quantity;
+}
+
+/* d for an index_<d+1> attribute, otherwise -1 */
+static int unit_index_dimension(const char *name)
+{
+   if( strncmp(name, "index_", 6) || name[6] < '1' || name[6] > '7' || name[7] )
+      return -1;
+   return name[6] - '1';
+}
+
+/* scales the simple attributes at once and queues the complex ones */
+static long unit_collect(unit_sweep *sw, si2drGroupIdT group)
+{
+   si2drErrorT err;
+   group_enum type = si2drGroupGetID(group, &err);
+   int values = unit_of_table(group, type), quantity, d;
+   unit_template *tmpl = NULL;
+   si2drAttrsIdT attrs;
+   si2drAttrIdT attr;
+   si2drGroupsIdT groups;
+   si2drGroupIdT sub;
+   attr_enum id;
+   long scaled = 0;
+
+   if( values != UNIT_NONE || unit_is_template(group) )
+      tmpl = unit_find_template(sw, group, values);
+   attrs = si2drGroupGetAttrs(group, &err);
+   while( !si2drObjectIsNull((attr = si2drIterNextAttr(attrs, &err)), &err) )
+   {
+      id = si2drAttrGetID(attr, &err);
+      quantity = unit_of_attr(id, type);
+      if( id == LIBERTY_ATTRENUM_values && !unit_is_template(group) )
+         quantity = values;
+      else if( (d = unit_index_dimension(si2drAttrGetName(attr, &err))) >= 0 )
+         quantity = tmpl ? tmpl->variable[d] : UNIT_NONE;
+      if( quantity == UNIT_NONE || sw->factor[quantity] == 1.0 )
+         continue;
+      if( si2drAttrGetAttrType(attr, &err) == SI2DR_COMPLEX )
+         unit_add_attr(sw, attr, quantity);
+      else if( si2drSimpleAttrGetValueType(attr, &err) == SI2DR_FLOAT64 )
+      {
+         si2drSimpleAttrSetFloat64Value(attr, si2drSimpleAttrGetFloat64Value(attr, &err) * sw->factor[quantity], &err);
+         scaled++;
+      }
+      else if( si2drSimpleAttrGetValueType(attr, &err) == SI2DR_INT32 )
+      {
+         si2drSimpleAttrSetFloat64Value(attr, si2drSimpleAttrGetInt32Value(attr, &err) * sw->factor[quantity], &err);
+         scaled++;
+      }
+   }
+   si2drIterQuit(attrs, &err);
+
+   groups = si2drGroupGetGroups(group, &err);
+   while( !si2drObjectIsNull((sub = si2drIterNextGroup(groups, &err)), &err) )
+      scaled += unit_collect(sw, sub);
+   si2drIterQuit(groups, &err);
+   return scaled;
+}
+
+/* the unit attributes say what the targets are */
+static void unit_rewrite_units(si2drGroupIdT library, const struct liberty_units *target, double capacitance_unit)
+{
+   static const struct { const char *attr; const char *base; int quantity; } units[] =
+   {
+      {"time_unit", "s", UNIT_TIME}, {"voltage_unit", "V", UNIT_VOLTAGE}, {"current_unit", "A", UNIT_CURRENT},
+      {"leakage_power_unit", "W", UNIT_POWER}, {"pulling_resistance_unit", "ohm", UNIT_RESISTANCE}
+   };
+   const double si[UNIT_QUANTITIES] =
+   {
+      0.0, target->time, target->capacitance, target->voltage, target->current, target->power, target->resistance, 0.0
+   };
+   si2drErrorT err;
+   si2drAttrIdT attr;
+   char text[64];
+   double n;
+   size_t i;
+
+   for(i=0; i<sizeof(units)/sizeof(units[0]); i++)
+   {
+      if( !unit_string_attr(library, units[i].attr, &attr) )
+         continue;
+      unit_text(si[units[i].quantity], units[i].base, text, sizeof(text));
+      si2drSimpleAttrSetStringValue(attr, text, &err);
+   }
+   /* capacitive_load_unit keeps its pf or ff */
+   attr = si2drGroupFindAttrByName(library, "capacitive_load_unit", &err);
+   if( !si2drObjectIsNull(attr, &err) && si2drAttrGetAttrType(attr, &err) == SI2DR_COMPLEX )
+   {
+      const struct liberty_decoded_numbers *dn = liberty_get_decoded_numbers(attr);
+
+      if( dn && dn->starts[dn->nvalues] == 1 )
+      {
+         n = target->capacitance / capacitance_unit;
+         liberty_set_decoded_numbers(attr, &n);
+      }
+   }
+}
+
+/* from/to, rounded to 15 digits so that 1e-9/1e-12 comes out as 1000 */
+static double unit_factor(double from, double to)
+{
+   char buf[32];
+
+   snprintf(buf, sizeof(buf), "%.15g", from / to);
+   return strtod(buf, 0);
+}
+
+long liberty_normalize_units(si2drGroupIdT library, const struct liberty_units *target, struct liberty_units *factors)
+{
+   si2drErrorT err;
+   struct liberty_units from;
+   unit_sweep sw;
+   si2drGroupsIdT groups;
+   si2drGroupIdT sub;
+   const struct liberty_decoded_numbers *dn;
+   double *nums, capacitance_unit, f;
+   long *first, total = 0, scaled, i, k, end;
+
+   liberty_read_units(library, &from);
+   unit_capacitance(library, &capacitance_unit);
+   memset(&sw, 0, sizeof(sw));
+   sw.factor[UNIT_NONE] = 1.0;
+   sw.factor[UNIT_TIME] = factors->time = unit_factor(from.time, target->time);
+   sw.factor[UNIT_CAPACITANCE] = factors->capacitance = unit_factor(from.capacitance, target->capacitance);
+   sw.factor[UNIT_VOLTAGE] = factors->voltage = unit_factor(from.voltage, target->voltage);
+   sw.factor[UNIT_CURRENT] = factors->current = unit_factor(from.current, target->current);
+   sw.factor[UNIT_POWER] = factors->power = unit_factor(from.power, target->power);
+   sw.factor[UNIT_RESISTANCE] = factors->resistance = unit_factor(from.resistance, target->resistance);
+   sw.factor[UNIT_ENERGY] = sw.factor[UNIT_CAPACITANCE] * sw.factor[UNIT_VOLTAGE] * sw.factor[UNIT_VOLTAGE];
+
+   groups = si2drGroupGetGroups(library, &err);
+   while( !si2drObjectIsNull((sub = si2drIterNextGroup(groups, &err)), &err) )
+   {
+      if( unit_is_template(sub) )
+         unit_add_template(&sw, sub);
+   }
+   si2drIterQuit(groups, &err);
+   scaled = unit_collect(&sw, library);
+
+   /* the numbers of the queued attributes, back to back */
+   first = (long*)malloc((sw.nattrs+1)*sizeof(long));
+   for(i=0; i<sw.nattrs; i++)
+   {
+      dn = liberty_get_decoded_numbers(sw.attrs[i]);
+      first[i] = total;
+      total += dn ? dn->starts[dn->nvalues] : 0;
+   }
+   first[sw.nattrs] = total;
+   nums = (double*)malloc((total > 0 ? total : 1)*sizeof(double));
+   for(i=0; i<sw.nattrs; i++)
+   {
+      dn = liberty_get_decoded_numbers(sw.attrs[i]);
+      if( dn )
+         memcpy(nums + first[i], dn->nums, (first[i+1] - first[i])*sizeof(double));
+   }
+   for(i=0; i<sw.nattrs; i++)
+   {
+      f = sw.factor[sw.quantity[i]];
+      end = first[i+1];
+      for(k=first[i]; k<end; k++)
+         nums[k] *= f;
+   }
+   for(i=0; i<sw.nattrs; i++)
+   {
+      if( first[i+1] > first[i] )
+         liberty_set_decoded_numbers(sw.attrs[i], nums + first[i]);
+   }
+   unit_rewrite_units(library, target, capacitance_unit);
+
+   free(nums);
+   free(first);
+   free(sw.attrs);
+   free(sw.quantity);
+   free(sw.templates);
+   return scaled + total;
+}
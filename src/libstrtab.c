@@ -97,23 +97,14 @@ void liberty_strtable_resize_strtable(liberty_strtable *ht, int new_size)
 	/* there isn't anything to do about the string space */
 }
 
-char *liberty_strtable_enter_string(liberty_strtable *ht, char *str)
+/* SILIMATE: copy str into the table's chunks without entering it in the
+   hash, for text that is not worth sharing (rewritten attribute values).
+   It lives as long as the table. */
+char *liberty_strtable_store_string(liberty_strtable *ht, char *str)
 {
-	si2drObjectIdT t,ores;
-	char *result, *strptr;
+	char *strptr;
 	int slen = strlen(str);
 	
-	total_enter_calls++;
-	
-	/* first, check the table for the string */
-
-	liberty_hash_lookup(ht->hashtab, str, &ores );
-	
-	if( ores.v1 != 0 )
-		return ores.v1;
-
-	/* first, add the string to the table */
-
 	if( ht->chunklist->strtab_used + slen +1 > ht->chunklist->strtab_allocated )
 	{
 		/* this string won't fit in the current chunk. realloc isn't an option, all the string pointers would
@@ -133,6 +124,26 @@ char *liberty_strtable_enter_string(liberty_strtable *ht, char *str)
 	total_strings_entered++;
 	total_bytes_entered += slen +1;
 	ht->chunklist->strtab_used += slen +1;
+	return strptr;
+}
+
+char *liberty_strtable_enter_string(liberty_strtable *ht, char *str)
+{
+	si2drObjectIdT t,ores;
+	char *strptr;
+	
+	total_enter_calls++;
+	
+	/* first, check the table for the string */
+
+	liberty_hash_lookup(ht->hashtab, str, &ores );
+	
+	if( ores.v1 != 0 )
+		return ores.v1;
+
+	/* first, add the string to the table */
+
+	strptr = liberty_strtable_store_string(ht, str);
 
 	t.v1 = strptr;
 	t.v2 = 0;
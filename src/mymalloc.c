@@ -19,10 +19,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdatomic.h>
 #include "mymalloc.h"
 
-static int my_malloc_totals = 0;
-static int  calls_calloc = 0, calls_malloc = 0;
+/* SILIMATE: atomic, since allocations can come from several threads */
+static atomic_int my_malloc_totals = 0;
+static atomic_int  calls_calloc = 0, calls_malloc = 0;
 
 #ifdef EXPERIMENTAL
 
@@ -88,8 +90,8 @@ void *my_malloc(int size)
 				 
 	return my_get_mem(size2);
 #endif
-	calls_malloc++;
-	my_malloc_totals +=	size;
+	atomic_fetch_add_explicit(&calls_malloc, 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(&my_malloc_totals, size, memory_order_relaxed);
 	ret = (void*)malloc(size);
 	if( !ret )
 	{
@@ -114,8 +116,8 @@ void *my_calloc(int size, int numels)
 	
 	return my_get_mem(size2);
 #endif
-	calls_calloc++;
-	my_malloc_totals +=	size*numels;
+	atomic_fetch_add_explicit(&calls_calloc, 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(&my_malloc_totals, size*numels, memory_order_relaxed);
 	ret = (void*)calloc(size, numels);
 	if( !ret )
 	{
@@ -142,5 +144,5 @@ void *my_free_all(void)
 void my_malloc_print_totals(void)
 {
 	printf("Totals:\n Calls to malloc = %d\n Calls to calloc = %d\n\n",
-		   calls_malloc, calls_calloc);
+		   atomic_load(&calls_malloc), atomic_load(&calls_calloc));
 }
@@ -21,6 +21,12 @@
 #include "string.h"
 #include <stdlib.h>
 #include <math.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
 #ifdef DMALLOC
 #include <dmalloc.h>
 #endif
@@ -31,9 +37,87 @@
 struct libGroupMap { char *name; group_enum type; };
 struct libAttrMap { char *name; attr_enum type; };
 
-static int errcount;
+static _Thread_local int errcount; /* SILIMATE: per thread, summed by check_library_children */
 static void check_group_correspondence( si2drGroupIdT g, libsynt_group_info *gi );
 static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info *ai );
+static si2drGroupIdT template_index_lib; /* the library being checked */
+static si2drGroupIdT find_template(char *name, char *type);
+static void clear_template_index(void);
+
+/* SILIMATE: the check routines, each with its category; a routine whose
+   category is turned off is not called. With a check profile requested,
+   each call is timed; times are inclusive of the routines they call */
+#define CHECK_ROUTINE_LIST \
+	X(check_attr_correspondence,          SI2DR_CHECK_ATTRIBUTES) \
+	X(attribute_specific_checks,          SI2DR_CHECK_ATTRIBUTES) \
+	X(check_lu_table_template_arraysize,  SI2DR_CHECK_TABLES) \
+	X(check_power_lut_template_arraysize, SI2DR_CHECK_TABLES) \
+	X(check_lut_template,                 SI2DR_CHECK_TABLES) \
+	X(check_output_current_template,      SI2DR_CHECK_TABLES) \
+	X(check_cell_n_prop,                  SI2DR_CHECK_TIMING) \
+	X(check_clear_n_preset,               SI2DR_CHECK_SEQUENTIAL) \
+	X(check_ff_bank_widths,               SI2DR_CHECK_SEQUENTIAL) \
+	X(check_next_state_formula,           SI2DR_CHECK_SEQUENTIAL) \
+	X(check_members,                      SI2DR_CHECK_BUSES) \
+	X(check_bus_pin_directions,           SI2DR_CHECK_BUSES) \
+	X(check_bus_type,                     SI2DR_CHECK_BUSES) \
+	X(check_driver_types,                 SI2DR_CHECK_PINS) \
+	X(check_interface_timing,             SI2DR_CHECK_PINS) \
+	X(check_retention_cell,               SI2DR_CHECK_POWER) \
+	X(check_retention_pin,                SI2DR_CHECK_POWER) \
+	X(check_level_shift,                  SI2DR_CHECK_POWER) \
+	X(check_vector,                       SI2DR_CHECK_CCS) \
+	X(check_ref_times,                    SI2DR_CHECK_CCS) \
+	X(check_ccs_density,                  SI2DR_CHECK_CCS)
+
+enum check_routine_id
+{
+#define X(fn, category) CHECK_ROUTINE_##fn,
+	CHECK_ROUTINE_LIST
+#undef X
+	CHECK_ROUTINE_COUNT
+};
+
+static const int check_routine_category[CHECK_ROUTINE_COUNT] =
+{
+#define X(fn, category) category,
+	CHECK_ROUTINE_LIST
+#undef X
+};
+
+static int check_categories = SI2DR_CHECK_ALL; /* these are set for the duration of a syntax_check */
+static int check_max_errors;
+static double check_cell_budget; /* seconds */
+static int check_profiling;
+static void check_profile_record(enum check_routine_id id, void *group, struct timespec *start);
+static double check_profile_since(struct timespec *start);
+static void check_profile_start(void);
+static void check_profile_finish(double seconds);
+static int check_stop(void);
+static _Thread_local int check_errors; /* ERROR messages so far, for the error limit */
+static si2drMessageHandlerT check_real_printer;
+static si2drVoidT check_buffer_printer(si2drSeverityT sev, si2drErrorT errToPrint, si2drStringT auxText, si2drErrorT *err);
+static int check_defer(si2drSeverityT sev, si2drErrorT code, const char *fmt, va_list ap);
+/* SILIMATE: check_defer reads the arguments by the types in the format, so
+   let the compiler hold every call to them */
+#ifdef __GNUC__
+static void check_report(si2drSeverityT sev, si2drErrorT code, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+#endif
+
+#define CHECK_CALL(fn, group, ...) \
+	do { \
+		if( !(check_categories & check_routine_category[CHECK_ROUTINE_##fn]) ) \
+			break; \
+		if( check_profiling ) \
+		{ \
+			struct timespec t0_; \
+			clock_gettime(CLOCK_MONOTONIC, &t0_); \
+			fn(__VA_ARGS__); \
+			check_profile_record(CHECK_ROUTINE_##fn, (group).v2, &t0_); \
+		} \
+		else \
+			fn(__VA_ARGS__); \
+	} while(0)
 
 const struct libGroupMap *
 lookup_group_name (register const char *str, register unsigned int len);
@@ -42,6 +126,7 @@ const struct libAttrMap *
 lookup_attr_name (register const char *str, register unsigned int len);
 void create_floating_define_for_cell_area(si2drStringT string);
 extern group_enum si2drGroupGetID(si2drGroupIdT group, si2drErrorT *err);
+extern attr_enum si2drAttrGetID(si2drAttrIdT attr, si2drErrorT *err);
 int num_get_precision(char *numstr);
 si2drErrorT syntax_check(si2drGroupIdT lib);
 si2drStringT get_first_group_name(si2drGroupIdT group);
@@ -50,9 +135,31 @@ void check_ccs_density( si2drGroupIdT group );
 
 si2drMessageHandlerT MsgPrinter;
 
-static char EB[SI2DR_MAX_STRING_LEN]; /* just so I don't have to declare buffers all over the place,
+static _Thread_local char EB[SI2DR_MAX_STRING_LEN]; /* just so I don't have to declare buffers all over the place,
                                          to prepare output for output error messages */
 
+static si2drSeverityT check_min_severity = SI2DR_SEVERITY_NOTE;
+
+/* SILIMATE: messages below check_min_severity are dropped before they are
+   formatted. While cells are checked, the others are kept as their format
+   and arguments (check_defer) and formatted only when they are printed or
+   cached. */
+static void check_report(si2drSeverityT sev, si2drErrorT code, const char *fmt, ...)
+{
+	si2drErrorT err;
+	va_list ap;
+	
+	if( sev < check_min_severity )
+		return;
+	va_start(ap, fmt);
+	if( !check_defer(sev, code, fmt, ap) )
+	{
+		vsnprintf(EB, sizeof(EB), fmt, ap);
+		(*MsgPrinter)(sev, code, EB, &err);
+	}
+	va_end(ap);
+}
+
 static int isa_formula(char *str)
 {
 	/* a crude approximation at a formula-- the real best solution here would be to
@@ -82,7 +189,7 @@ typedef struct var_list
 		
 } var_list;
 
-static var_list *master_var_list = 0;
+static _Thread_local var_list *master_var_list = 0;
 
 int num_get_precision(char *numstr)
 {
@@ -172,6 +279,74 @@ static void print_var_list(void)
 }
 
 
+/* SILIMATE: every attribute and subgroup the checks verify used to cost a
+   chained-hash string lookup in the syntax description. The parser already
+   tags known names with their attr_enum/group_enum (EVAL), so each group
+   description gets arrays indexed by those; only the names gperf doesn't
+   know (EVAL 0, user defined) still go through the hashes. The arrays are
+   built once, before any check threads start, and only read afterwards. */
+
+static void build_enum_tables(libsynt_group_info *gi)
+{
+	liberty_hash_bucket *hb;
+	const struct libAttrMap *lam;
+	const struct libGroupMap *lgm;
+	int size;
+
+	if( gi->ref )
+		gi = gi->ref;
+	if( gi->enum_tables_built )
+		return;
+	gi->enum_tables_built = 1;
+
+	size = 0;
+	for(hb = gi->attr_hash->all_list; hb; hb = hb->all_next)
+		if( (lam = lookup_attr_name(hb->name, strlen(hb->name))) && (int)lam->type >= size )
+			size = lam->type + 1;
+	gi->attr_by_enum = (libsynt_attribute_info**)calloc(size ? size : 1, sizeof(libsynt_attribute_info*));
+	gi->attr_enum_size = size;
+	for(hb = gi->attr_hash->all_list; hb; hb = hb->all_next)
+		if( (lam = lookup_attr_name(hb->name, strlen(hb->name))) && !gi->attr_by_enum[lam->type] )
+			gi->attr_by_enum[lam->type] = (libsynt_attribute_info*)hb->item.v1;
+
+	size = 0;
+	for(hb = gi->group_hash->all_list; hb; hb = hb->all_next)
+		if( (lgm = lookup_group_name(hb->name, strlen(hb->name))) && (int)lgm->type >= size )
+			size = lgm->type + 1;
+	gi->group_by_enum = (libsynt_group_info**)calloc(size ? size : 1, sizeof(libsynt_group_info*));
+	gi->group_enum_size = size;
+	for(hb = gi->group_hash->all_list; hb; hb = hb->all_next)
+	{
+		if( (lgm = lookup_group_name(hb->name, strlen(hb->name))) && !gi->group_by_enum[lgm->type] )
+			gi->group_by_enum[lgm->type] = (libsynt_group_info*)hb->item.v1;
+		build_enum_tables((libsynt_group_info*)hb->item.v1);
+	}
+}
+
+static libsynt_attribute_info *syntax_attr_info(libsynt_group_info *gi, si2drAttrIdT attr, si2drStringT name)
+{
+	si2drErrorT err;
+	si2drObjectIdT toid;
+	int e = si2drAttrGetID(attr,&err);
+
+	if( e > 0 && gi->enum_tables_built )
+		return e < gi->attr_enum_size ? gi->attr_by_enum[e] : NULL;
+	liberty_hash_lookup(gi->attr_hash, name, &toid);
+	return (libsynt_attribute_info*)toid.v1;
+}
+
+static libsynt_group_info *syntax_group_info(libsynt_group_info *gi, si2drGroupIdT group, si2drStringT type)
+{
+	si2drErrorT err;
+	si2drObjectIdT toid;
+	int e = si2drGroupGetID(group,&err);
+
+	if( e > 0 && gi->enum_tables_built )
+		return e < gi->group_enum_size ? gi->group_by_enum[e] : NULL;
+	liberty_hash_lookup(gi->group_hash, type, &toid);
+	return (libsynt_group_info*)toid.v1;
+}
+
 si2drErrorT syntax_check(si2drGroupIdT lib)
 {
 	extern libsynt_technology libsynt_techs[];
@@ -185,6 +360,7 @@ si2drErrorT syntax_check(si2drGroupIdT lib)
 	si2drFloat64T   float64;
 	si2drStringT    string;
 	si2drExprT     *expr;
+	struct timespec start;
 	si2drBooleanT   bool;
 	int found, first,i, dmln, tcln;
 	char model[SI2DR_MAX_STRING_LEN], tech[SI2DR_MAX_STRING_LEN];
@@ -202,13 +378,12 @@ si2drErrorT syntax_check(si2drGroupIdT lib)
 	   
 	*/
 	MsgPrinter = si2drPIGetMessageHandler(&err); /* the printer is in another file! */
+	check_min_severity = si2drPIGetCheckSeverity(&err);
 
 	gtype = si2drGroupGetGroupType(lib,&err);
 	if ( strcmp(gtype, "library") )
 	{
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-					  "The top level group is not of type 'library'! This error is so foul, so heinous, so serious, \nso major, so fatal, that syntax/semantic checking is terminating!", 
-					  &err);
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "The top level group is not of type 'library'! This error is so foul, so heinous, so serious, \nso major, so fatal, that syntax/semantic checking is terminating!");
 		
 		return SI2DR_SYNTAX_ERROR;
 	}
@@ -224,12 +399,9 @@ si2drErrorT syntax_check(si2drGroupIdT lib)
 		if( atype != SI2DR_COMPLEX )
 		{
 			
-			sprintf(EB,"The technology attribute specified at %s:%d is a simple attribute and should be a complex attribute!", 
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "The technology attribute specified at %s:%d is a simple attribute and should be a complex attribute!", 
 					si2drObjectGetFileName(attr,&err),
 					(int)si2drObjectGetLineNo(attr,&err));
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 			vtype = si2drSimpleAttrGetValueType(attr,&err);
 			switch( vtype )
@@ -243,10 +415,7 @@ si2drErrorT syntax_check(si2drGroupIdT lib)
 			case SI2DR_BOOLEAN:
 			case SI2DR_EXPR:
 				errcount++;
-				sprintf(EB,"Not only is the technology attribute type wrong, so is the value type! It should be a string, but there's a value of some other type here!");
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-							  EB, 
-							  &err);
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "Not only is the technology attribute type wrong, so is the value type! It should be a string, but there's a value of some other type here!");
 				break;
 			default:
 				break;
@@ -269,10 +438,7 @@ si2drErrorT syntax_check(si2drGroupIdT lib)
 						first = 0;
 					else
 					{
-						sprintf(EB,"Found a string argument, but it was not the first and only argument of technology!");
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-									  EB, 
-									  &err);
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "Found a string argument, but it was not the first and only argument of technology!");
 						errcount++;
 					}
 					found = 1;
@@ -281,12 +447,9 @@ si2drErrorT syntax_check(si2drGroupIdT lib)
 				case SI2DR_FLOAT64:
 				case SI2DR_INT32:
 				case SI2DR_BOOLEAN:
-					sprintf(EB,"The technology attribute at %s:%d should only have one string value; More than one, or non-string attributes detected!", 
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "The technology attribute at %s:%d should only have one string value; More than one, or non-string attributes detected!", 
 							si2drObjectGetFileName(attr,&err),
 							(int)si2drObjectGetLineNo(attr,&err));
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 					break;
 				default:
@@ -298,29 +461,20 @@ si2drErrorT syntax_check(si2drGroupIdT lib)
 			
 			if( !found )
 			{
-				sprintf(EB,"The technology attribute at %s:%d should only have one string value; No string value was  detected!", 
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "The technology attribute at %s:%d should only have one string value; No string value was  detected!", 
 						si2drObjectGetFileName(attr,&err),
 						(int)si2drObjectGetLineNo(attr,&err));
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 			}
 			else
 			{
-				sprintf(EB,"The technology %s was specified.", tech);
-				(*MsgPrinter)(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, 
-							  EB, 
-							  &err);
+				check_report(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, "The technology %s was specified.", tech);
 			}
 		}
 	}
 	else
 	{
-		sprintf(EB,"No technology attribute specified in the library; the technology 'cmos' is assumed.");
-		(*MsgPrinter)(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, 
-					  EB, 
-					  &err);
+		check_report(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, "No technology attribute specified in the library; the technology 'cmos' is assumed.");
 		strcpy(tech,"cmos");
 		tcln = -1;
 	}
@@ -335,10 +489,7 @@ si2drErrorT syntax_check(si2drGroupIdT lib)
 		atype = si2drAttrGetAttrType(attr,&err);
 		if( atype != SI2DR_SIMPLE )
 		{
-			sprintf(EB,"The delay_model attribute was not a simple attribute. Ignoring the specification. 'generic_cmos' will be assumed.");
-			(*MsgPrinter)(SI2DR_SEVERITY_WARN, SI2DR_NO_ERROR, 
-						  EB, 
-						  &err);
+			check_report(SI2DR_SEVERITY_WARN, SI2DR_NO_ERROR, "The delay_model attribute was not a simple attribute. Ignoring the specification. 'generic_cmos' will be assumed.");
 			strcpy(model,"generic_cmos");
 			errcount++;
 		}
@@ -349,21 +500,15 @@ si2drErrorT syntax_check(si2drGroupIdT lib)
 			{
 			case SI2DR_STRING:
 				strcpy(model, si2drSimpleAttrGetStringValue(attr,&err));
-				sprintf(EB,"delay_model specified was %s.", model);
-				(*MsgPrinter)(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, 
-							  EB, 
-							  &err);
+				check_report(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, "delay_model specified was %s.", model);
 				break;
 				
 			case SI2DR_FLOAT64:
 			case SI2DR_INT32:
 			case SI2DR_BOOLEAN:
-				sprintf(EB,"The delay_model attribute at %s:%d was not a simple attribute of string type. 'generic_cmos' will be assumed.", 
+				check_report(SI2DR_SEVERITY_WARN, SI2DR_NO_ERROR, "The delay_model attribute at %s:%d was not a simple attribute of string type. 'generic_cmos' will be assumed.", 
 						si2drObjectGetFileName(attr,&err),
 						(int)si2drObjectGetLineNo(attr,&err));
-				(*MsgPrinter)(SI2DR_SEVERITY_WARN, SI2DR_NO_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 				strcpy(model,"generic_cmos");
 				break;
@@ -372,19 +517,13 @@ si2drErrorT syntax_check(si2drGroupIdT lib)
 				if( e->type  == SI2DR_EXPR_VAL && e->valuetype == SI2DR_STRING )
 				{
 					strcpy(model, e->u.s);
-					sprintf(EB,"delay_model specified was %s.", model);
-					(*MsgPrinter)(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, 
-								  EB, 
-								  &err);
+					check_report(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, "delay_model specified was %s.", model);
 				}
 				else
 				{
-					sprintf(EB,"The delay_model attribute at %s:%d was not a simple attribute of string type. 'generic_cmos' will be assumed.", 
+					check_report(SI2DR_SEVERITY_WARN, SI2DR_NO_ERROR, "The delay_model attribute at %s:%d was not a simple attribute of string type. 'generic_cmos' will be assumed.", 
 							si2drObjectGetFileName(attr,&err),
 							(int)si2drObjectGetLineNo(attr,&err));
-					(*MsgPrinter)(SI2DR_SEVERITY_WARN, SI2DR_NO_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 					strcpy(model,"generic_cmos");
 				}
@@ -396,9 +535,7 @@ si2drErrorT syntax_check(si2drGroupIdT lib)
 	}
 	else
 	{
-		(*MsgPrinter)(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, 
-					  "No delay_model attribute specified in the library; the delay_model 'generic_cmos' is assumed.", 
-					  &err);
+		check_report(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, "No delay_model attribute specified in the library; the delay_model 'generic_cmos' is assumed.");
 		strcpy(model,"generic_cmos");
 		dmln = -1;
 	}
@@ -408,11 +545,8 @@ si2drErrorT syntax_check(si2drGroupIdT lib)
 
 	if( dmln > 0 && tcln > 0 && dmln < tcln )
 	{
-		sprintf(EB,"The delay_model should be declared after the technology, but is not. Check lines %s:%d and %s:%d.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "The delay_model should be declared after the technology, but is not. Check lines %s:%d and %s:%d.",
 			   tcfn,tcln, dmfn,dmln);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	
@@ -436,30 +570,38 @@ si2drErrorT syntax_check(si2drGroupIdT lib)
 		}
 	if( !found )
 	{
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR,
-					  "I cannot check the syntax of this particular technology/delay_model combination!", 
-					  &err);
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "I cannot check the syntax of this particular technology/delay_model combination!");
 
-		(*MsgPrinter)(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, 
-					  " Here is a list of technologies/delay_models I can handle:", 
-					  &err);
+		check_report(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, " Here is a list of technologies/delay_models I can handle:");
 		for(i=0;i<libsynt_tech_num ;i++)
 		{
-			sprintf(EB,"  %s", libsynt_techs[i].name);
-			(*MsgPrinter)(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, 
-						  EB, 
-						  &err);
+			check_report(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, "  %s", libsynt_techs[i].name);
 		}
 		return SI2DR_SYNTAX_ERROR;
 	}
 	
-	sprintf(EB,"Using the %s syntax tables...",libsynt_techs[i].name);
-	(*MsgPrinter)(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, 
-				  EB, 
-				  &err);
+	check_report(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, "Using the %s syntax tables...",libsynt_techs[i].name);
 
 	
+	build_enum_tables(libsynt_techs[i].lib);
+	template_index_lib = lib;
+	check_categories = si2drPIGetCheckCategories(&err);
+	check_max_errors = si2drPIGetCheckMaxErrors(&err);
+	check_cell_budget = si2drPIGetCheckCellBudget(&err)*1e-3;
+	check_profile_start();
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	check_real_printer = MsgPrinter;
+	MsgPrinter = check_buffer_printer;
+	si2drPISetMessageHandler(check_buffer_printer, &err); /* debug mode messages from the PI */
+	check_errors = 0;
 	check_group_correspondence(lib, libsynt_techs[i].lib );
+	MsgPrinter = check_real_printer;
+	si2drPISetMessageHandler(check_real_printer, &err);
+	check_profile_finish(check_profile_since(&start));
+	check_categories = SI2DR_CHECK_ALL;
+	check_max_errors = 0;
+	check_cell_budget = 0;
+	clear_template_index();
 	
 	if( errcount > 0 )
 		return SI2DR_SYNTAX_ERROR;
@@ -495,36 +637,27 @@ static void enter_define_cell_area(si2drAttrIdT a)
 	
 	if( vtype == SI2DR_UNDEFINED_VALUETYPE )
 	{
-		sprintf(EB,"%s:%d: The 'define_cell_area' attribute has no values.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d: The 'define_cell_area' attribute has no values.",
 			   si2drObjectGetFileName(a,&err),
 			   (int)si2drObjectGetLineNo(a,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 		return;
 	}
 	
 	if( vtype != SI2DR_STRING )
 	{
-		sprintf(EB,"%s:%d: The 'define_cell_area' attribute should be a string.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d: The 'define_cell_area' attribute should be a string.",
 			   si2drObjectGetFileName(a,&err),
 			   (int)si2drObjectGetLineNo(a,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 		return;
 	}
 	
 	if( !string || !string[0] )
 	{
-		sprintf(EB,"%s:%d: The 'define_cell_area' attribute is an empty string.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d: The 'define_cell_area' attribute is an empty string.",
 			   si2drObjectGetFileName(a,&err),
 			   (int)si2drObjectGetLineNo(a,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 		return;
 	}
@@ -1869,69 +2002,15 @@ static void attribute_specific_checks( si2drAttrIdT a )
 	}
 }
 
-static si2drGroupIdT get_containing_group(si2drGroupIdT group, si2drStringT type)
-{
-	si2drErrorT err;
-	const struct libGroupMap *lgm;
-	si2drGroupIdT gup = group;
-	group_enum gt;
-	lgm = lookup_group_name (type, strlen(type));
-	if( lgm )
-		gt = lgm->type;
-	else
-	{
-		sprintf(EB,"BAD type (%s) handed to get_containing_group!", type);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_INTERNAL_SYSTEM_ERROR, 
-					  EB, 
-					  &err);
-		return si2drPIGetNullId(&err);
-	}
-	
-	while( !si2drObjectIsNull((gup = si2drObjectGetOwner(gup,&err)),&err) )
-	{
-		if( si2drGroupGetID(gup,&err) == gt )
-			return gup;
-	}
-	return si2drPIGetNullId(&err);
-}
-
-static char *mystrtod(char *str, char **end)
-{
-	char *x = str,*y;
-
-	while( *x && (*x == ' ' || *x  == '	' || *x == ',' || *x == '\n' || *x == '\\') )
-	{
-		x++;
-	}
-	y = x;
-	
-	while( *x && (*x == '+' || *x == '-' || (*x >= '0'&& *x <= '9')
-				  || *x == 'E' || *x == 'e' || *x == '.' ))
-	{
-		x++;
-	}
-	if( y == x )
-	{
-		*end = str;
-		return str;
-	}
-	*end = x;
-	return x;
-}
-
-static int count_floats_in_string(char *s)
+/* SILIMATE: how many numbers value k of a complex attribute holds; the
+   database decodes each attribute once for all the checks */
+static int count_floats_in_value(si2drAttrIdT attr, int k)
 {
-	char *p,*t;
-	int i= 0;
+	const struct liberty_decoded_numbers *dn = liberty_get_decoded_numbers(attr);
 	
-	p = s;
-	
-	while( mystrtod(p,&t) != p )
-	{
-		i++;
-		p = t;
-	}
-	return i;
+	if( !dn || k >= dn->nvalues )
+		return 0;
+	return dn->starts[k+1] - dn->starts[k];
 }
 
 static int count_strings_in_list(si2drAttrIdT attr)
@@ -1967,7 +2046,7 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 	si2drErrorT err;
 	si2drNamesIdT names;
 	si2drStringT str;
-	si2drGroupIdT rg,rg2;
+	si2drGroupIdT rg2;
 
 	names = si2drGroupGetNames(group, &err);
 	str = si2drIterNextName(names,&err);
@@ -2002,73 +2081,50 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 
 				if( type == SI2DR_UNDEFINED_VALUETYPE )
 				{
-					sprintf(EB,"%s:%d, %s references template %s, so",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, so",
 						   si2drObjectGetFileName(group, &err),
 						   (int)si2drObjectGetLineNo(group, &err),
 						   si2drGroupGetGroupType(group,&err),
 						   strx);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
-					sprintf(EB,"                  the values attribute should have one string specified\n                  with a number in it, but does not."
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the values attribute should have one string specified\n                  with a number in it, but does not."
 						   );
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 				}
 				if( type != SI2DR_STRING )
 				{
-					sprintf(EB,"%s:%d, %s references template %s, so",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, so",
 						   si2drObjectGetFileName(group, &err),
 						   (int)si2drObjectGetLineNo(group, &err),
 						   si2drGroupGetGroupType(group,&err),
 						   strx);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
-					sprintf(EB,"                  the values attribute should have one string specified\n                  with a number in it, but what is there is not a string."
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the values attribute should have one string specified\n                  with a number in it, but what is there is not a string."
 						   );
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 				}
 				else
 				{
-					numfloats = count_floats_in_string(string);
+					numfloats = count_floats_in_value(vs, 0);
 					if( numfloats != 1 || numstrs != 1 )
 					{
-						sprintf(EB,"%s:%d, %s references template %s, but",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 							   si2drObjectGetFileName(group, &err),
 							   (int)si2drObjectGetLineNo(group, &err),
 							   si2drGroupGetGroupType(group,&err),
 							   strx);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
-						sprintf(EB,"                  the values attribute has more than one value or string specified."
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the values attribute has more than one value or string specified."
 							   );
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 				}
 			}
 			else
 			{
-				sprintf(EB,"%s:%d, %s references template %s, but",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 					   si2drObjectGetFileName(group, &err),
 					   (int)si2drObjectGetLineNo(group, &err),
 					   si2drGroupGetGroupType(group,&err),
 					   strx);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  "                  the group does not have a values attribute.", 
-							  &err);
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the group does not have a values attribute.");
 				errcount++;
 			}
 
@@ -2076,8 +2132,7 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 		}
 		
 		/* find an lu_table_template with this name */
-		rg = get_containing_group(group,"library");
-		rg2 = si2drGroupFindGroupByName(rg,strx, "lu_table_template",&err);
+		rg2 = find_template(strx, "lu_table_template");
 		if( !si2drObjectIsNull(rg2,&err) )
 		{
 			si2drAttrIdT ind1,ind2, ind3;
@@ -2119,7 +2174,7 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 					
 					if( type == SI2DR_STRING )
 					{
-						tpl1nums = count_floats_in_string(string);
+						tpl1nums = count_floats_in_value(ind1, 0);
 						
 						vals = si2drComplexAttrGetValues(ind2,&err);
 						si2drIterNextComplexValue(vals, &type, &intgr, &float64, &string,&bool,&expr,&err);
@@ -2127,7 +2182,7 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 						
 						if( type == SI2DR_STRING )
 						{
-							tpl2nums = count_floats_in_string(string);
+							tpl2nums = count_floats_in_value(ind2, 0);
 
 							
 							vals = si2drComplexAttrGetValues(ind3,&err);
@@ -2137,7 +2192,7 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 							if( type == SI2DR_STRING )
 							{
 								
-								tpl3nums = count_floats_in_string(string);
+								tpl3nums = count_floats_in_value(ind3, 0);
 
 								if( numstrs == tpl1nums * tpl2nums)
 								{
@@ -2150,58 +2205,38 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 										si2drIterNextComplexValue(vals, &type, &intgr, &float64, &string,&bool,&expr,&err);
 										if( type == SI2DR_STRING )
 										{
-											int numc = count_floats_in_string(string);
+											int numc = count_floats_in_value(vs, i);
 											if( numc != tpl3nums )
 											{
-												sprintf(EB,"%s:%d, %s references template %s,",
+												check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 													   si2drObjectGetFileName(group, &err),
 													   (int)si2drObjectGetLineNo(group, &err),
 													   si2drGroupGetGroupType(group,&err),
 													   strx);
-												(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-															  EB, 
-															  &err);
-												sprintf(EB,"                  which says there should be %d strings, each with %d numbers in it in the values table,",
+												check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be %d strings, each with %d numbers in it in the values table,",
 													   tpl1nums*tpl2nums, tpl3nums
 													);
-												
-												(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-															  EB, 
-															  &err);
-												sprintf(EB,"                  but in the group's values attribute (ending at line %d) value #%d has %d numbers.",
+												check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but in the group's values attribute (ending at line %d) value #%d has %d numbers.",
 													   (int)si2drObjectGetLineNo(vs, &err),
 													   i+1, numc
 													);
-												(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-															  EB, 
-															  &err);
 												errcount++;
 											}
 										}
 										else
 										{
-											sprintf(EB,"%s:%d, %s references template %s,",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 												   si2drObjectGetFileName(group, &err),
 												   (int)si2drObjectGetLineNo(group, &err),
 												   si2drGroupGetGroupType(group,&err),
 												   strx);
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
-											sprintf(EB,"                  which says there should be %d strings, each with %d numbers in it in the values table,",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be %d strings, each with %d numbers in it in the values table,",
 												   tpl1nums*tpl2nums, tpl3nums
 												);
-											
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
-											sprintf(EB,"                  but in the group's values attribute (ending at line %d) value #%d is not a string.",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but in the group's values attribute (ending at line %d) value #%d is not a string.",
 												   (int)si2drObjectGetLineNo(vs, &err),
 												   i+1
 												);
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
 											errcount++;
 										}
 									}
@@ -2209,106 +2244,72 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 								}
 								else
 								{
-									sprintf(EB,"%s:%d, %s references template %s,",
+									check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 										   si2drObjectGetFileName(group, &err),
 										   (int)si2drObjectGetLineNo(group, &err),
 										   si2drGroupGetGroupType(group,&err),
 										   strx);
-									(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-												  EB, 
-												  &err);
-									sprintf(EB,"                  which says there should be %d strings, each with %d numbers in it in the values table,",
+									check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be %d strings, each with %d numbers in it in the values table,",
 										   tpl1nums*tpl2nums, tpl3nums
 										);
-									
-									(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-												  EB, 
-												  &err);
-									sprintf(EB,"                  but the group's values attribute (line %d) has %d strings.",
+									check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but the group's values attribute (line %d) has %d strings.",
 										   (int)si2drObjectGetLineNo(vs, &err),
 										   numstrs
 										);
-									(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-												  EB, 
-												  &err);
 									errcount++;
 								}
 							}
 							else
 							{
 								
-								sprintf(EB,"%s:%d, %s references template %s, but",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 									   si2drObjectGetFileName(group, &err),
 									   (int)si2drObjectGetLineNo(group, &err),
 									   si2drGroupGetGroupType(group,&err),
 									   strx);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-											  EB, 
-											  &err);
-								sprintf(EB,"                  the template's index_3 attribute (line %d) does not have a string as a value.",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the template's index_3 attribute (line %d) does not have a string as a value.",
 									   (int)si2drObjectGetLineNo(ind2, &err)
 									   );
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 						}
 						else
 						{
 							
-							sprintf(EB,"%s:%d, %s references template %s, but",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 								   si2drObjectGetFileName(group, &err),
 								   (int)si2drObjectGetLineNo(group, &err),
 								   si2drGroupGetGroupType(group,&err),
 								   strx);
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-										  EB, 
-										  &err);
-							sprintf(EB,"                  the template's index_2 attribute (line %d) does not have a string as a value.",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the template's index_2 attribute (line %d) does not have a string as a value.",
 								   (int)si2drObjectGetLineNo(ind2, &err)
 								   );
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-										  EB, 
-										  &err);
 							errcount++;
 						}
 					}
 					else
 					{
 						
-						sprintf(EB,"%s:%d, %s references template %s, but",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 							   si2drObjectGetFileName(group, &err),
 							   (int)si2drObjectGetLineNo(group, &err),
 							   si2drGroupGetGroupType(group,&err),
 							   strx);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
-						sprintf(EB,"                  the template's index_1 attribute (line %d) does not have a string as a value.",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the template's index_1 attribute (line %d) does not have a string as a value.",
 							   (int)si2drObjectGetLineNo(ind1, &err)
 							);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 				}
 				else
 				{
-					sprintf(EB,"%s:%d, %s references template %s, but",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 						   si2drObjectGetFileName(group, &err),
 						   (int)si2drObjectGetLineNo(group, &err),
 						   si2drGroupGetGroupType(group,&err),
 						   strx);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
-					sprintf(EB,"                  the group does not have a values attribute."
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the group does not have a values attribute."
 						   );
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 				}
 				
@@ -2334,7 +2335,7 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 					
 					if( type == SI2DR_STRING )
 					{
-						tpl1nums = count_floats_in_string(string);
+						tpl1nums = count_floats_in_value(ind1, 0);
 						
 						vals = si2drComplexAttrGetValues(ind2,&err);
 						si2drIterNextComplexValue(vals, &type, &intgr, &float64, &string,&bool,&expr,&err);
@@ -2342,7 +2343,7 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 						
 						if( type == SI2DR_STRING )
 						{
-							tpl2nums = count_floats_in_string(string);
+							tpl2nums = count_floats_in_value(ind2, 0);
 							if( numstrs == tpl1nums )
 							{
 								/* now, count the nums in each entry, and make sure they equal tpl2nums */
@@ -2354,58 +2355,38 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 									si2drIterNextComplexValue(vals, &type, &intgr, &float64, &string,&bool,&expr,&err);
 									if( type == SI2DR_STRING )
 									{
-										int numc = count_floats_in_string(string);
+										int numc = count_floats_in_value(vs, i);
 										if( numc != tpl2nums )
 										{
-											sprintf(EB,"%s:%d, %s references template %s,",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 												   si2drObjectGetFileName(group, &err),
 												   (int)si2drObjectGetLineNo(group, &err),
 												   si2drGroupGetGroupType(group,&err),
 												   strx);
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
-											sprintf(EB,"                  which says there should be %d strings, each with %d numbers in it in the values table,",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be %d strings, each with %d numbers in it in the values table,",
 												   tpl1nums, tpl2nums
 												);
-											
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
-											sprintf(EB,"                  but in the group's values attribute (ending at line %d) value #%d has %d numbers.",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but in the group's values attribute (ending at line %d) value #%d has %d numbers.",
 												   (int)si2drObjectGetLineNo(vs, &err),
 												   i+1, numc
 												);
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
 											errcount++;
 										}
 									}
 									else
 									{
-										sprintf(EB,"%s:%d, %s references template %s,",
+										check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 											   si2drObjectGetFileName(group, &err),
 											   (int)si2drObjectGetLineNo(group, &err),
 											   si2drGroupGetGroupType(group,&err),
 											   strx);
-										(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-													  EB, 
-													  &err);
-										sprintf(EB,"                  which says there should be %d strings, each with %d numbers in it in the values table,",
+										check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be %d strings, each with %d numbers in it in the values table,",
 											   tpl1nums, tpl2nums
 											);
-										
-										(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-													  EB, 
-													  &err);
-										sprintf(EB,"                  but in the group's values attribute (ending at line %d) value #%d is not a string.",
+										check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but in the group's values attribute (ending at line %d) value #%d is not a string.",
 											   (int)si2drObjectGetLineNo(vs, &err),
 											   i+1
 											);
-										(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-													  EB, 
-													  &err);
 										errcount++;
 									}
 								}
@@ -2413,86 +2394,59 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 							}
 							else
 							{
-								sprintf(EB,"%s:%d, %s references template %s,",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 									   si2drObjectGetFileName(group, &err),
 									   (int)si2drObjectGetLineNo(group, &err),
 									   si2drGroupGetGroupType(group,&err),
 									   strx);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-											  EB, 
-											  &err);
-								sprintf(EB,"                  which says there should be %d strings, each with %d numbers in it in the values table,",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be %d strings, each with %d numbers in it in the values table,",
 									   tpl1nums, tpl2nums
 									   );
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-											  EB, 
-											  &err);
 								
-								sprintf(EB,"                  but the group's values attribute (line %d) has %d strings.",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but the group's values attribute (line %d) has %d strings.",
 									   (int)si2drObjectGetLineNo(vs, &err),
 									   numstrs
 									);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 						}
 						else
 						{
 							
-							sprintf(EB,"%s:%d, %s references template %s, but",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 								   si2drObjectGetFileName(group, &err),
 								   (int)si2drObjectGetLineNo(group, &err),
 								   si2drGroupGetGroupType(group,&err),
 								   strx);
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-										  EB, 
-										  &err);
-							sprintf(EB,"                  the template's index_2 attribute (line %d) does not have a string as a value.",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the template's index_2 attribute (line %d) does not have a string as a value.",
 								   (int)si2drObjectGetLineNo(ind2, &err)
 								);
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-										  EB, 
-										  &err);
 							errcount++;
 						}
 					}
 					else
 					{
 						
-						sprintf(EB,"%s:%d, %s references template %s, but",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 							   si2drObjectGetFileName(group, &err),
 							   (int)si2drObjectGetLineNo(group, &err),
 							   si2drGroupGetGroupType(group,&err),
 							   strx);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
-						sprintf(EB,"                  the template's index_1 attribute (line %d) does not have a string as a value.",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the template's index_1 attribute (line %d) does not have a string as a value.",
 							   (int)si2drObjectGetLineNo(ind1, &err)
 							);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 				}
 				else
 				{
-					sprintf(EB,"%s:%d, %s references template %s, but",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 						   si2drObjectGetFileName(group, &err),
 						   (int)si2drObjectGetLineNo(group, &err),
 						   si2drGroupGetGroupType(group,&err),
 						   strx);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
-					sprintf(EB,"                  the group does not have a values attribute."
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the group does not have a values attribute."
 						);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 				}
 			}
@@ -2522,7 +2476,7 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 							if( type == SI2DR_STRING )
 							{
 								int i;
-								tpl1nums = count_floats_in_string(string);
+								tpl1nums = count_floats_in_value(ind1, 0);
 							
 								/* now, count the nums in each entry, and make sure they equal tpl2nums */
 							
@@ -2532,57 +2486,37 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 									si2drIterNextComplexValue(vals, &type, &intgr, &float64, &string,&bool,&expr,&err);
 									if( type == SI2DR_STRING )
 									{
-										int numc = count_floats_in_string(string);
+										int numc = count_floats_in_value(vs, i);
 										if( numc != tpl1nums )
 										{
-											sprintf(EB,"%s:%d, %s references template %s,",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 												   si2drObjectGetFileName(group, &err),
 												   (int)si2drObjectGetLineNo(group, &err),
 												   si2drGroupGetGroupType(group,&err),
 												   strx);
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
-											sprintf(EB,"                  which says there should be 1 string, with %d numbers in it in the values table,",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be 1 string, with %d numbers in it in the values table,",
 												   tpl1nums
 												   );
-											
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
-											sprintf(EB,"                  but in the group's values attribute (ending at line %d) has %d numbers.",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but in the group's values attribute (ending at line %d) has %d numbers.",
 												   (int)si2drObjectGetLineNo(vs, &err),
 												   numc
 												);
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
 											errcount++;
 										}
 									}
 									else
 									{
-										sprintf(EB,"%s:%d, %s references template %s,",
+										check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 											   si2drObjectGetFileName(group, &err),
 											   (int)si2drObjectGetLineNo(group, &err),
 											   si2drGroupGetGroupType(group,&err),
 											   strx);
-										(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-													  EB, 
-													  &err);
-										sprintf(EB,"                  which says there should be 1 string, with %d numbers in it in the values table,",
+										check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be 1 string, with %d numbers in it in the values table,",
 											   tpl1nums
 											);
-										
-										(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-													  EB, 
-													  &err);
-										sprintf(EB,"                  but in the group's values attribute (ending at line %d) is not a string.",
+										check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but in the group's values attribute (ending at line %d) is not a string.",
 											   (int)si2drObjectGetLineNo(vs, &err)
 											);
-										(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-													  EB, 
-													  &err);
 										errcount++;
 									}
 								}
@@ -2591,76 +2525,52 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 							else
 							{
 								
-								sprintf(EB,"%s:%d, %s references template %s, but",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 									   si2drObjectGetFileName(group, &err),
 									   (int)si2drObjectGetLineNo(group, &err),
 									   si2drGroupGetGroupType(group,&err),
 									   strx);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-											  EB, 
-											  &err);
-								sprintf(EB,"                  the template's index_1 attribute (line %d) does not have a string as a value.",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the template's index_1 attribute (line %d) does not have a string as a value.",
 									   (int)si2drObjectGetLineNo(ind1, &err)
 									);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 						}
 						else
 						{
-							sprintf(EB,"%s:%d, %s references template %s, and only index_1 is defined, but",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, and only index_1 is defined, but",
 								   si2drObjectGetFileName(group, &err),
 								   (int)si2drObjectGetLineNo(group, &err),
 								   si2drGroupGetGroupType(group,&err),
 								   strx);
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-										  EB, 
-										  &err);
-							sprintf(EB,"                  the group has more than one value item...."
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the group has more than one value item...."
 								   );
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-										  EB, 
-										  &err);
 							errcount++;
 						}
 					}
 					else
 					{
-						sprintf(EB,"%s:%d, %s references template %s, but",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 							   si2drObjectGetFileName(group, &err),
 							   (int)si2drObjectGetLineNo(group, &err),
 							   si2drGroupGetGroupType(group,&err),
 							   strx);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
-						sprintf(EB,"                  the group does not have a values attribute."
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the group does not have a values attribute."
 							   );
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 				}
 
 				else if( si2drObjectIsNull(ind1,&err) && !si2drObjectIsNull(ind2,&err) )
 				{
-					sprintf(EB,"%s:%d, %s references template %s, and index_2 was defined, but index_1 could not be found",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, and index_2 was defined, but index_1 could not be found",
 						   si2drObjectGetFileName(group, &err),
 						   (int)si2drObjectGetLineNo(group, &err),
 						   si2drGroupGetGroupType(group,&err),
 						   strx);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
-					sprintf(EB,"                 in the group or the template (line %d).",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                 in the group or the template (line %d).",
 						   (int)si2drObjectGetLineNo(rg2, &err)
 						);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 				}
 				/* else ? */
@@ -2670,16 +2580,13 @@ static void check_lu_table_template_arraysize( si2drGroupIdT group)
 		{
 			/* it could be a good 'ol polynomial */
 			
-			rg2 = si2drGroupFindGroupByName(rg,strx, "poly_template",&err);
+			rg2 = find_template(strx, "poly_template");
 			if( si2drObjectIsNull(rg2,&err) )
 			{
-				sprintf(EB,"%s:%d, %s's reference to template %s: the referenced group could not be found",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, %s's reference to template %s: the referenced group could not be found",
 					   si2drObjectGetFileName(group, &err),
 					   (int)si2drObjectGetLineNo(group, &err),
 					   si2drGroupGetGroupType(group,&err), strx);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 			}
 		}
@@ -2691,7 +2598,7 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 	si2drErrorT err;
 	si2drNamesIdT names;
 	si2drStringT str;
-	si2drGroupIdT rg,rg2;
+	si2drGroupIdT rg2;
 
 	names = si2drGroupGetNames(group, &err);
 	str = si2drIterNextName(names,&err);
@@ -2726,75 +2633,51 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 
 				if( type == SI2DR_UNDEFINED_VALUETYPE )
 				{
-					sprintf(EB,"%s:%d, %s references template %s, so",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, so",
 						   si2drObjectGetFileName(group, &err),
 						   (int)si2drObjectGetLineNo(group, &err),
 						   si2drGroupGetGroupType(group,&err),
 						   strx);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
-					sprintf(EB,"                  the values attribute should have one string specified\n                  with a number in it, but does not."
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the values attribute should have one string specified\n                  with a number in it, but does not."
 						   );
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 				}
 				if( type != SI2DR_STRING )
 				{
-					sprintf(EB,"%s:%d, %s references template %s, so",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, so",
 						   si2drObjectGetFileName(group, &err),
 						   (int)si2drObjectGetLineNo(group, &err),
 						   si2drGroupGetGroupType(group,&err),
 						   strx);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
-					sprintf(EB,"                  the values attribute should have one string specified\n                  with a number in it, but what is there is not a string."
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the values attribute should have one string specified\n                  with a number in it, but what is there is not a string."
 						   );
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 				}
 				else
 				{
-					numfloats = count_floats_in_string(string);
+					numfloats = count_floats_in_value(vs, 0);
 					if( numfloats != 1 || numstrs != 1 )
 					{
-						sprintf(EB,"%s:%d, %s references template %s, but",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 							   si2drObjectGetFileName(group, &err),
 							   (int)si2drObjectGetLineNo(group, &err),
 							   si2drGroupGetGroupType(group,&err),
 							   strx);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
-						sprintf(EB,"                  the values attribute has more than one value or string specified."
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the values attribute has more than one value or string specified."
 							   );
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 				}
 			}
 			else
 			{
-				sprintf(EB,"%s:%d, %s references template %s, but",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 					   si2drObjectGetFileName(group, &err),
 					   (int)si2drObjectGetLineNo(group, &err),
 					   si2drGroupGetGroupType(group,&err),
 					   strx);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
-				sprintf(EB,"                  the group does not have a values attribute."
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the group does not have a values attribute."
 					   );
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 			}
 
@@ -2802,8 +2685,7 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 		}
 		
 		/* find an lu_table_template with this name */
-		rg = get_containing_group(group,"library");
-		rg2 = si2drGroupFindGroupByName(rg,strx, "power_lut_template",&err);
+		rg2 = find_template(strx, "power_lut_template");
 		if( !si2drObjectIsNull(rg2,&err) )
 		{
 			si2drAttrIdT ind1,ind2, ind3;
@@ -2845,7 +2727,7 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 					
 					if( type == SI2DR_STRING )
 					{
-						tpl1nums = count_floats_in_string(string);
+						tpl1nums = count_floats_in_value(ind1, 0);
 						
 						vals = si2drComplexAttrGetValues(ind2,&err);
 						si2drIterNextComplexValue(vals, &type, &intgr, &float64, &string, &bool,&expr,&err);
@@ -2853,7 +2735,7 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 						
 						if( type == SI2DR_STRING )
 						{
-							tpl2nums = count_floats_in_string(string);
+							tpl2nums = count_floats_in_value(ind2, 0);
 
 							
 							vals = si2drComplexAttrGetValues(ind3,&err);
@@ -2863,7 +2745,7 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 							if( type == SI2DR_STRING )
 							{
 								
-								tpl3nums = count_floats_in_string(string);
+								tpl3nums = count_floats_in_value(ind3, 0);
 
 								if( numstrs == tpl1nums * tpl2nums)
 								{
@@ -2876,58 +2758,38 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 										si2drIterNextComplexValue(vals, &type, &intgr, &float64, &string,&bool,&expr,&err);
 										if( type == SI2DR_STRING )
 										{
-											int numc = count_floats_in_string(string);
+											int numc = count_floats_in_value(vs, i);
 											if( numc != tpl3nums )
 											{
-												sprintf(EB,"%s:%d, %s references template %s,",
+												check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 													   si2drObjectGetFileName(group, &err),
 													   (int)si2drObjectGetLineNo(group, &err),
 													   si2drGroupGetGroupType(group,&err),
 													   strx);
-												(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-															  EB, 
-															  &err);
-												sprintf(EB,"                  which says there should be %d strings, each with %d numbers in it in the values table,",
+												check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be %d strings, each with %d numbers in it in the values table,",
 													   tpl1nums*tpl2nums, tpl3nums
 													   );
-												
-												(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-															  EB, 
-															  &err);
-												sprintf(EB,"                  but in the group's values attribute (ending at line %d) value #%d has %d numbers.",
+												check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but in the group's values attribute (ending at line %d) value #%d has %d numbers.",
 													   (int)si2drObjectGetLineNo(vs, &err),
 													   i+1, numc
 													   );
-												(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-															  EB, 
-															  &err);
 												errcount++;
 											}
 										}
 										else
 										{
-											sprintf(EB,"%s:%d, %s references template %s,",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 												   si2drObjectGetFileName(group, &err),
 												   (int)si2drObjectGetLineNo(group, &err),
 												   si2drGroupGetGroupType(group,&err),
 												   strx);
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
-											sprintf(EB,"                  which says there should be %d strings, each with %d numbers in it in the values table,",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be %d strings, each with %d numbers in it in the values table,",
 												   tpl1nums*tpl2nums, tpl3nums
 												   );
-											
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
-											sprintf(EB,"                  but in the group's values attribute (ending at line %d) value #%d is not a string.",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but in the group's values attribute (ending at line %d) value #%d is not a string.",
 												   (int)si2drObjectGetLineNo(vs, &err),
 												   i+1
 												   );
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
 											errcount++;
 										}
 									}
@@ -2935,106 +2797,72 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 								}
 								else
 								{
-									sprintf(EB,"%s:%d, %s references template %s,",
+									check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 										   si2drObjectGetFileName(group, &err),
 										   (int)si2drObjectGetLineNo(group, &err),
 										   si2drGroupGetGroupType(group,&err),
 										   strx);
-									(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-												  EB, 
-												  &err);
-									sprintf(EB,"                  which says there should be %d strings, each with %d numbers in it in the values table,",
+									check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be %d strings, each with %d numbers in it in the values table,",
 										   tpl1nums*tpl2nums, tpl3nums
 										);
-									
-									(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-												  EB, 
-												  &err);
-									sprintf(EB,"                  but the group's values attribute (line %d) has %d strings.",
+									check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but the group's values attribute (line %d) has %d strings.",
 										   (int)si2drObjectGetLineNo(vs, &err),
 										   numstrs
 										);
-									(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-												  EB, 
-												  &err);
 									errcount++;
 								}
 							}
 							else
 							{
 								
-								sprintf(EB,"%s:%d, %s references template %s, but",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, %s references template %s, but",
 									   si2drObjectGetFileName(group, &err),
 									   (int)si2drObjectGetLineNo(group, &err),
 									   si2drGroupGetGroupType(group,&err),
 									   strx);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-											  EB, 
-											  &err);
-								sprintf(EB,"                  the template's index_3 attribute (line %d) does not have a string as a value.",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "                  the template's index_3 attribute (line %d) does not have a string as a value.",
 									   (int)si2drObjectGetLineNo(ind2, &err)
 									);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 						}
 						else
 						{
 							
-							sprintf(EB,"%s:%d, %s references template %s, but",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, %s references template %s, but",
 								   si2drObjectGetFileName(group, &err),
 								   (int)si2drObjectGetLineNo(group, &err),
 								   si2drGroupGetGroupType(group,&err),
 								   strx);
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-										  EB, 
-										  &err);
-							sprintf(EB,"                  the template's index_2 attribute (line %d) does not have a string as a value.",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "                  the template's index_2 attribute (line %d) does not have a string as a value.",
 								   (int)si2drObjectGetLineNo(ind2, &err)
 								);
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-										  EB, 
-										  &err);
 							errcount++;
 						}
 					}
 					else
 					{
 						
-						sprintf(EB,"%s:%d, %s references template %s, but",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, %s references template %s, but",
 							   si2drObjectGetFileName(group, &err),
 							   (int)si2drObjectGetLineNo(group, &err),
 							   si2drGroupGetGroupType(group,&err),
 							   strx);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-									  EB, 
-									  &err);
-						sprintf(EB,"                  the template's index_1 attribute (line %d) does not have a string as a value.",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "                  the template's index_1 attribute (line %d) does not have a string as a value.",
 							   (int)si2drObjectGetLineNo(ind1, &err)
 							   );
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 				}
 				else
 				{
-					sprintf(EB,"%s:%d, %s references template %s, but",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, %s references template %s, but",
 						   si2drObjectGetFileName(group, &err),
 						   (int)si2drObjectGetLineNo(group, &err),
 						   si2drGroupGetGroupType(group,&err),
 						   strx);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
-					sprintf(EB,"                  the group does not have a values attribute."
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "                  the group does not have a values attribute."
 						   );
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 				}
 				
@@ -3060,7 +2888,7 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 					
 					if( type == SI2DR_STRING )
 					{
-						tpl1nums = count_floats_in_string(string);
+						tpl1nums = count_floats_in_value(ind1, 0);
 						
 						vals = si2drComplexAttrGetValues(ind2,&err);
 						si2drIterNextComplexValue(vals, &type, &intgr, &float64, &string,&bool,&expr,&err);
@@ -3068,7 +2896,7 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 						
 						if( type == SI2DR_STRING )
 						{
-							tpl2nums = count_floats_in_string(string);
+							tpl2nums = count_floats_in_value(ind2, 0);
 							if( numstrs == tpl1nums )
 							{
 								/* now, count the nums in each entry, and make sure they equal tpl2nums */
@@ -3080,58 +2908,38 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 									si2drIterNextComplexValue(vals, &type, &intgr, &float64, &string,&bool,&expr,&err);
 									if( type == SI2DR_STRING )
 									{
-										int numc = count_floats_in_string(string);
+										int numc = count_floats_in_value(vs, i);
 										if( numc != tpl2nums )
 										{
-											sprintf(EB,"%s:%d, %s references template %s,",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 												   si2drObjectGetFileName(group, &err),
 												   (int)si2drObjectGetLineNo(group, &err),
 												   si2drGroupGetGroupType(group,&err),
 												   strx);
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
-											sprintf(EB,"                  which says there should be %d strings, each with %d numbers in it in the values table,",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be %d strings, each with %d numbers in it in the values table,",
 												   tpl1nums, tpl2nums
 												   );
-											
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
-											sprintf(EB,"                  but in the group's values attribute (ending at line %d) value #%d has %d numbers.",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but in the group's values attribute (ending at line %d) value #%d has %d numbers.",
 												   (int)si2drObjectGetLineNo(vs, &err),
 												   i+1, numc
 												   );
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
 											errcount++;
 										}
 									}
 									else
 									{
-										sprintf(EB,"%s:%d, %s references template %s,",
+										check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 											   si2drObjectGetFileName(group, &err),
 											   (int)si2drObjectGetLineNo(group, &err),
 											   si2drGroupGetGroupType(group,&err),
 											   strx);
-										(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-													  EB, 
-													  &err);
-										sprintf(EB,"                  which says there should be %d strings, each with %d numbers in it in the values table,",
+										check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be %d strings, each with %d numbers in it in the values table,",
 											   tpl1nums, tpl2nums
 											   );
-										
-										(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-													  EB, 
-													  &err);
-										sprintf(EB,"                  but in the group's values attribute (ending at line %d) value #%d is not a string.",
+										check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but in the group's values attribute (ending at line %d) value #%d is not a string.",
 											   (int)si2drObjectGetLineNo(vs, &err),
 											   i+1
 											   );
-										(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-													  EB, 
-													  &err);
 										errcount++;
 									}
 								}
@@ -3139,86 +2947,58 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 							}
 							else
 							{
-								sprintf(EB,"%s:%d, %s references template %s,",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 									   si2drObjectGetFileName(group, &err),
 									   (int)si2drObjectGetLineNo(group, &err),
 									   si2drGroupGetGroupType(group,&err),
 									   strx);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-											  EB, 
-											  &err);
-								sprintf(EB,"                  which says there should be %d strings, each with %d numbers in it in the values table,",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be %d strings, each with %d numbers in it in the values table,",
 									   tpl1nums, tpl2nums
 									   );
-								
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-											  EB, 
-											  &err);
-								sprintf(EB,"                  but the group's values attribute (line %d) has %d strings.",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but the group's values attribute (line %d) has %d strings.",
 									   (int)si2drObjectGetLineNo(vs, &err),
 									   numstrs
 									   );
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 						}
 						else
 						{
 							
-							sprintf(EB,"%s:%d, %s references template %s, but",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, %s references template %s, but",
 								   si2drObjectGetFileName(group, &err),
 								   (int)si2drObjectGetLineNo(group, &err),
 								   si2drGroupGetGroupType(group,&err),
 								   strx);
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-										  EB, 
-										  &err);
-							sprintf(EB,"                  the template's index_2 attribute (line %d) does not have a string as a value.",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "                  the template's index_2 attribute (line %d) does not have a string as a value.",
 								   (int)si2drObjectGetLineNo(ind2, &err)
 								   );
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-										  EB, 
-										  &err);
 							errcount++;
 						}
 					}
 					else
 					{
 						
-						sprintf(EB,"%s:%d, %s references template %s, but",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, %s references template %s, but",
 							   si2drObjectGetFileName(group, &err),
 							   (int)si2drObjectGetLineNo(group, &err),
 							   si2drGroupGetGroupType(group,&err),
 							   strx);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-									  EB, 
-									  &err);
-						sprintf(EB,"                  the template's index_1 attribute (line %d) does not have a string as a value.",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "                  the template's index_1 attribute (line %d) does not have a string as a value.",
 							   (int)si2drObjectGetLineNo(ind1, &err)
 							   );
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 				}
 				else
 				{
-					sprintf(EB,"%s:%d, %s references template %s, but",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 						   si2drObjectGetFileName(group, &err),
 						   (int)si2drObjectGetLineNo(group, &err),
 						   si2drGroupGetGroupType(group,&err),
 						   strx);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
-					sprintf(EB,"                  the group does not have a values attribute."
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the group does not have a values attribute."
 						   );
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 				}
 			}
@@ -3248,7 +3028,7 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 							if( type == SI2DR_STRING )
 							{
 								int i;
-								tpl1nums = count_floats_in_string(string);
+								tpl1nums = count_floats_in_value(ind1, 0);
 							
 								/* now, count the nums in each entry, and make sure they equal tpl2nums */
 							
@@ -3258,57 +3038,37 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 									si2drIterNextComplexValue(vals, &type, &intgr, &float64, &string,&bool,&expr,&err);
 									if( type == SI2DR_STRING )
 									{
-										int numc = count_floats_in_string(string);
+										int numc = count_floats_in_value(vs, i);
 										if( numc != tpl1nums )
 										{
-											sprintf(EB,"%s:%d, %s references template %s,",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 												   si2drObjectGetFileName(group, &err),
 												   (int)si2drObjectGetLineNo(group, &err),
 												   si2drGroupGetGroupType(group,&err),
 												   strx);
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
-											sprintf(EB,"                  which says there should be 1 string, with %d numbers in it in the values table,",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be 1 string, with %d numbers in it in the values table,",
 												   tpl1nums
 												   );
-											
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
-											sprintf(EB,"                  but in the group's values attribute (ending at line %d) has %d numbers.",
+											check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but in the group's values attribute (ending at line %d) has %d numbers.",
 												   (int)si2drObjectGetLineNo(vs, &err),
 												   numc
 												   );
-											(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-														  EB, 
-														  &err);
 											errcount++;
 										}
 									}
 									else
 									{
-										sprintf(EB,"%s:%d, %s references template %s,",
+										check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s,",
 											   si2drObjectGetFileName(group, &err),
 											   (int)si2drObjectGetLineNo(group, &err),
 											   si2drGroupGetGroupType(group,&err),
 											   strx);
-										(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-													  EB, 
-													  &err);
-										sprintf(EB,"                  which says there should be 1 string, with %d numbers in it in the values table,",
+										check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  which says there should be 1 string, with %d numbers in it in the values table,",
 											   tpl1nums
 											   );
-										
-										(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-													  EB, 
-													  &err);
-										sprintf(EB,"                  but in the group's values attribute (ending at line %d) is not a string.",
+										check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  but in the group's values attribute (ending at line %d) is not a string.",
 											   (int)si2drObjectGetLineNo(vs, &err)
 											   );
-										(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-													  EB, 
-													  &err);
 										errcount++;
 									}
 								}
@@ -3317,76 +3077,52 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 							else
 							{
 								
-								sprintf(EB,"%s:%d, %s references template %s, but",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, %s references template %s, but",
 									   si2drObjectGetFileName(group, &err),
 									   (int)si2drObjectGetLineNo(group, &err),
 									   si2drGroupGetGroupType(group,&err),
 									   strx);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-											  EB, 
-											  &err);
-								sprintf(EB,"                  the template's index_1 attribute (line %d) does not have a string as a value.",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "                  the template's index_1 attribute (line %d) does not have a string as a value.",
 									   (int)si2drObjectGetLineNo(ind1, &err)
 									   );
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 						}
 						else
 						{
-							sprintf(EB,"%s:%d, %s references template %s, and only index_1 is defined, but",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, and only index_1 is defined, but",
 								   si2drObjectGetFileName(group, &err),
 								   (int)si2drObjectGetLineNo(group, &err),
 								   si2drGroupGetGroupType(group,&err),
 								   strx);
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-										  EB, 
-										  &err);
-							sprintf(EB,"                  the group has more than one value item...."
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the group has more than one value item...."
 								   );
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-										  EB, 
-										  &err);
 							errcount++;
 						}
 					}
 					else
 					{
-						sprintf(EB,"%s:%d, %s references template %s, but",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, but",
 							   si2drObjectGetFileName(group, &err),
 							   (int)si2drObjectGetLineNo(group, &err),
 							   si2drGroupGetGroupType(group,&err),
 							   strx);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
-						sprintf(EB,"                  the group does not have a values attribute."
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the group does not have a values attribute."
 							   );
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 				}
 
 				else if( si2drObjectIsNull(ind1,&err) && !si2drObjectIsNull(ind2,&err) )
 				{
-					sprintf(EB,"%s:%d, %s references template %s, and index_2 was defined, but index_1 could not be found",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s references template %s, and index_2 was defined, but index_1 could not be found",
 						   si2drObjectGetFileName(group, &err),
 						   (int)si2drObjectGetLineNo(group, &err),
 						   si2drGroupGetGroupType(group,&err),
 						   strx);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
-					sprintf(EB,"                 in the group or the template (line %d).",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                 in the group or the template (line %d).",
 						   (int)si2drObjectGetLineNo(rg2, &err)
 						   );
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 				}
 				/* else ? */
@@ -3396,16 +3132,13 @@ static void check_power_lut_template_arraysize( si2drGroupIdT group)
 		{
 			/* it could be a good 'ol polynomial */
 			
-			rg2 = si2drGroupFindGroupByName(rg,strx, "power_poly_template",&err);
+			rg2 = find_template(strx, "power_poly_template");
 			if( si2drObjectIsNull(rg2,&err) )
 			{
-				sprintf(EB,"%s:%d, %s's reference to template %s: the referenced group could not be found",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, %s's reference to template %s: the referenced group could not be found",
 					   si2drObjectGetFileName(group, &err),
 					   (int)si2drObjectGetLineNo(group, &err),
 					   si2drGroupGetGroupType(group,&err), strx);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 			}
 		}
@@ -3468,38 +3201,26 @@ static void check_cell_n_prop(si2drGroupIdT group)
 	si2drIterQuit(gs,&err);
 	if( gcell_rise && gprop_fall )
 	{
-		sprintf(EB,"%s:%d and %s:%d: It is illegal to specify both cell_rise and fall_propagation in the same timing group.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d and %s:%d: It is illegal to specify both cell_rise and fall_propagation in the same timing group.",
 			   gcell_rise_fi, gcell_rise_ln, gprop_fall_fi, gprop_fall_ln);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	if( gcell_fall && gprop_rise )
 	{
-		sprintf(EB,"%s:%d and %s:%d: It is illegal to specify both cell_fall and rise_propagation in the same timing group.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d and %s:%d: It is illegal to specify both cell_fall and rise_propagation in the same timing group.",
 			   gcell_fall_fi, gcell_fall_ln, gprop_rise_fi, gprop_rise_ln);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	if( gcell_rise && !gtran_rise )
 	{
-		sprintf(EB,"%s:%d: It is illegal to specify cell_rise without a rise_transition in the same timing group.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d: It is illegal to specify cell_rise without a rise_transition in the same timing group.",
 			   gcell_rise_fi,gcell_rise_ln);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	if( gcell_fall && !gtran_fall )
 	{
-		sprintf(EB,"%s:%d: It is illegal to specify cell_fall without a fall_transition in the same timing group.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d: It is illegal to specify cell_fall without a fall_transition in the same timing group.",
 			   gcell_fall_fi,gcell_fall_ln);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	
@@ -3521,13 +3242,10 @@ static void check_clear_n_preset(si2drGroupIdT group)
 
 		if( si2drObjectIsNull(var1,&err) && si2drObjectIsNull(var2,&err) )
 		{
-			sprintf(EB,"%s:%d, Group %s, with both 'clear', and 'preset' attributes,\nrequires 'clear_preset_var1' and/or 'clear_preset_var2' attributes.",
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, Group %s, with both 'clear', and 'preset' attributes,\nrequires 'clear_preset_var1' and/or 'clear_preset_var2' attributes.",
 				   si2drObjectGetFileName(group,&err),
 				   (int)si2drObjectGetLineNo(group,&err),
 				   si2drGroupGetGroupType(group,&err));
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 		}
 	}
@@ -3595,30 +3313,23 @@ static void check_members( si2drGroupIdT group)
 				gname = si2drIterNextName(gnames,&err);
 				si2drIterQuit(gnames,&err);
 
-				sprintf(EB,"%s:%d, The %s bundle needs to have its 'members' specified first.\nThe group %s (line %d) is found before 'members'.",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The %s bundle needs to have its 'members' specified first.\nThe group %s (line %d) is found before 'members'.",
 					   si2drObjectGetFileName(mem,&err),
 					   (int)si2drObjectGetLineNo(mem,&err),
 					   name,
 					   gname, fgln
 					   );
-				
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
 			}
 			if( !si2drObjectIsSame( mem,attr, &err) )
 			{
 				attrname = si2drAttrGetName(attr,&err);
 				
-				sprintf(EB,"%s:%d, The %s bundle needs to have its 'members' specified first.\nThe attr %s (line %d) is found before 'members'.",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The %s bundle needs to have its 'members' specified first.\nThe attr %s (line %d) is found before 'members'.",
 					   si2drObjectGetFileName(mem,&err),
 					   (int)si2drObjectGetLineNo(mem,&err),
 					   name,
 					   attrname, faln
 					   );
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
 			}
 			errcount++;
 		}
@@ -3674,18 +3385,12 @@ static void check_interface_timing(si2drGroupIdT group)
 				switch( gt )
 				{
 				case LIBERTY_GROUPENUM_ff:
-					sprintf(EB,"%s:%d, The cell '%s' has the interface_timing attribute (line %d), but is not a black box.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The cell '%s' has the interface_timing attribute (line %d), but is not a black box.",
 						   si2drObjectGetFileName(g2,&err),
 						   (int)si2drObjectGetLineNo(g2,&err),
 						   name,
 						   iftn);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
-					sprintf(EB,"                  -- The ff group should not be specified when interface_timing is true.");
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  -- The ff group should not be specified when interface_timing is true.");
 					errcount++;
 					break;
 					
@@ -3693,18 +3398,12 @@ static void check_interface_timing(si2drGroupIdT group)
 					attr = si2drGroupFindAttrByName(g2, "function", &err);
 					if( !si2drObjectIsNull(attr,&err) )
 					{
-						sprintf(EB,"%s:%d, The cell '%s' has the interface_timing attribute (line %d), but is not a black box.",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The cell '%s' has the interface_timing attribute (line %d), but is not a black box.",
 							   si2drObjectGetFileName(attr,&err),
 							   (int)si2drObjectGetLineNo(attr,&err),
 							   name,
 							   iftn);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
-						sprintf(EB,"                  -- pin groups should not have the function attribute specified when interface_timing is true.");
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  -- pin groups should not have the function attribute specified when interface_timing is true.");
 						errcount++;
 					}
 					break;
@@ -3800,22 +3499,16 @@ static void check_bus_pin_directions(si2drGroupIdT group) /* group is bus or bun
 
 					if( strcmp(buf,dirstr) )
 					{
-						sprintf(EB,"%s:%d, The group '%s' has the direction attribute (line %d) '%s', but",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The group '%s' has the direction attribute (line %d) '%s', but",
 							   si2drObjectGetFileName(pdir,&err),
 							   (int)si2drObjectGetLineNo(pdir,&err),
 							   get_first_group_name(group),
 							   (int)si2drObjectGetLineNo(bdir,&err),
 							   buf);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
-						sprintf(EB,"                  the pin '%s' has the conflicting direction attribute '%s'.",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "                  the pin '%s' has the conflicting direction attribute '%s'.",
 							   get_first_group_name(g2),
 							   dirstr
 							   );
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 				}
@@ -3865,62 +3558,44 @@ static void check_driver_types(si2drGroupIdT group) /* group should be a pin, pe
 
 	if( pullup && pulldown )
 	{
-		sprintf(EB,"%s:%d, The driver_types 'pull_up' and 'pull_down' cannot be specified on the same pin",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The driver_types 'pull_up' and 'pull_down' cannot be specified on the same pin",
 			   si2drObjectGetFileName(drivertype,&err),
 			   (int)si2drObjectGetLineNo(drivertype,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	if( pullup && bushold )
 	{
-		sprintf(EB,"%s:%d, The driver_types 'pull_up' and 'bus_hold' cannot be specified on the same pin",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The driver_types 'pull_up' and 'bus_hold' cannot be specified on the same pin",
 			   si2drObjectGetFileName(drivertype,&err),
 			   (int)si2drObjectGetLineNo(drivertype,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	if( pulldown && bushold )
 	{
-		sprintf(EB,"%s:%d, The driver_types 'pull_down' and 'bus_hold' cannot be specified on the same pin",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The driver_types 'pull_down' and 'bus_hold' cannot be specified on the same pin",
 			   si2drObjectGetFileName(drivertype,&err),
 			   (int)si2drObjectGetLineNo(drivertype,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	if( opendrain && opensource )
 	{
-		sprintf(EB,"%s:%d, The driver_types 'open_source' and 'open_drain' cannot be specified on the same pin",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The driver_types 'open_source' and 'open_drain' cannot be specified on the same pin",
 			   si2drObjectGetFileName(drivertype,&err),
 			   (int)si2drObjectGetLineNo(drivertype,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	if( opendrain && bushold )
 	{
-		sprintf(EB,"%s:%d, The driver_types 'open_drain' and 'bus_hold' cannot be specified on the same pin",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The driver_types 'open_drain' and 'bus_hold' cannot be specified on the same pin",
 			   si2drObjectGetFileName(drivertype,&err),
 			   (int)si2drObjectGetLineNo(drivertype,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	if( opensource && bushold )
 	{
-		sprintf(EB,"%s:%d, The driver_types 'open_source' and 'bus_hold' cannot be specified on the same pin",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The driver_types 'open_source' and 'bus_hold' cannot be specified on the same pin",
 			   si2drObjectGetFileName(drivertype,&err),
 			   (int)si2drObjectGetLineNo(drivertype,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 
@@ -3957,24 +3632,18 @@ static void check_driver_types(si2drGroupIdT group) /* group should be a pin, pe
 		{
 			if( opensource )
 			{
-				sprintf(EB,"%s:%d, The 'open_source' driver_type (line %d) cannot be specified on an input pin",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The 'open_source' driver_type (line %d) cannot be specified on an input pin",
 					   si2drObjectGetFileName(direct,&err),
 					   (int)si2drObjectGetLineNo(direct,&err),
 					   (int)si2drObjectGetLineNo(drivertype,&err));
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 			}
 			else
 			{
-				sprintf(EB,"%s:%d, The 'open_drain' driver_type (line %d) cannot be specified on an input pin",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The 'open_drain' driver_type (line %d) cannot be specified on an input pin",
 					   si2drObjectGetFileName(direct,&err),
 					   (int)si2drObjectGetLineNo(direct,&err),
 					   (int)si2drObjectGetLineNo(drivertype,&err));
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 			}
 		}
@@ -4026,7 +3695,7 @@ static int get_bus_size(si2drGroupIdT group, char *busname)
 			typeb = si2drGroupFindGroupByName(group, str, "type", &err);
 			if( si2drObjectIsNull(typeb,&err) )
 			{
-				libr = get_containing_group(group,"library");
+				libr = si2drGroupGetLibrary(group,&err);
 				if( !si2drObjectIsNull(libr,&err) )
 				{
 					typeb = si2drGroupFindGroupByName(libr, str, "type", &err);
@@ -4278,46 +3947,12 @@ static si2drGroupIdT find_bu_by_function( si2drGroupIdT cellequiv, char *name )
 	return si2drPIGetNullId(&err);
 }
 
+/* SILIMATE: the group hash holds every name of a pin */
 static si2drGroupIdT find_pin_in_cellequiv( si2drGroupIdT cellequiv, char *name )
 {
 	si2drErrorT err;
-	si2drGroupsIdT gs = si2drGroupGetGroups(cellequiv,&err);
-	si2drGroupIdT g2;
-	int found = 0;
-	si2drNamesIdT names;
-	si2drStringT str;
-	
-	group_enum gt;
-	
-	while(!si2drObjectIsNull((g2=si2drIterNextGroup(gs,&err)),&err) )
-	{
-		gt = si2drGroupGetID(g2,&err);
-		switch( gt )
-		{
-		case LIBERTY_GROUPENUM_pin:
-			names = si2drGroupGetNames(g2, &err);
-			while( (str = si2drIterNextName(names,&err)) )
-			{
-				if( !strcmp(name, str) )
-				{
-					found++;
-					break;
-				}
-			}
-			si2drIterQuit(names,&err);
 
-			if( found )
-			{
-				si2drIterQuit(gs,&err);
-				return g2;
-			}
-			break;
-		default:
-			break;
-		}
-	}
-	si2drIterQuit(gs,&err);
-	return si2drPIGetNullId(&err);
+	return si2drGroupFindGroupByName(cellequiv, name, "pin", &err);
 }
 
 
@@ -4326,9 +3961,20 @@ static void check_next_state_formula( si2drGroupIdT cell, char *formula, int ffb
 	si2drErrorT err;
 	var_list *v;
 	si2drGroupIdT bus;
+	const struct liberty_formula *f;
+	int i;
 	
 	destroy_varlist();
-	gen_var_list(formula);
+	/* SILIMATE: the formula is compiled once per attribute; gen_var_list
+	   still collects the names of one that does not parse */
+	f = liberty_get_formula(attr);
+	if( f )
+	{
+		for(i=0; i<f->nvars; i++)
+			add_varlist(f->vars[i]);
+	}
+	else
+		gen_var_list(formula);
 
 	for(v=master_var_list; v; v=v->next)
 	{
@@ -4352,12 +3998,9 @@ static void check_next_state_formula( si2drGroupIdT cell, char *formula, int ffb
 				
 				if( wid == -1 )
 				{
-					sprintf(EB,"%s:%d, The 'members' attribute was not found in the bundle. Cannot make bus width correspondence checks.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The 'members' attribute was not found in the bundle. Cannot make bus width correspondence checks.",
 						   si2drObjectGetFileName(bus,&err),
 						   (int)si2drObjectGetLineNo(bus,&err));
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 					continue;
 				}
@@ -4365,7 +4008,7 @@ static void check_next_state_formula( si2drGroupIdT cell, char *formula, int ffb
 				{
 					if( wid != ffbankwidth )
 					{
-						sprintf(EB,"%s:%d, This ff_bank, with width %d, does not match the referenced bundle %s (line %d), whose width is %d",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, This ff_bank, with width %d, does not match the referenced bundle %s (line %d), whose width is %d",
 							   si2drObjectGetFileName(attr,&err),
 							   (int)si2drObjectGetLineNo(attr,&err),
 							   ffbankwidth,
@@ -4373,9 +4016,6 @@ static void check_next_state_formula( si2drGroupIdT cell, char *formula, int ffb
 							   (int)si2drObjectGetLineNo(bus,&err),
 							   (int)wid
 							   );
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 						continue;
 					}
@@ -4390,7 +4030,7 @@ static void check_next_state_formula( si2drGroupIdT cell, char *formula, int ffb
 			
 			if( wid != ffbankwidth )
 			{
-				sprintf(EB,"%s:%d, This ff_bank, with width %d, does not match the referenced bus %s (line %d), whose width is %d",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, This ff_bank, with width %d, does not match the referenced bus %s (line %d), whose width is %d",
 					   si2drObjectGetFileName(attr,&err),
 					   (int)si2drObjectGetLineNo(attr,&err),
 					   ffbankwidth,
@@ -4398,9 +4038,6 @@ static void check_next_state_formula( si2drGroupIdT cell, char *formula, int ffb
 					   (int)si2drObjectGetLineNo(bus,&err),
 					   (int)wid
 					);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 				continue;
 			}
@@ -4421,15 +4058,12 @@ static void check_next_state_formula( si2drGroupIdT cell, char *formula, int ffb
 				
 				if( si2drObjectIsNull(pinn,&err) )
 				{
-					sprintf(EB,"%s:%d, This ff_bank, with width %d, references the object %s, which I cannot find.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, This ff_bank, with width %d, references the object %s, which I cannot find.",
 						   si2drObjectGetFileName(attr,&err),
 						   (int)si2drObjectGetLineNo(attr,&err),
 						   ffbankwidth,
 						   v->name
 						);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 					continue;
 				}
@@ -4457,7 +4091,7 @@ static void check_next_state_formula( si2drGroupIdT cell, char *formula, int ffb
 				}
 				if( wid != ffbankwidth )
 				{
-					sprintf(EB,"%s:%d, This ff_bank, with width %d, does not match the referenced bus %s with function %s (line %d), whose width is %d",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, This ff_bank, with width %d, does not match the referenced bus %s with function %s (line %d), whose width is %d",
 						   si2drObjectGetFileName(attr,&err),
 						   (int)si2drObjectGetLineNo(attr,&err),
 						   ffbankwidth,
@@ -4465,9 +4099,6 @@ static void check_next_state_formula( si2drGroupIdT cell, char *formula, int ffb
 						   (int)si2drObjectGetLineNo(bus,&err),
 						   (int)wid
 						   );
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 					continue;
 				}
@@ -4506,12 +4137,9 @@ static void check_ff_bank_widths(si2drGroupIdT group) /* called for ff_banks */
 
 	if( ffbankwidth == 0 )
 	{
-		sprintf(EB,"%s:%d, Could not retrieve ff_bank width from file, or it has value 0. Cannot make bus width correspondence checks.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, Could not retrieve ff_bank width from file, or it has value 0. Cannot make bus width correspondence checks.",
 			   si2drObjectGetFileName(group,&err),
 			   (int)si2drObjectGetLineNo(group,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 		return;
 	}
@@ -4533,12 +4161,9 @@ static void check_ff_bank_widths(si2drGroupIdT group) /* called for ff_banks */
 		if( (si2drSimpleAttrGetValueType(attr,&err) != SI2DR_STRING && si2drSimpleAttrGetValueType(attr,&err) != SI2DR_EXPR)
 			|| (si2drSimpleAttrGetValueType(attr,&err) == SI2DR_EXPR && e->valuetype != SI2DR_STRING) )
 		{
-			sprintf(EB,"%s:%d, The 'next_state' attribute is not of string type. Cannot make bus width correspondence checks.",
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The 'next_state' attribute is not of string type. Cannot make bus width correspondence checks.",
 				   si2drObjectGetFileName(attr,&err),
 				   (int)si2drObjectGetLineNo(attr,&err));
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 			return;
 		}
@@ -4547,12 +4172,9 @@ static void check_ff_bank_widths(si2drGroupIdT group) /* called for ff_banks */
 		
 		if( !str || !str[0] )
 		{
-			sprintf(EB,"%s:%d, The 'next_state' attribute is an empty string. Cannot make bus width correspondence checks.",
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The 'next_state' attribute is an empty string. Cannot make bus width correspondence checks.",
 				   si2drObjectGetFileName(attr,&err),
 				   (int)si2drObjectGetLineNo(attr,&err));
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 			return;
 		}
@@ -4561,18 +4183,12 @@ static void check_ff_bank_widths(si2drGroupIdT group) /* called for ff_banks */
 
 		strcpy(busnam,str);
 		
-		cell = get_containing_group(group,"test_cell");
-		if( si2drObjectIsNull(cell,&err) )
-			cell = get_containing_group(group,"model");
-		if( si2drObjectIsNull(cell,&err) )
-			cell = get_containing_group(group,"scaled_cell");
-		if( si2drObjectIsNull(cell,&err) )
-			cell = get_containing_group(group,"cell");
+		cell = si2drGroupGetCell(group,&err);
 		
 
 		if( !si2drObjectIsNull(cell, &err) )
 		{
-			check_next_state_formula( cell, busnam, ffbankwidth, attr );
+			CHECK_CALL(check_next_state_formula, cell, cell, busnam, ffbankwidth, attr);
 		}
 	}
 	return;
@@ -4610,30 +4226,21 @@ static void check_bus_type( si2drGroupIdT bus )
 		
 		if( !str || !str[0] )
 		{
-			sprintf(EB,"%s:%d, The 'bus_type' attribute is an empty string.",
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The 'bus_type' attribute is an empty string.",
 				   si2drObjectGetFileName(bustype,&err),
 				   (int)si2drObjectGetLineNo(bustype,&err));
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 			return;
 		}
 		
 		/* find the type in the cell or lib */
-		cell = get_containing_group(bus,"test_cell");
-		if( si2drObjectIsNull(cell,&err) )
-			cell = get_containing_group(bus,"model");
-		if( si2drObjectIsNull(cell,&err) )
-			cell = get_containing_group(bus,"scaled_cell");
-		if( si2drObjectIsNull(cell,&err) )
-			cell = get_containing_group(bus,"cell");
+		cell = si2drGroupGetCell(bus,&err);
 		
 		typeb = si2drGroupFindGroupByName(cell, str, "type", &err);
 
 		if( si2drObjectIsNull(typeb,&err) )
 		{
-			libr = get_containing_group(bus,"library");
+			libr = si2drGroupGetLibrary(bus,&err);
 			if( !si2drObjectIsNull(libr,&err) )
 			{
 				typeb = si2drGroupFindGroupByName(libr, str, "type", &err);
@@ -4642,81 +4249,172 @@ static void check_bus_type( si2drGroupIdT bus )
 		
 		if( si2drObjectIsNull(typeb,&err) )
 		{
-			sprintf(EB,"%s:%d, The 'bus_type' references the type '%s', which cannot be found in the containing cell or library.",
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The 'bus_type' references the type '%s', which cannot be found in the containing cell or library.",
 				   si2drObjectGetFileName(bustype,&err),
 				   (int)si2drObjectGetLineNo(bustype,&err), str);
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 			return;
 		}
 	}
 	else
 	{
-		sprintf(EB,"%s:%d, The 'bus_type' attribute is missing in bus '%s'.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The 'bus_type' attribute is missing in bus '%s'.",
 			   si2drObjectGetFileName(bus,&err),
 			   (int)si2drObjectGetLineNo(bus,&err),
 			   get_first_group_name(bus));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 		return;
 	}
 	
 }
 
-static void find_all_refs_to_template(si2drGroupIdT group, char *name, int num )
+/* SILIMATE: the template checks used to walk up to the library for every
+   table, and walk the whole library once per invalid template to list the
+   groups naming it. syntax_check now records the library it checks, and the
+   first invalid template builds a name -> groups table in one pass, which
+   serves every later one. */
+
+typedef struct template_refs
+{
+	si2drGroupIdT *groups; /* in library order */
+	int num, max;
+} template_refs;
+
+static liberty_hash_table *template_ref_hash;
+static pthread_mutex_t template_ref_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static si2drGroupIdT find_template(char *name, char *type)
+{
+	si2drErrorT err;
+	return si2drGroupFindGroupByName(template_index_lib, name, type, &err);
+}
+
+static void index_template_refs(si2drGroupIdT group)
 {
 	si2drErrorT err;
 	si2drGroupsIdT gs = si2drGroupGetGroups(group,&err);
 	si2drGroupIdT g2;
 	si2drNamesIdT names;
 	si2drStringT str;
+	si2drObjectIdT toid;
+	template_refs *refs;
 	
 	while(!si2drObjectIsNull((g2=si2drIterNextGroup(gs,&err)),&err) )
 	{
-		if( !strcmp(si2drGroupGetGroupType(g2,&err), "lu_table_template") )
+		if( si2drGroupGetID(g2,&err) == LIBERTY_GROUPENUM_lu_table_template )
 			continue;
 		
 		names = si2drGroupGetNames(g2, &err);
 		while( (str = si2drIterNextName(names,&err)) )
 		{
-			if( !strcmp(name, str) )
+			liberty_hash_lookup(template_ref_hash, str, &toid);
+			refs = (template_refs*)toid.v1;
+			if( !refs )
 			{
-				if( !num )
-				{
-					sprintf(EB,"         Here is a list of references to this invalid template:");
-					(*MsgPrinter)(SI2DR_SEVERITY_NOTE, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
-				}
-
-				num++;
-				sprintf(EB,"           %s:%d, group '%s'",
-					   si2drObjectGetFileName(g2,&err),
-					   (int)si2drObjectGetLineNo(g2,&err),
-					   si2drGroupGetGroupType(g2,&err));
-				(*MsgPrinter)(SI2DR_SEVERITY_NOTE, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
-				break;
+				refs = (template_refs*)calloc(1, sizeof(template_refs));
+				toid.v1 = (void*)refs;
+				toid.v2 = 0;
+				liberty_hash_enter_oid(template_ref_hash, str, toid);
+			}
+			if( refs->num && refs->groups[refs->num-1].v2 == g2.v2 )
+				continue; /* the same name twice on one group */
+			if( refs->num == refs->max )
+			{
+				refs->max = refs->max ? 2*refs->max : 4;
+				refs->groups = (si2drGroupIdT*)realloc(refs->groups, refs->max*sizeof(si2drGroupIdT));
 			}
+			refs->groups[refs->num++] = g2;
 		}
 		si2drIterQuit(names,&err);
 
-		find_all_refs_to_template(g2,name,num); /* recursively descend */
-		
+		index_template_refs(g2);
 	}
 	si2drIterQuit(gs,&err);
 }
 
+static template_refs *find_template_refs(char *name)
+{
+	si2drObjectIdT toid;
+
+	pthread_mutex_lock(&template_ref_lock);
+	if( !template_ref_hash )
+	{
+		template_ref_hash = liberty_hash_create_hash_table(2011, 1, 0);
+		index_template_refs(template_index_lib);
+	}
+	pthread_mutex_unlock(&template_ref_lock);
+	liberty_hash_lookup(template_ref_hash, name, &toid);
+	return (template_refs*)toid.v1;
+}
+
+static void clear_template_index(void)
+{
+	liberty_hash_bucket *hb;
+	
+	if( template_ref_hash )
+	{
+		for(hb = template_ref_hash->all_list; hb; hb = hb->all_next)
+		{
+			template_refs *refs = (template_refs*)hb->item.v1;
+			free(refs->groups);
+			free(refs);
+		}
+		liberty_hash_destroy_hash_table(template_ref_hash);
+		template_ref_hash = 0;
+	}
+}
+
+/* open-addressed set of group pointers, for find_all_refs_to_template */
+static int owner_set_insert(void **set, int mask, void *p, int insert)
+{
+	int h = (int)(((uintptr_t)p >> 4) * 2654435761u) & mask;
+
+	while( set[h] && set[h] != p )
+		h = (h+1) & mask;
+	if( set[h] )
+		return 1;
+	if( insert )
+		set[h] = p;
+	return 0;
+}
+
+static void find_all_refs_to_template(char *name)
+{
+	si2drErrorT err;
+	template_refs *refs = find_template_refs(name);
+	si2drGroupIdT up;
+	void **owners;
+	int i, mask, seen;
+	
+	if( !refs )
+		return;
+	/* The list reads as the old recursive walk printed it: its count started
+	   over in each subtree, so the header comes again before a reference
+	   unless an earlier one hangs directly off one of its enclosing groups. */
+	for(mask=1; mask < 2*refs->num; mask <<= 1)
+		;
+	owners = (void**)calloc(mask, sizeof(void*));
+	mask--;
+	for(i=0; i<refs->num; i++)
+	{
+		seen = 0;
+		for(up=si2drObjectGetOwner(refs->groups[i],&err); !seen && !si2drObjectIsNull(up,&err); up=si2drObjectGetOwner(up,&err))
+			seen = owner_set_insert(owners, mask, up.v2, 0);
+		if( !seen )
+			check_report(SI2DR_SEVERITY_NOTE, SI2DR_SEMANTIC_ERROR, "         Here is a list of references to this invalid template:");
+		owner_set_insert(owners, mask, si2drObjectGetOwner(refs->groups[i],&err).v2, 1);
+		check_report(SI2DR_SEVERITY_NOTE, SI2DR_SEMANTIC_ERROR, "           %s:%d, group '%s'",
+				si2drObjectGetFileName(refs->groups[i],&err),
+				(int)si2drObjectGetLineNo(refs->groups[i],&err),
+				si2drGroupGetGroupType(refs->groups[i],&err));
+	}
+	free(owners);
+}
+
 
 static void check_index_x(si2drStringT indnam, si2drGroupIdT group)
 {
 	si2drErrorT err;
-	si2drGroupIdT lib;
 	si2drAttrIdT index_x = si2drGroupFindAttrByName(group, indnam, &err);
 	si2drValuesIdT vals;
 	si2drValueTypeT vtype;
@@ -4725,11 +4423,11 @@ static void check_index_x(si2drStringT indnam, si2drGroupIdT group)
 	si2drStringT    string;
 	si2drBooleanT   bool;
 	si2drExprT      *expr;
-	char *p,*t;
+	const struct liberty_decoded_numbers *dn;
 	double x;
 	if( !si2drObjectIsNull(index_x,&err) )
 	{
-		int inval;
+		int inval, i;
 		
 		/* should be a string with a list of comma/space sep'd numbers */
 		if( si2drAttrGetAttrType(index_x,&err) != SI2DR_COMPLEX )
@@ -4743,66 +4441,49 @@ static void check_index_x(si2drStringT indnam, si2drGroupIdT group)
 		
 		if( vtype == SI2DR_UNDEFINED_VALUETYPE )
 		{
-			sprintf(EB,"%s:%d, The '%s' attribute has no values.",
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The '%s' attribute has no values.",
 				   si2drObjectGetFileName(index_x,&err),
 				   (int)si2drObjectGetLineNo(index_x,&err),
 				   indnam);
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 			return;
 		}
 		
 		if( vtype != SI2DR_STRING )
 		{
-			sprintf(EB,"%s:%d, The '%s' attribute should be a string.",
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The '%s' attribute should be a string.",
 				   si2drObjectGetFileName(index_x,&err),
 				   (int)si2drObjectGetLineNo(index_x,&err),
 				   indnam);
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 			return;
 		}
 		
 		if( !string || !string[0] )
 		{
-			sprintf(EB,"%s:%d, The '%s' attribute is an empty string.",
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The '%s' attribute is an empty string.",
 				   si2drObjectGetFileName(index_x,&err),
 				   (int)si2drObjectGetLineNo(index_x,&err),
 				   indnam);
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 			return;
 		}
 	
-		p = string;
-
+		dn = liberty_get_decoded_numbers(index_x);
 		inval = 0;
 		
-		while( (x = strtod(p,&t)), t != p )
+		for(i=dn->starts[0]; i<dn->starts[1]; i++)
 		{
+			x = dn->nums[i];
 			if( x < 0.0 )
 			{
-				sprintf(EB,"%s:%d, The '%s' attribute contains the negative value '%g'. The template '%s' is therefore invalid.",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The '%s' attribute contains the negative value '%g'. The template '%s' is therefore invalid.",
 					   si2drObjectGetFileName(index_x,&err),
 					   (int)si2drObjectGetLineNo(index_x,&err),
 					   indnam,x,get_first_group_name(group));
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 				inval = 1;
 			}
-
-			if( t && *t == 0 )
-				break;
-			
-			p = t+1;
 		}
 
 		if( inval )
@@ -4810,8 +4491,7 @@ static void check_index_x(si2drStringT indnam, si2drGroupIdT group)
 			char buf[SI2DR_MAX_STRING_LEN];
 			strcpy(buf,get_first_group_name(group)); /* do this because si2dr strings are volatile.  */
 			
-			lib = get_containing_group(group,"library");
-			find_all_refs_to_template(lib, buf, 0);
+			find_all_refs_to_template(buf);
 		}
 	}
 }
@@ -4836,7 +4516,7 @@ static void get_index_info(si2drAttrIdT index_x, struct liberty_value_data *vd,
 	si2drStringT    string;
 	si2drBooleanT   bool;
 	si2drExprT      *expr;
-	char *p,*t=NULL;
+	const struct liberty_decoded_numbers *dn;
 	int numcount,i2;
 	LONG_DOUBLE x;
 
@@ -4857,27 +4537,21 @@ static void get_index_info(si2drAttrIdT index_x, struct liberty_value_data *vd,
 		
 		if( vtype == SI2DR_UNDEFINED_VALUETYPE )
 		{
-			sprintf(EB,"%s:%d, The 'index_%d' attribute has no values.",
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The 'index_%d' attribute has no values.",
 				   si2drObjectGetFileName(index_x,&err),
 				   (int)si2drObjectGetLineNo(index_x,&err),
 				   dimno+1);
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 			return;
 		}
 		
 		if( vtype != SI2DR_STRING && vtype != SI2DR_FLOAT64 && vtype != SI2DR_INT32)
 		{
-			sprintf(EB,"%s:%d, The 'index_%d' attribute should be a string," 
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The 'index_%d' attribute should be a string," 
                "a double or an integer.",
 				   si2drObjectGetFileName(index_x,&err),
 				   (int)si2drObjectGetLineNo(index_x,&err),
 				   dimno+1);
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 			return;
 		}
@@ -4887,14 +4561,11 @@ static void get_index_info(si2drAttrIdT index_x, struct liberty_value_data *vd,
          vd->dim_sizes[dimno] = 1;
          vd->index_info[dimno][0] = (vtype == SI2DR_FLOAT64)? float64 : intgr;
          if (vd->index_info[dimno][0] < 0.0) {
-				sprintf(EB,"%s:%d, The 'index_%d' attribute contains the negative "
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The 'index_%d' attribute contains the negative "
                   "value '%e'.",
 					   si2drObjectGetFileName(index_x,&err),
 					   (int)si2drObjectGetLineNo(index_x,&err),
-					   dimno+1,vd->index_info[dimno][0]);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
+					   dimno+1,(double)vd->index_info[dimno][0]);
 				errcount++;
          }
          return;
@@ -4902,22 +4573,22 @@ static void get_index_info(si2drAttrIdT index_x, struct liberty_value_data *vd,
 		
 		if( !string || !string[0] )
 		{
-			sprintf(EB,"%s:%d, The 'index_%d' attribute is an empty string.",
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The 'index_%d' attribute is an empty string.",
 				   si2drObjectGetFileName(index_x,&err),
 				   (int)si2drObjectGetLineNo(index_x,&err),
 				   dimno+1);
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 			return;
 		}
 	
-		p = string;
-		numcount=0;
+		dn = liberty_get_decoded_numbers(index_x);
+		numcount = dn ? dn->starts[1] - dn->starts[0] : 0;
+		if( numcount <= 0 )
+			return; /* no index */
 		
-		while( (x = strtod(p,&t)), t != p )
+		for(i2=0; i2<numcount; i2++)
 		{
+			x = dn->nums[dn->starts[0]+i2];
 			if( x < 0.0 )
 			{
 #ifdef NO_LONG_DOUBLE
@@ -4937,40 +4608,12 @@ static void get_index_info(si2drAttrIdT index_x, struct liberty_value_data *vd,
 				errcount++;
 				inval = 1;
 			}
-
-			numcount++;
-
-			if( t && *t == 0 )
-				break;
-			/* skip over intervening stuff to the next number */
-         while(t &&  (*t == ',' || *t == ' ' || *t == '\t' || *t == '\n' || *t == '\r' || *t == '\\'))
-			{
-				if( *t == '\\' && *(t+1) == '\n' ) /*skip over line escapes */
-					t++;
-				t++;
-			}
-			p = t;
 		}
-		if( numcount )
-		{
-			vd->index_info[dimno] = (LONG_DOUBLE *)calloc(sizeof(LONG_DOUBLE),numcount);
-			vd->dim_sizes[dimno] = numcount;
-
-			p = string;
-			i2 = 0;
-			
-			while( (x = strtod(p,&t)), t != p )
-			{
-				LONG_DOUBLE *pg = vd->index_info[dimno];
-				
-				pg[i2] = x;
-				if( t && *t == 0 )
-					break;
+		vd->index_info[dimno] = (LONG_DOUBLE *)calloc((size_t)numcount, sizeof(LONG_DOUBLE));
+		vd->dim_sizes[dimno] = numcount;
 
-				i2++;
-				p = t+1;
-			}
-		}
+		for(i2=0; i2<numcount; i2++)
+			vd->index_info[dimno][i2] = dn->nums[dn->starts[0]+i2];
 	}
 }
 
@@ -4994,7 +4637,7 @@ static struct liberty_value_data *get_vector_data( si2drGroupIdT vector)
 	si2drStringT    string;
 	si2drBooleanT   bool;
 	si2drExprT      *expr;
-	char *p,*t;
+	char *p;
 	LONG_DOUBLE x;
 	struct liberty_value_data *vd = (struct liberty_value_data *)calloc(sizeof(struct liberty_value_data),1);
 	int numels;
@@ -5103,8 +4746,9 @@ static struct liberty_value_data *get_vector_data( si2drGroupIdT vector)
 	{
 		int inval = 0;
 		int totalcount = 0;
-		int numcount;
+		int numcount, i, k = 0;
 		int first = 1;
+		const struct liberty_decoded_numbers *dn = liberty_get_decoded_numbers(valuesd);
 		
 		/* should be a string with a list of comma/space sep'd numbers */
 		if( si2drAttrGetAttrType(valuesd,&err) != SI2DR_COMPLEX )
@@ -5119,12 +4763,9 @@ static struct liberty_value_data *get_vector_data( si2drGroupIdT vector)
 			si2drIterNextComplexValue(vals,&vtype, &intgr, &float64, &string, &bool, &expr, &err);
 			if( first && vtype == SI2DR_UNDEFINED_VALUETYPE )
 			{
-				sprintf(EB,"%s:%d, The 'values' attribute has no values.",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The 'values' attribute has no values.",
 						si2drObjectGetFileName(valuesd,&err),
 						(int)si2drObjectGetLineNo(valuesd,&err));
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 				break;
 			}
@@ -5134,33 +4775,29 @@ static struct liberty_value_data *get_vector_data( si2drGroupIdT vector)
 			first = 0;
 			if( vtype != SI2DR_STRING )
 			{
-				sprintf(EB,"%s:%d, The 'values' attribute should be a string.",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The 'values' attribute should be a string.",
 						si2drObjectGetFileName(valuesd,&err),
 						(int)si2drObjectGetLineNo(valuesd,&err));
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 				break;
 			}
 		
 			if( !string || !string[0] )
 			{
-				sprintf(EB,"%s:%d, The 'values' attribute is an empty string.",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The 'values' attribute is an empty string.",
 						si2drObjectGetFileName(valuesd,&err),
 						(int)si2drObjectGetLineNo(valuesd,&err));
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 				break;
 			}
 			
-			p = string;
-			numcount=0;
+			numcount = dn->starts[k+1] - dn->starts[k];
 			
-			while( (x = strtod(p,&t)), t != p )
+			for(i=0; i<numcount; i++)
 			{
+				x = dn->nums[dn->starts[k]+i];
+				p = string + dn->offsets[dn->starts[k]+i];
+				
 				if( dadtype == LIBERTY_GROUPENUM_output_current_rise && x < 0.0 )
 				{
 #ifdef NO_LONG_DOUBLE
@@ -5202,12 +4839,9 @@ static struct liberty_value_data *get_vector_data( si2drGroupIdT vector)
 				
 				if( x > -0.00000000000000001 && x < 0.00000000000000001 )
 				{
-					sprintf(EB,"%s:%d, The vector 'values' attribute contains one or more zero values.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The vector 'values' attribute contains one or more zero values.",
 							si2drObjectGetFileName(valuesd,&err),
 							(int)si2drObjectGetLineNo(valuesd,&err));
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
 				}
 				if( num_get_precision(p) < 4 )
 				{
@@ -5226,23 +4860,11 @@ static struct liberty_value_data *get_vector_data( si2drGroupIdT vector)
 				}
 				
 
-				vd->values[totalcount+numcount] = x;
-				
-				numcount++;
-				
-				if( t && *t == 0 )
-					break;
-				
-				/* skip over intervening stuff to the next number */
-				while( *t == ',' || *t == ' ' || *t == '\t' || *t == '\n' || *t == '\r' || *t == '\\' )
-				{
-					if( *t == '\\' && *(t+1) == '\n' ) /*skip over line escapes */
-						t++;
-					t++;
-				}
-				p = t;
+				if( totalcount+i < numels )
+					vd->values[totalcount+i] = x;
 			}
 			totalcount += numcount;
+			k++;
 			
 		}
 		while( vtype != SI2DR_UNDEFINED_VALUETYPE );
@@ -5250,24 +4872,18 @@ static struct liberty_value_data *get_vector_data( si2drGroupIdT vector)
 		si2drIterQuit(vals,&err);
 		if ( totalcount != numels )
 		{
-			sprintf(EB,"%s:%d, The vector 'values' attribute with %d vs. %d expected values",
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The vector 'values' attribute with %d vs. %d expected values",
 					si2drObjectGetFileName(vector,&err),
 					(int)si2drObjectGetLineNo(vector,&err), 
 					totalcount, numels);
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 		}
 	}
 	else
 	{
-		sprintf(EB,"%s:%d, The vector contains no 'values' attribute.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The vector contains no 'values' attribute.",
 				si2drObjectGetFileName(vector,&err),
 				(int)si2drObjectGetLineNo(vector,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	return vd;
@@ -5345,7 +4961,7 @@ static void check_output_current_template( si2drGroupIdT group )
 
 	if( !operating_conds_checked )
 	{
-		si2drGroupIdT libr= get_containing_group(group,"library");
+		si2drGroupIdT libr= si2drGroupGetLibrary(group,&err);
 		si2drAttrIdT defopcond = si2drGroupFindAttrByName(libr, "default_operating_conditions", &err);
 		si2drAttrIdT nomvolt = si2drGroupFindAttrByName(libr, "nom_voltage", &err);
 		
@@ -5377,14 +4993,11 @@ static void check_output_current_template( si2drGroupIdT group )
 
 							if ( nomvoltval != opcondvoltval )
 							{
-								sprintf(EB,"%s:%d, The library nom_voltage (%g) doesn't match the voltage (%g) in the operating_conditions(%s).",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The library nom_voltage (%g) doesn't match the voltage (%g) in the operating_conditions(%s).",
 										si2drObjectGetFileName(nomvolt,&err),
 										(int)si2drObjectGetLineNo(nomvolt,&err),
 										nomvoltval, opcondvoltval,
 										opcondname);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 								return;
 							}
@@ -5401,36 +5014,27 @@ static void check_output_current_template( si2drGroupIdT group )
 	/* check out variable_3 first */
 	if( si2drAttrGetAttrType(var_3,&err) != SI2DR_SIMPLE )
 	{
-		sprintf(EB,"%s:%d, The variable_3 attribute is not a simple attribute.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The variable_3 attribute is not a simple attribute.",
 				si2drObjectGetFileName(group,&err),
 				(int)si2drObjectGetLineNo(group,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 		return;
 	}
 	attrvtype = si2drSimpleAttrGetValueType(var_3,&err);
 	if ( attrvtype != SI2DR_STRING )
 	{
-		sprintf(EB,"%s:%d, The variable_3 attribute is not a string.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The variable_3 attribute is not a string.",
 				si2drObjectGetFileName(group,&err),
 				(int)si2drObjectGetLineNo(group,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 		return;
 	}
 	string = si2drSimpleAttrGetStringValue(var_3,&err);
 	if( strcasecmp(string,"time") != 0 )
 	{
-		sprintf(EB,"%s:%d, The variable_3 attribute is '%s', but should be 'time'.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The variable_3 attribute is '%s', but should be 'time'.",
 				si2drObjectGetFileName(group,&err),
 				(int)si2drObjectGetLineNo(group,&err),string);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 		return;
 	}
@@ -5438,24 +5042,18 @@ static void check_output_current_template( si2drGroupIdT group )
 	/* check out variable_1 */
 	if( si2drAttrGetAttrType(var_1,&err) != SI2DR_SIMPLE )
 	{
-		sprintf(EB,"%s:%d, The variable_1 attribute is not a simple attribute.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The variable_1 attribute is not a simple attribute.",
 				si2drObjectGetFileName(group,&err),
 				(int)si2drObjectGetLineNo(group,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 		return;
 	}
 	attrvtype = si2drSimpleAttrGetValueType(var_1,&err);
 	if ( attrvtype != SI2DR_STRING )
 	{
-		sprintf(EB,"%s:%d, The variable_1 attribute is not a string.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The variable_1 attribute is not a string.",
 				si2drObjectGetFileName(group,&err),
 				(int)si2drObjectGetLineNo(group,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 		return;
 	}
@@ -5463,12 +5061,9 @@ static void check_output_current_template( si2drGroupIdT group )
 	if( strcasecmp(string,"input_net_transition") != 0 &&
 		strcasecmp(string,"total_output_net_capacitance") != 0 )
 	{
-		sprintf(EB,"%s:%d, The variable_1 attribute is '%s', but should be either 'input_net_transition' or 'total_output_net_capacitance'.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The variable_1 attribute is '%s', but should be either 'input_net_transition' or 'total_output_net_capacitance'.",
 				si2drObjectGetFileName(group,&err),
 				(int)si2drObjectGetLineNo(group,&err),string);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 		return;
 	}
@@ -5477,24 +5072,18 @@ static void check_output_current_template( si2drGroupIdT group )
 	/* check out variable_2 */
 	if( si2drAttrGetAttrType(var_2,&err) != SI2DR_SIMPLE )
 	{
-		sprintf(EB,"%s:%d, The variable_2 attribute is not a simple attribute.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The variable_2 attribute is not a simple attribute.",
 				si2drObjectGetFileName(group,&err),
 				(int)si2drObjectGetLineNo(group,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 		return;
 	}
 	attrvtype = si2drSimpleAttrGetValueType(var_2,&err);
 	if ( attrvtype != SI2DR_STRING )
 	{
-		sprintf(EB,"%s:%d, The variable_2 attribute is not a string.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The variable_2 attribute is not a string.",
 				si2drObjectGetFileName(group,&err),
 				(int)si2drObjectGetLineNo(group,&err));
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 		return;
 	}
@@ -5502,12 +5091,9 @@ static void check_output_current_template( si2drGroupIdT group )
 	if( strcasecmp(string,"input_net_transition") != 0 &&
 		strcasecmp(string,"total_output_net_capacitance") != 0 )
 	{
-		sprintf(EB,"%s:%d, The variable_1 attribute is '%s', but should be either 'input_net_transition' or 'total_output_net_capacitance'.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The variable_1 attribute is '%s', but should be either 'input_net_transition' or 'total_output_net_capacitance'.",
 				si2drObjectGetFileName(group,&err),
 				(int)si2drObjectGetLineNo(group,&err),string);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 		return;
 	}
@@ -5541,11 +5127,8 @@ static int check_retention_cell(si2drGroupIdT group) // SILIMATE: explicitly set
 		si2drStringT pgf = si2drObjectGetFileName(power_gating,&err);
 		int pgl = si2drObjectGetLineNo(power_gating,&err);
 
-		sprintf(EB,"%s:%d, and %s:%d -- retention_cell and power_gating_cell attributes are not allowed in the same cell.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, and %s:%d -- retention_cell and power_gating_cell attributes are not allowed in the same cell.",
 				rf, rl, pgf, pgl);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 }
@@ -5567,11 +5150,8 @@ static void check_retention_pin(si2drGroupIdT group)
 		si2drStringT pgf = si2drObjectGetFileName(power_gating,&err);
 		int pgl = si2drObjectGetLineNo(power_gating,&err);
 
-		sprintf(EB,"%s:%d, and %s:%d -- retention_pin and power_gating_pin attributes are not allowed in the same pin.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, and %s:%d -- retention_pin and power_gating_pin attributes are not allowed in the same pin.",
 				rf, rl, pgf, pgl);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	if( !si2drObjectIsNull(retention, &err) && !si2drObjectIsNull(mtl, &err))
@@ -5581,11 +5161,8 @@ static void check_retention_pin(si2drGroupIdT group)
 		si2drStringT pgf = si2drObjectGetFileName(mtl,&err);
 		int pgl = si2drObjectGetLineNo(mtl,&err);
 
-		sprintf(EB,"%s:%d, and %s:%d -- when retention_pin and map_to_logic attributes are spec'd on the same pin, the retention_pin's definition will have precedence.",
+		check_report(SI2DR_SEVERITY_WARN, SI2DR_NO_ERROR, "%s:%d, and %s:%d -- when retention_pin and map_to_logic attributes are spec'd on the same pin, the retention_pin's definition will have precedence.",
 				rf, rl, pgf, pgl);
-		(*MsgPrinter)(SI2DR_SEVERITY_WARN, SI2DR_NO_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	if( !si2drObjectIsNull(retention,&err) && !si2drObjectIsNull(dir, &err) )
@@ -5601,11 +5178,8 @@ static void check_retention_pin(si2drGroupIdT group)
 					int rl = si2drObjectGetLineNo(retention,&err);
 					si2drStringT df = si2drObjectGetFileName(dir,&err);
 					int dl = si2drObjectGetLineNo(dir,&err);
-					sprintf(EB,"%s:%d, and %s:%d -- retention_pin cannot be defined on an output pin.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, and %s:%d -- retention_pin cannot be defined on an output pin.",
 							rf, rl, df, dl);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 				}
 				/* else we are OK */
@@ -5614,11 +5188,8 @@ static void check_retention_pin(si2drGroupIdT group)
 			{
 				si2drStringT rf = si2drObjectGetFileName(dir,&err);
 				int rl = si2drObjectGetLineNo(dir,&err);
-				sprintf(EB,"%s:%d, The pin direction attribute is NOT a string?",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The pin direction attribute is NOT a string?",
 						rf, rl);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 			}
 		}
@@ -5626,11 +5197,8 @@ static void check_retention_pin(si2drGroupIdT group)
 		{
 			si2drStringT rf = si2drObjectGetFileName(dir,&err);
 			int rl = si2drObjectGetLineNo(dir,&err);
-			sprintf(EB,"%s:%d, The pin direction attribute is NOT a simple attribute?",
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The pin direction attribute is NOT a simple attribute?",
 					rf, rl);
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 		}
 	}
@@ -5650,11 +5218,8 @@ static void check_level_shift(si2drGroupIdT group)
 	{
 		si2drStringT df = si2drObjectGetFileName(ovr,&err);
 		int dl = si2drObjectGetLineNo(ovr,&err);
-		sprintf(EB,"%s:%d, output_voltage_range is defined, but not is_level_shifter.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, output_voltage_range is defined, but not is_level_shifter.",
 				df, dl);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	
@@ -5662,11 +5227,8 @@ static void check_level_shift(si2drGroupIdT group)
 	{
 		si2drStringT df = si2drObjectGetFileName(ivr,&err);
 		int dl = si2drObjectGetLineNo(ivr,&err);
-		sprintf(EB,"%s:%d, input_voltage_range is defined, but not is_level_shifter.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, input_voltage_range is defined, but not is_level_shifter.",
 				df, dl);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	
@@ -5674,11 +5236,8 @@ static void check_level_shift(si2drGroupIdT group)
 	{
 		si2drStringT df = si2drObjectGetFileName(lst,&err);
 		int dl = si2drObjectGetLineNo(lst,&err);
-		sprintf(EB,"%s:%d, level_shifter_type is defined, but not is_level_shifter.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, level_shifter_type is defined, but not is_level_shifter.",
 				df, dl);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 
@@ -5687,11 +5246,8 @@ static void check_level_shift(si2drGroupIdT group)
 	{
 		si2drStringT df = si2drObjectGetFileName(ivr,&err);
 		int dl = si2drObjectGetLineNo(ivr,&err);
-		sprintf(EB,"%s:%d, output_voltage_range and input_voltage_range must both be defined in a cell.",
+		check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, output_voltage_range and input_voltage_range must both be defined in a cell.",
 				df, dl);
-		(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-					  EB, 
-					  &err);
 		errcount++;
 	}
 	/* not all the rules are checked here (yet) */
@@ -5701,7 +5257,7 @@ static void check_ref_times(si2drGroupIdT group)
 {
 	si2drErrorT err;
 	si2drGroupsIdT subs = si2drGroupGetGroups(group, &err);
-	si2drGroupIdT subg, rg, rg2;
+	si2drGroupIdT subg, rg2;
 	group_enum gt;
 	si2drAttrIdT refattr;
 	int i=0,j=0,transvar;
@@ -5729,12 +5285,9 @@ static void check_ref_times(si2drGroupIdT group)
 					/* any negative ref vals? */
 					if( val < 0.0 )
 					{
-						sprintf(EB,"%s:%d, The reference_time attribute should not be negative.",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The reference_time attribute should not be negative.",
 								si2drObjectGetFileName(refattr,&err),
 								(int)si2drObjectGetLineNo(refattr,&err));
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 					
@@ -5744,8 +5297,7 @@ static void check_ref_times(si2drGroupIdT group)
 
 					transvar = 0;
 
-					rg = get_containing_group(group,"library");
-					rg2 = si2drGroupFindGroupByName(rg, nam, "output_current_template",&err);
+					rg2 = find_template(nam, "output_current_template");
 					if( !si2drObjectIsNull(rg2,&err) )
 					{
 						si2drAttrIdT var1,var2;
@@ -5764,12 +5316,9 @@ static void check_ref_times(si2drGroupIdT group)
 						}
 						else
 						{
-							sprintf(EB,"%s:%d, The output_current_template has a problem with the variable_1 attribute.",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The output_current_template has a problem with the variable_1 attribute.",
 									si2drObjectGetFileName(rg2,&err),
 									(int)si2drObjectGetLineNo(rg2,&err));
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-										  EB, 
-										  &err);
 							errcount++;
 							refvals.reported[j] = 1;
 						}
@@ -5787,12 +5336,9 @@ static void check_ref_times(si2drGroupIdT group)
 						}
 						else
 						{
-							sprintf(EB,"%s:%d, The output_current_template has a problem with the variable_2 attribute.",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The output_current_template has a problem with the variable_2 attribute.",
 									si2drObjectGetFileName(rg2,&err),
 									(int)si2drObjectGetLineNo(rg2,&err));
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-										  EB, 
-										  &err);
 							errcount++;
 							refvals.reported[j] = 1;
 						}
@@ -5826,39 +5372,27 @@ static void check_ref_times(si2drGroupIdT group)
 								}
 								else
 								{
-									sprintf(EB,"%s:%d, This index value should be a string, but is not.",
+									check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, This index value should be a string, but is not.",
 											si2drObjectGetFileName(translew_index,&err),
 											(int)si2drObjectGetLineNo(translew_index,&err));
-									
-									(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-												  EB, 
-												  &err);
 									errcount++;
 								}
 							}
 						}
 						else
 						{
-							sprintf(EB,"%s:%d, Could not find the index_1 or index_2 value.",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, Could not find the index_1 or index_2 value.",
 									si2drObjectGetFileName(subg,&err),
 									(int)si2drObjectGetLineNo(subg,&err));
-							
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-										  EB, 
-										  &err);
 							errcount++;
 						}
 						
 					}
 					else
 					{
-						sprintf(EB,"%s:%d, Could not determine whether index_1 or index_2 holds the transition/slew value",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, Could not determine whether index_1 or index_2 holds the transition/slew value",
 								si2drObjectGetFileName(group,&err),
 								(int)si2drObjectGetLineNo(group,&err));
-						
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 					
@@ -5906,15 +5440,12 @@ static void check_ref_times(si2drGroupIdT group)
 				&& refvals.translew[i] == refvals.translew[j] )
 			{
 				/* the same template, same trans/slew, but different reference_time values */
-				sprintf(EB,"%s:%d, The reference_time attribute value (%g) differs from that used in the vector (%g) at line %d.",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The reference_time attribute value (%g) differs from that used in the vector (%g) at line %d.",
 						si2drObjectGetFileName(refvals.oid[j],&err),
 						(int)si2drObjectGetLineNo(refvals.oid[j],&err),
 						refvals.val[j],
 						refvals.val[i],
 						(int)si2drObjectGetLineNo(refvals.oid[i],&err));
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 				refvals.reported[j] = 1;
 			}
@@ -5961,12 +5492,24 @@ void check_ccs_density( si2drGroupIdT group )
 	while( !(si2drObjectIsNull((rg4 = si2drIterNextGroup(vectors,&err) ), &err)) )
 	{
 		struct liberty_value_data *vdv = liberty_get_values_data(rg4);
+		LONG_DOUBLE x, y;
+
+		/* SILIMATE: read through the accessors, since the arrays are narrowed
+		   under a FLOAT64 or FLOAT32 table precision */
+		if( !vdv || vdv->dimensions < 2 || vdv->dim_sizes[0] < 1 || vdv->dim_sizes[1] < 1 )
+		{
+			if( vdv )
+				liberty_destroy_value_data(vdv);
+			continue;
+		}
+		x = liberty_get_index_at(vdv, 0, 0);
+		y = liberty_get_index_at(vdv, 1, 0);
 
 		/* does this value already exist? */
 		for(j=0;j<i;j++)
 		{
-			if( vl_oc[j].x == vdv->index_info[0][0]
-				&& vl_oc[j].y == vdv->index_info[1][0] )
+			if( vl_oc[j].x == x
+				&& vl_oc[j].y == y )
 			{
 				found =1;
 				break;
@@ -5976,8 +5519,8 @@ void check_ccs_density( si2drGroupIdT group )
 		if( !found )
 		{
 			/* the only really useful info in the vector is the index_1 and index_2 values */
-			vl_oc[i].x = vdv->index_info[0][0];
-			vl_oc[i].y = vdv->index_info[1][0];
+			vl_oc[i].x = x;
+			vl_oc[i].y = y;
 			vl_oc[i].group = rg4;
 			i++;
 		}
@@ -5987,15 +5530,15 @@ void check_ccs_density( si2drGroupIdT group )
 			sprintf(EB,"%s:%d, The index_1 (%g) and index_2 (%g) values in this vector already appear in a previous vector group (line %d).",
 					si2drObjectGetFileName(rg4,&err),
 					(int)si2drObjectGetLineNo(rg4,&err), 
-					vdv->index_info[0][0], 
-					vdv->index_info[1][0], 
+					x, 
+					y, 
 					(int)si2drObjectGetLineNo(vl_oc[j].group,&err));
 #else
 			sprintf(EB,"%s:%d, The index_1 (%Lg) and index_2 (%Lg) values in this vector already appear in a previous vector group (line %d).",
 					si2drObjectGetFileName(rg4,&err),
 					(int)si2drObjectGetLineNo(rg4,&err), 
-					vdv->index_info[0][0], 
-					vdv->index_info[1][0], 
+					x, 
+					y, 
 					(int)si2drObjectGetLineNo(vl_oc[j].group,&err));
 #endif
 			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
@@ -6169,7 +5712,7 @@ static void group_specific_checks( si2drGroupIdT group )
 		break;
 
 	case LIBERTY_GROUPENUM_rise_transition_degradation:
-		check_lu_table_template_arraysize(group);
+		CHECK_CALL(check_lu_table_template_arraysize, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_rise_net_delay:
@@ -6191,14 +5734,14 @@ static void group_specific_checks( si2drGroupIdT group )
 		break;
 
 	case LIBERTY_GROUPENUM_lu_table_template:
-		check_lut_template(group);
+		CHECK_CALL(check_lut_template, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_input_voltage:
 		break;
 
 	case LIBERTY_GROUPENUM_fall_transition_degradation:
-		check_lu_table_template_arraysize(group);
+		CHECK_CALL(check_lu_table_template_arraysize, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_fall_net_delay:
@@ -6220,11 +5763,11 @@ static void group_specific_checks( si2drGroupIdT group )
 		break;
 
 	case LIBERTY_GROUPENUM_seq_bank:
-		check_clear_n_preset(group);
+		CHECK_CALL(check_clear_n_preset, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_seq:
-		check_clear_n_preset(group);
+		CHECK_CALL(check_clear_n_preset, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_routing_track:
@@ -6243,39 +5786,39 @@ static void group_specific_checks( si2drGroupIdT group )
 		break;
 
 	case LIBERTY_GROUPENUM_latch_bank:
-		check_clear_n_preset(group);
+		CHECK_CALL(check_clear_n_preset, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_latch:
-		check_clear_n_preset(group);
+		CHECK_CALL(check_clear_n_preset, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_generated_clock:
 		break;
 
 	case LIBERTY_GROUPENUM_ff_bank:
-		check_clear_n_preset(group);
-		check_ff_bank_widths(group);
+		CHECK_CALL(check_clear_n_preset, group, group);
+		CHECK_CALL(check_ff_bank_widths, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_ff:
-		check_clear_n_preset(group);
+		CHECK_CALL(check_clear_n_preset, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_bus:
- 		check_bus_pin_directions(group);
-		check_bus_type( group );
+ 		CHECK_CALL(check_bus_pin_directions, group, group);
+		CHECK_CALL(check_bus_type, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_tlatch:
 		break;
 
 	case LIBERTY_GROUPENUM_rise_transition:
-		check_lu_table_template_arraysize(group);
+		CHECK_CALL(check_lu_table_template_arraysize, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_rise_propagation:
-		check_lu_table_template_arraysize(group);
+		CHECK_CALL(check_lu_table_template_arraysize, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_rise_constraint:
@@ -6288,34 +5831,34 @@ static void group_specific_checks( si2drGroupIdT group )
 		break;
 
 	case LIBERTY_GROUPENUM_fall_transition:
-		check_lu_table_template_arraysize(group);
+		CHECK_CALL(check_lu_table_template_arraysize, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_fall_propagation:
-		check_lu_table_template_arraysize(group);
+		CHECK_CALL(check_lu_table_template_arraysize, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_fall_constraint:
 		break;
 
 	case LIBERTY_GROUPENUM_cell_rise:
-		check_lu_table_template_arraysize(group);
+		CHECK_CALL(check_lu_table_template_arraysize, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_cell_fall:
-		check_lu_table_template_arraysize(group);
+		CHECK_CALL(check_lu_table_template_arraysize, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_cell_degradation:
 		break;
 
 	case LIBERTY_GROUPENUM_timing:
-		check_cell_n_prop(group);
+		CHECK_CALL(check_cell_n_prop, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_pin:
-		check_driver_types(group);
-		check_retention_pin(group);
+		CHECK_CALL(check_driver_types, group, group);
+		CHECK_CALL(check_retention_pin, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_minimum_period:
@@ -6331,15 +5874,15 @@ static void group_specific_checks( si2drGroupIdT group )
 		break;
 
 	case LIBERTY_GROUPENUM_rise_power:
-		check_power_lut_template_arraysize(group);
+		CHECK_CALL(check_power_lut_template_arraysize, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_power:
-		check_power_lut_template_arraysize(group);
+		CHECK_CALL(check_power_lut_template_arraysize, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_fall_power:
-		check_power_lut_template_arraysize(group);
+		CHECK_CALL(check_power_lut_template_arraysize, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_internal_power:
@@ -6350,7 +5893,7 @@ static void group_specific_checks( si2drGroupIdT group )
 		
 		if( !si2drObjectIsNull(attr,&err) )
 		{
-			check_power_lut_template_arraysize(group);
+			CHECK_CALL(check_power_lut_template_arraysize, group, group);
 		}
 		break;
 
@@ -6361,35 +5904,35 @@ static void group_specific_checks( si2drGroupIdT group )
 		break;
 
 	case LIBERTY_GROUPENUM_bundle:
-		check_members(group);
- 		check_bus_pin_directions(group);
+		CHECK_CALL(check_members, group, group);
+ 		CHECK_CALL(check_bus_pin_directions, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_cell:
-		check_interface_timing(group);
-		check_retention_cell(group);
-		check_level_shift(group);
+		CHECK_CALL(check_interface_timing, group, group);
+		CHECK_CALL(check_retention_cell, group, group);
+		CHECK_CALL(check_level_shift, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_library:
 		break;
 
 	case LIBERTY_GROUPENUM_vector:
-		check_vector(group);
+		CHECK_CALL(check_vector, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_output_current_template:
-		check_output_current_template(group);
+		CHECK_CALL(check_output_current_template, group, group);
 		break;
 
 	case LIBERTY_GROUPENUM_output_current_rise:
-		check_ref_times(group);
-		check_ccs_density(group);
+		CHECK_CALL(check_ref_times, group, group);
+		CHECK_CALL(check_ccs_density, group, group);
 		break;
 		
 	case LIBERTY_GROUPENUM_output_current_fall:
-		check_ref_times(group);
-		check_ccs_density(group);
+		CHECK_CALL(check_ref_times, group, group);
+		CHECK_CALL(check_ccs_density, group, group);
 		break;
 	default:
 		break;
@@ -6397,126 +5940,1269 @@ static void group_specific_checks( si2drGroupIdT group )
 }
 
 
-void check_group_correspondence( si2drGroupIdT g, libsynt_group_info *gi )
+static void check_subgroup_correspondence( si2drGroupIdT group, libsynt_group_info *gi, char *gtype )
 {
-	int nc;
-	si2drNamesIdT names;
 	si2drErrorT err;
-	si2drStringT str;
-	si2drAttrIdT attr;
-	si2drAttrsIdT attrs;
-	si2drGroupIdT group;
-	si2drGroupsIdT groups;
-	
-	int gl   = si2drObjectGetLineNo(g,&err);
-	char *gf = si2drObjectGetFileName(g,&err);
-	char gtype[SI2DR_MAX_STRING_LEN];
-	
-	/* check all group attributes, including names, etc. to constraints */
+	si2drStringT gt = si2drGroupGetGroupType(group,&err);
+	si2drObjectIdT toid;
+	int al = si2drObjectGetLineNo(group,&err);
+	char *af = si2drObjectGetFileName(group,&err);
 
-	if( gi && gi->ref )
-		gi = gi->ref;
-	
-	strcpy( gtype, si2drGroupGetGroupType(g,&err) );
+	toid.v1 = NULL;
 	
-	/* names */
-	nc = 0;
-	names = si2drGroupGetNames(g, &err);
-	while( (str = si2drIterNextName(names,&err)) )
-	{
-		nc++;
-	}
-	si2drIterQuit(names,&err);
-
 	if( gi )
+		toid.v1 = syntax_group_info(gi, group, gt);
+
+	if( toid.v1 == NULL )
 	{
-		
-		switch( gi->name_constraints )
+		si2drDefineIdT def;
+		/* check to see if a define_group is defined for this situation */
+		def = si2drPIFindDefineByName(gt, &err);
+		if( err != SI2DR_NO_ERROR )
 		{
-		case SYNTAX_GNAME_NONE:
-			if( nc > 0 )
-			{
-				sprintf(EB,"%s:%d, The %s group in this context is not supposed to have any names, but %d name(s) is(are) there.",
-					   gf, gl, gtype, nc);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-							  EB, 
-							  &err);
-				errcount++;
-			}
-			break;
-		case SYNTAX_GNAME_ONE:
-			if( nc != 1 )
-			{
-				sprintf(EB,"%s:%d, The %s group in this context should have 1 name, but %d names are there.",
-					   gf, gl, gtype, nc);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-							  EB, 
-							  &err);
-				errcount++;
-			}
-			break;
-		case SYNTAX_GNAME_TWO:
-			if( nc != 2 )
-			{
-				sprintf(EB,"%s:%d, The %s group in this context should have 2 nams, but %d name(s) is(are) there.",
-					   gf, gl, gtype, nc);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-							  EB, 
-							  &err);
-				errcount++;
-			}
-			break;
-		case SYNTAX_GNAME_THREE:
-			if( nc != 3 )
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The %s group is not allowed in the %s group in this context.",
+				   af ? af : "", al, gt, gtype);
+			errcount++;
+		}
+		else
+		{
+			si2drStringT grname, grall;
+			si2drValueTypeT grval;
+			char *allowedParents;
+			char *nextParent;
+			int groupInListOfParents = 0;
+			
+			si2drDefineGetInfo( def,
+								&grname,
+								&grall,
+								&grval,
+								&err);
+
+			/* the following code is a fix provided by David Mallis of SI2 */
+			/* many thanks, David! */
+
+			/* If group allowed in > 1 parents, grall comes in as "grp1|grp2|..."
+			// The original check "strcmp(grall,gtype)" only works if there is only 1.
+			// Instead, it is necessary to loop through the grall entries checking
+			// each one against the current parent group.
+			//
+			// See if this group is allowed in its parent by its define_group statement.
+			// - allowedParents must be turned to NULL for subsequent calls to strtok.
+			// - strdup the grall so strtok's NULL planting on delims doesn't hose it.
+			*/
+
+			allowedParents = strdup(grall);
+			nextParent=allowedParents;
+			do
 			{
-				sprintf(EB,"%s:%d, The %s group in this context should have 3 nams, but %d name(s) is(are) there.",
-					   gf, gl, gtype, nc);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-							  EB, 
-							  &err);
-				errcount++;
-			}
-			break;
-		case SYNTAX_GNAME_NONE_OR_ONE:
-			if( nc != 1 && nc != 0 )
+				char *sep = strchr(nextParent,'|');
+				if( sep )
+					*sep = 0;
+				if ( !strcmp(nextParent,gtype) )
+				{
+					groupInListOfParents = 1;
+					break;
+				}
+				if( sep )
+					nextParent = sep+1;
+				else
+					nextParent = NULL;
+			} while ( nextParent );
+			free(allowedParents);
+            allowedParents = NULL;
+			/* Synopsys infopop user Roman reports that the original version of the
+			   above code would leak allowedParents. He offered a variation that
+			   would eliminate the problem.
+			   I decided to modify the above to eliminate the use of strtok, whose
+			   linux man page advises "Never use these functions.", giving some 
+			   reasons, and this was a perfect example of why not.
+			*/
+
+			if( grval == SI2DR_UNDEFINED_VALUETYPE )
 			{
-				sprintf(EB,"%s:%d, The %s group in this context should have 0 or 1 names, but %d names are there.",
-					   gf, gl, gtype, nc);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-							  EB, 
-							  &err);
-				errcount++;
+				/* if this is a group, I hear it MUST have at least one name associated with it! */
+				si2drErrorT err;
+				si2drStringT str;
+				si2drNamesIdT names;
+				names = si2drGroupGetNames(group,&err);
+				str = si2drIterNextName(names,&err);
+				if (!str || !str[0] )
+				{
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The %s group (a user defined group) should have a name associated with it .",
+							af ? af : "", al, gt);
+					errcount++;
+				}
+				si2drIterQuit(names,&err);
 			}
-			break;
-		case SYNTAX_GNAME_ONE_OR_MORE:
-			if( nc == 0  )
+			if( !groupInListOfParents && grval == SI2DR_UNDEFINED_VALUETYPE ) /* OLD TEST: if( strcmp(grall,gtype) && grval == SI2DR_UNDEFINED_VALUETYPE ) */
 			{
-				sprintf(EB,"%s:%d, The %s group in this context should have 1 or more names, but no names are there.",
-					   gf, gl, gtype);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-							  EB, 
-							  &err);
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The %s group is allowed in the %s group, but not allowed in the %s group in this case.",
+					   af ? af : "", al, gt, grall, gtype);
 				errcount++;
 			}
-			break;
+			else
+				check_group_correspondence(group, (libsynt_group_info*)toid.v1);
+				
 		}
 	}
-	
-	/* attrs */
-	attrs = si2drGroupGetAttrs(g, &err);
-	while( !(si2drObjectIsNull((attr = si2drIterNextAttr(attrs,&err) ), &err)) )
+	else
 	{
-		si2drStringT anam = si2drAttrGetName(attr,&err);
-		si2drAttrTypeT at = si2drAttrGetAttrType(attr,&err);
-		si2drObjectIdT toid;
-		int al = si2drObjectGetLineNo(attr,&err);
-		char *af = si2drObjectGetFileName(attr,&err);
-		
-		toid.v1 = NULL;
-		
-		if( at == SI2DR_SIMPLE )
-		{
-			int isvar = si2drSimpleAttrGetIsVar(attr,&err);
+		check_group_correspondence(group, (libsynt_group_info*)toid.v1);
+	}
+}
+
+/* SILIMATE: the cells of a library don't depend on each other, so they are
+   checked on worker threads. Every child of the library gets a slot that
+   collects its messages and error count while it is checked; the slots are
+   replayed in source order afterwards, so the output is the same whatever
+   the thread count. */
+
+#define CHECK_THREAD_STACK (256*1024*1024) /* the checks keep MB-sized buffers on the stack */
+
+union check_arg
+{
+	long i;
+	double d;
+	char *s;
+};
+
+struct check_msg
+{
+	int raw; /* text that went straight to stdout */
+	si2drSeverityT sev;
+	si2drErrorT errToPrint;
+	char *text;
+	const char *fmt; /* with args: a check_report message, text is made on demand */
+	union check_arg *args;
+};
+
+struct check_slot
+{
+	si2drGroupIdT group;
+	int errcount;
+	struct check_msg *msgs;
+	int nmsgs, maxmsgs;
+	uint64_t key; /* content hash of a cell, when there is a check cache */
+	int line;
+	double seconds; /* time spent on a cell, when profiling */
+	int errors; /* ERROR messages */
+	int index;
+	int done;
+	int stopped; /* CHECK_SKIPPED or CHECK_OUT_OF_TIME when not checked all the way */
+	struct timespec start;
+};
+
+#define CHECK_SKIPPED 1
+#define CHECK_OUT_OF_TIME 2
+
+/* SILIMATE: the check cache maps the content hash of every cell to the
+   messages its check produced last time. The hash covers the names,
+   attributes, values, defines and subgroups of the cell (with line numbers
+   relative to the cell), mixed with a hash of everything in the library
+   that is not a cell, so an edit to a template or operating_conditions
+   group invalidates every cell. */
+
+#define CHECK_CACHE_MAGIC "L2JCHKC\n"
+#define CHECK_CACHE_VERSION 1
+
+struct check_cache_entry
+{
+	uint64_t key;
+	int line; /* where the cell started */
+	int errcount;
+	struct check_msg *msgs;
+	int nmsgs;
+};
+
+struct check_cache
+{
+	uint64_t context;
+	struct check_cache_entry *entries; /* sorted by key */
+	int nentries;
+};
+
+struct check_work
+{
+	struct check_slot *slots;
+	int *cells; /* indexes of the cell slots */
+	int ncells;
+	atomic_int next;
+	libsynt_group_info *gi;
+	char *gtype;
+	struct check_cache *cache; /* NULL unless a check cache file was set */
+};
+
+static _Thread_local struct check_slot *curr_check_slot;
+
+static int check_thread_count(void)
+{
+	si2drErrorT err;
+	int n = si2drPIGetCheckThreads(&err);
+	if( n <= 0 )
+		n = sysconf(_SC_NPROCESSORS_ONLN);
+	return n;
+}
+
+static struct check_msg *check_new_msg(struct check_slot *s)
+{
+	struct check_msg *m;
+
+	if( s->nmsgs == s->maxmsgs )
+	{
+		s->maxmsgs = s->maxmsgs ? 2*s->maxmsgs : 8;
+		s->msgs = realloc(s->msgs, s->maxmsgs*sizeof(struct check_msg));
+	}
+	m = &s->msgs[s->nmsgs++];
+	memset(m, 0, sizeof(*m));
+	return m;
+}
+
+static si2drVoidT check_buffer_printer(si2drSeverityT sev, si2drErrorT errToPrint, si2drStringT auxText, si2drErrorT *err)
+{
+	struct check_slot *s = curr_check_slot;
+	struct check_msg *m;
+	
+	*err = SI2DR_NO_ERROR;
+	if( sev < check_min_severity )
+		return;
+	if( sev == SI2DR_SEVERITY_ERR )
+		check_errors++;
+	if( !s )
+	{
+		(*check_real_printer)(sev, errToPrint, auxText, err);
+		return;
+	}
+	m = check_new_msg(s);
+	m->sev = sev;
+	m->errToPrint = errToPrint;
+	m->text = auxText ? strdup(auxText) : NULL;
+}
+
+/* the end of the conversion spec at p (just past the '%'), and the kind of
+   argument it takes: 'i', 'd', 's' or 0 for none (%%) or one not handled */
+static const char *check_spec(const char *p, int *kind)
+{
+	p += strspn(p, "-+ #0");
+	p += strspn(p, "0123456789");
+	if( *p == '.' )
+		p += 1 + strspn(p+1, "0123456789");
+	if( *p == 'l' && p[1] != 'l' )
+		p++;
+	switch( *p )
+	{
+		case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+			*kind = 'i';
+			break;
+		case 'e': case 'E': case 'f': case 'g': case 'G':
+			*kind = p[-1] == 'l' ? 0 : 'd';
+			break;
+		case 's':
+			*kind = p[-1] == 'l' ? 0 : 's';
+			break;
+		default:
+			*kind = 0;
+			break;
+	}
+	return *p ? p+1 : p;
+}
+
+/* SILIMATE: keep a check_report message for later, as its format and a copy
+   of its arguments; 0 when it has to be formatted now (no cell is being
+   checked, or the format has a conversion the copy does not handle) */
+static int check_defer(si2drSeverityT sev, si2drErrorT code, const char *fmt, va_list ap)
+{
+	struct check_slot *s = curr_check_slot;
+	struct check_msg *m;
+	union check_arg *args;
+	const char *p;
+	int n = 0, kind;
+
+	if( !s || MsgPrinter != check_buffer_printer )
+		return 0;
+	for(p=strchr(fmt, '%'); p; p=strchr(p, '%'))
+	{
+		if( p[1] == '%' )
+		{
+			p += 2;
+			continue;
+		}
+		p = check_spec(p+1, &kind);
+		if( !kind )
+			return 0;
+		n++;
+	}
+	args = (union check_arg*)malloc((n ? n : 1)*sizeof(union check_arg));
+	for(n=0, p=strchr(fmt, '%'); p; p=strchr(p, '%'))
+	{
+		if( p[1] == '%' )
+		{
+			p += 2;
+			continue;
+		}
+		p = check_spec(p+1, &kind);
+		if( kind == 'd' )
+			args[n++].d = va_arg(ap, double);
+		else if( kind == 's' )
+		{
+			/* the strings may live in the caller's buffers */
+			char *str = va_arg(ap, char*);
+			args[n++].s = str ? strdup(str) : NULL;
+		}
+		else
+			args[n++].i = p[-2] == 'l' ? va_arg(ap, long) : va_arg(ap, int);
+	}
+	if( sev == SI2DR_SEVERITY_ERR )
+		check_errors++;
+	m = check_new_msg(s);
+	m->sev = sev;
+	m->errToPrint = code;
+	m->fmt = fmt;
+	m->args = args;
+	return 1;
+}
+
+static void check_free_args(struct check_msg *m)
+{
+	const char *p;
+	int n = 0, kind;
+
+	if( !m->fmt )
+		return;
+	for(p=strchr(m->fmt, '%'); p; p=strchr(p, '%'))
+	{
+		if( p[1] == '%' )
+		{
+			p += 2;
+			continue;
+		}
+		p = check_spec(p+1, &kind);
+		if( kind == 's' )
+			free(m->args[n].s);
+		n++;
+	}
+	free(m->args);
+	m->args = NULL;
+	m->fmt = NULL;
+}
+
+/* the text of a message, formatting a deferred one now */
+static char *check_msg_text(struct check_msg *m)
+{
+	char spec[32], *buf = NULL;
+	size_t used = 0, cap = 0, len;
+	const char *p, *q;
+	int n = 0, kind, k;
+
+	if( !m->fmt )
+		return m->text;
+	for(p=m->fmt; *p; p=q)
+	{
+		if( *p != '%' || p[1] == '%' )
+		{
+			q = *p == '%' ? p+2 : p+1+strcspn(p+1, "%");
+			len = *p == '%' ? 1 : (size_t)(q - p);
+			if( used + len + 1 > cap )
+				buf = realloc(buf, cap = 2*(used + len + 1));
+			memcpy(buf + used, p, len);
+			used += len;
+			continue;
+		}
+		q = check_spec(p+1, &kind);
+		len = (size_t)(q - p) < sizeof(spec) ? (size_t)(q - p) : sizeof(spec)-1;
+		memcpy(spec, p, len);
+		spec[len] = 0;
+		for(k=0; k<2; k++)
+		{
+			size_t room = cap - used;
+			int w;
+
+			if( kind == 'd' )
+				w = snprintf(buf ? buf + used : NULL, room, spec, m->args[n].d);
+			else if( kind == 's' )
+				w = snprintf(buf ? buf + used : NULL, room, spec, m->args[n].s);
+			else if( q[-2] == 'l' )
+				w = snprintf(buf ? buf + used : NULL, room, spec, m->args[n].i);
+			else
+				w = snprintf(buf ? buf + used : NULL, room, spec, (int)m->args[n].i);
+			if( w >= 0 && used + w + 1 <= cap )
+			{
+				used += w;
+				break;
+			}
+			buf = realloc(buf, cap = 2*(used + (w > 0 ? w : 0) + 1));
+		}
+		n++;
+	}
+	if( !buf )
+		buf = malloc(1);
+	buf[used] = 0;
+	m->text = buf;
+	check_free_args(m);
+	return m->text;
+}
+
+static void check_print_raw(char *text)
+{
+	struct check_slot *s = curr_check_slot;
+	struct check_msg *m;
+	
+	if( !s )
+	{
+		printf("%s", text);
+		return;
+	}
+	m = check_new_msg(s);
+	m->raw = 1;
+	m->text = strdup(text);
+}
+
+static uint64_t check_hash_bytes(uint64_t h, const void *p, size_t n)
+{
+	const unsigned char *c = (const unsigned char*)p;
+	size_t i;
+	
+	for(i=0; i<n; i++)
+	{
+		h ^= c[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+static uint64_t check_hash_int(uint64_t h, int64_t v)
+{
+	return check_hash_bytes(h, &v, sizeof(v));
+}
+
+static uint64_t check_hash_str(uint64_t h, const char *str)
+{
+	if( !str )
+		return check_hash_int(h, -1);
+	return check_hash_bytes(h, str, strlen(str)+1);
+}
+
+static uint64_t check_hash_value(uint64_t h, si2drValueTypeT type, si2drInt32T i, si2drFloat64T d, si2drStringT str, si2drBooleanT b)
+{
+	h = check_hash_int(h, type);
+	switch( type )
+	{
+	case SI2DR_INT32:
+		return check_hash_int(h, i);
+	case SI2DR_FLOAT64:
+		return check_hash_bytes(h, &d, sizeof(d));
+	case SI2DR_STRING:
+		return check_hash_str(h, str);
+	case SI2DR_BOOLEAN:
+		return check_hash_int(h, b);
+	default:
+		return h;
+	}
+}
+
+static uint64_t check_hash_expr(uint64_t h, si2drExprT *e)
+{
+	if( !e )
+		return check_hash_int(h, -1);
+	h = check_hash_int(h, e->type);
+	if( e->type == SI2DR_EXPR_VAL )
+		h = check_hash_value(h, e->valuetype, e->u.i, e->u.d, e->u.s, e->u.b);
+	h = check_hash_expr(h, e->left);
+	return check_hash_expr(h, e->right);
+}
+
+static uint64_t check_hash_attr(uint64_t h, si2drAttrIdT attr, int base)
+{
+	si2drErrorT err;
+	si2drValueTypeT type;
+	si2drInt32T i;
+	si2drFloat64T d;
+	si2drStringT str;
+	si2drBooleanT b;
+	si2drExprT *e;
+	si2drValuesIdT vals;
+	
+	h = check_hash_str(h, si2drAttrGetName(attr,&err));
+	h = check_hash_int(h, si2drObjectGetLineNo(attr,&err) - base);
+	h = check_hash_int(h, si2drAttrGetAttrType(attr,&err));
+	if( si2drAttrGetAttrType(attr,&err) == SI2DR_SIMPLE )
+	{
+		h = check_hash_int(h, si2drSimpleAttrGetIsVar(attr,&err));
+		type = si2drSimpleAttrGetValueType(attr,&err);
+		switch( type )
+		{
+		case SI2DR_EXPR:
+			return check_hash_expr(check_hash_int(h, type), si2drSimpleAttrGetExprValue(attr,&err));
+		case SI2DR_INT32:
+			return check_hash_value(h, type, si2drSimpleAttrGetInt32Value(attr,&err), 0.0, NULL, 0);
+		case SI2DR_FLOAT64:
+			return check_hash_value(h, type, 0, si2drSimpleAttrGetFloat64Value(attr,&err), NULL, 0);
+		case SI2DR_STRING:
+			return check_hash_value(h, type, 0, 0.0, si2drSimpleAttrGetStringValue(attr,&err), 0);
+		case SI2DR_BOOLEAN:
+			return check_hash_value(h, type, 0, 0.0, NULL, si2drSimpleAttrGetBooleanValue(attr,&err));
+		default:
+			return check_hash_int(h, type);
+		}
+	}
+	vals = si2drComplexAttrGetValues(attr,&err);
+	for(;;)
+	{
+		si2drIterNextComplexValue(vals, &type, &i, &d, &str, &b, &e, &err);
+		if( type == SI2DR_UNDEFINED_VALUETYPE )
+			break;
+		if( type == SI2DR_EXPR )
+			h = check_hash_expr(check_hash_int(h, type), e);
+		else
+			h = check_hash_value(h, type, i, d, str, b);
+	}
+	si2drIterQuit(vals,&err);
+	return check_hash_int(h, SI2DR_UNDEFINED_VALUETYPE);
+}
+
+/* line numbers are hashed relative to base; the cells of the library are
+   left out when skip_cells is set */
+static uint64_t check_hash_group(uint64_t h, si2drGroupIdT group, int base, int skip_cells)
+{
+	si2drErrorT err;
+	si2drNamesIdT names;
+	si2drAttrsIdT attrs;
+	si2drDefinesIdT defs;
+	si2drGroupsIdT groups;
+	si2drStringT str;
+	si2drAttrIdT attr;
+	si2drDefineIdT def;
+	si2drGroupIdT sub;
+	si2drStringT dname, dallowed;
+	si2drValueTypeT dtype;
+	
+	h = check_hash_str(h, si2drGroupGetGroupType(group,&err));
+	h = check_hash_str(h, si2drObjectGetFileName(group,&err));
+	h = check_hash_int(h, si2drObjectGetLineNo(group,&err) - base);
+	
+	names = si2drGroupGetNames(group,&err);
+	while( (str = si2drIterNextName(names,&err)) )
+		h = check_hash_str(h, str);
+	si2drIterQuit(names,&err);
+	h = check_hash_int(h, -2);
+	
+	attrs = si2drGroupGetAttrs(group,&err);
+	while( !si2drObjectIsNull((attr = si2drIterNextAttr(attrs,&err)),&err) )
+		h = check_hash_attr(h, attr, base);
+	si2drIterQuit(attrs,&err);
+	h = check_hash_int(h, -3);
+	
+	defs = si2drGroupGetDefines(group,&err);
+	while( !si2drObjectIsNull((def = si2drIterNextDefine(defs,&err)),&err) )
+	{
+		si2drDefineGetInfo(def, &dname, &dallowed, &dtype, &err);
+		h = check_hash_str(h, dname);
+		h = check_hash_str(h, dallowed);
+		h = check_hash_int(h, dtype);
+	}
+	si2drIterQuit(defs,&err);
+	h = check_hash_int(h, -4);
+	
+	groups = si2drGroupGetGroups(group,&err);
+	while( !si2drObjectIsNull((sub = si2drIterNextGroup(groups,&err)),&err) )
+	{
+		if( skip_cells && si2drGroupGetID(sub,&err) == LIBERTY_GROUPENUM_cell )
+			continue;
+		h = check_hash_group(h, sub, base, 0);
+	}
+	si2drIterQuit(groups,&err);
+	return check_hash_int(h, -5);
+}
+
+static struct check_msg *check_copy_msgs(struct check_msg *msgs, int nmsgs)
+{
+	struct check_msg *copy = (struct check_msg*)malloc((nmsgs ? nmsgs : 1)*sizeof(struct check_msg));
+	int k;
+	
+	for(k=0; k<nmsgs; k++)
+	{
+		char *text = check_msg_text(&msgs[k]);
+
+		copy[k] = msgs[k];
+		copy[k].text = text ? strdup(text) : NULL;
+	}
+	return copy;
+}
+
+static int check_cache_cmp(const void *a, const void *b)
+{
+	uint64_t x = ((const struct check_cache_entry*)a)->key;
+	uint64_t y = ((const struct check_cache_entry*)b)->key;
+	
+	return x < y ? -1 : x > y;
+}
+
+static struct check_cache_entry *check_cache_lookup(struct check_cache *cache, uint64_t key)
+{
+	struct check_cache_entry probe;
+	
+	probe.key = key;
+	return (struct check_cache_entry*)bsearch(&probe, cache->entries, cache->nentries, sizeof(struct check_cache_entry), check_cache_cmp);
+}
+
+static void check_cache_free(struct check_cache *cache)
+{
+	int i, k;
+	
+	for(i=0; i<cache->nentries; i++)
+	{
+		for(k=0; k<cache->entries[i].nmsgs; k++)
+			free(cache->entries[i].msgs[k].text);
+		free(cache->entries[i].msgs);
+	}
+	free(cache->entries);
+	cache->entries = NULL;
+	cache->nentries = 0;
+}
+
+static int check_cache_read_int(FILE *f, int32_t *v)
+{
+	return fread(v, sizeof(*v), 1, f) == 1;
+}
+
+/* a missing, stale or damaged file just leaves the cache empty */
+static void check_cache_load(struct check_cache *cache, char *filename)
+{
+	FILE *f = fopen(filename, "rb");
+	char magic[8];
+	int32_t version, n, k, nmsgs, len, v[3];
+	uint64_t context;
+	struct check_cache_entry *e;
+	
+	cache->entries = NULL;
+	cache->nentries = 0;
+	if( !f )
+		return;
+	if( fread(magic, 8, 1, f) != 1 || memcmp(magic, CHECK_CACHE_MAGIC, 8)
+		|| !check_cache_read_int(f, &version) || version != CHECK_CACHE_VERSION
+		|| fread(&context, sizeof(context), 1, f) != 1 || context != cache->context
+		|| !check_cache_read_int(f, &n) || n < 0 )
+	{
+		fclose(f);
+		return;
+	}
+	cache->entries = (struct check_cache_entry*)calloc(n ? n : 1, sizeof(struct check_cache_entry));
+	for(cache->nentries=0; cache->nentries < n; cache->nentries++)
+	{
+		e = &cache->entries[cache->nentries];
+		if( fread(&e->key, sizeof(e->key), 1, f) != 1 || fread(v, sizeof(int32_t), 3, f) != 3 || v[2] < 0 )
+			break;
+		e->line = v[0];
+		e->errcount = v[1];
+		nmsgs = v[2];
+		e->msgs = (struct check_msg*)calloc(nmsgs ? nmsgs : 1, sizeof(struct check_msg));
+		for(k=0; k<nmsgs; k++, e->nmsgs++)
+		{
+			if( fread(v, sizeof(int32_t), 3, f) != 3 || !check_cache_read_int(f, &len) || len < 0 )
+				break;
+			e->msgs[k].raw = v[0];
+			e->msgs[k].sev = (si2drSeverityT)v[1];
+			e->msgs[k].errToPrint = (si2drErrorT)v[2];
+			e->msgs[k].text = (char*)malloc(len+1);
+			if( len && fread(e->msgs[k].text, len, 1, f) != 1 )
+			{
+				free(e->msgs[k].text);
+				break;
+			}
+			e->msgs[k].text[len] = 0;
+		}
+		if( k < nmsgs )
+			break;
+	}
+	if( cache->nentries < n )
+		check_cache_free(cache);
+	else
+		qsort(cache->entries, cache->nentries, sizeof(struct check_cache_entry), check_cache_cmp);
+	fclose(f);
+}
+
+/* the cells of this run replace whatever was in the file */
+static int check_cache_save(struct check_cache *cache, char *filename, struct check_slot *slots, int nslots)
+{
+	char *tmp = (char*)malloc(strlen(filename)+32);
+	FILE *f;
+	int32_t version = CHECK_CACHE_VERSION, n = 0, v[4];
+	int i, k, ok;
+	
+	sprintf(tmp, "%s.tmp.%d", filename, (int)getpid());
+	f = fopen(tmp, "wb");
+	for(i=0; i<nslots; i++)
+		if( slots[i].key )
+			n++;
+	ok = f && fwrite(CHECK_CACHE_MAGIC, 8, 1, f) == 1 && fwrite(&version, sizeof(version), 1, f) == 1
+		&& fwrite(&cache->context, sizeof(cache->context), 1, f) == 1 && fwrite(&n, sizeof(n), 1, f) == 1;
+	for(i=0; ok && i<nslots; i++)
+	{
+		if( !slots[i].key )
+			continue;
+		v[0] = slots[i].line;
+		v[1] = slots[i].errcount;
+		v[2] = slots[i].nmsgs;
+		ok = fwrite(&slots[i].key, sizeof(slots[i].key), 1, f) == 1 && fwrite(v, sizeof(int32_t), 3, f) == 3;
+		for(k=0; ok && k<slots[i].nmsgs; k++)
+		{
+			check_msg_text(&slots[i].msgs[k]);
+			v[0] = slots[i].msgs[k].raw;
+			v[1] = slots[i].msgs[k].raw ? 0 : slots[i].msgs[k].sev;
+			v[2] = slots[i].msgs[k].raw ? 0 : slots[i].msgs[k].errToPrint;
+			v[3] = slots[i].msgs[k].text ? strlen(slots[i].msgs[k].text) : 0;
+			ok = fwrite(v, sizeof(int32_t), 4, f) == 4 && (!v[3] || fwrite(slots[i].msgs[k].text, v[3], 1, f) == 1);
+		}
+	}
+	if( f && fclose(f) )
+		ok = 0;
+	if( !ok || rename(tmp, filename) )
+	{
+		remove(tmp);
+		ok = 0;
+	}
+	free(tmp);
+	return ok;
+}
+
+/* SILIMATE: check profile counters are kept per thread and added to the
+   totals when a thread is done, so the timed calls take no lock */
+
+struct check_profile_counter
+{
+	long calls;
+	long groups; /* distinct groups the routine was called for */
+	double seconds;
+	void *last;
+};
+
+struct check_profile_cell
+{
+	char *name;
+	char *file;
+	int line;
+	double seconds;
+};
+
+static const char *check_profile_names[CHECK_ROUTINE_COUNT] =
+{
+#define X(fn, category) #fn,
+	CHECK_ROUTINE_LIST
+#undef X
+};
+
+static _Thread_local struct check_profile_counter check_profile_local[CHECK_ROUTINE_COUNT];
+static struct check_profile_counter check_profile_totals[CHECK_ROUTINE_COUNT];
+static pthread_mutex_t check_profile_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct check_profile_cell *check_profile_cells; /* the slowest, slowest first */
+static int check_profile_ncells, check_profile_maxcells, check_profile_cellcount;
+
+static double check_profile_since(struct timespec *start)
+{
+	struct timespec now;
+	
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec)*1e-9;
+}
+
+static void check_profile_record(enum check_routine_id id, void *group, struct timespec *start)
+{
+	struct check_profile_counter *c = &check_profile_local[id];
+	
+	c->seconds += check_profile_since(start);
+	c->calls++;
+	if( c->last != group )
+	{
+		c->last = group;
+		c->groups++;
+	}
+}
+
+static void check_profile_flush(void)
+{
+	int i;
+	
+	pthread_mutex_lock(&check_profile_mutex);
+	for(i=0; i<CHECK_ROUTINE_COUNT; i++)
+	{
+		check_profile_totals[i].calls += check_profile_local[i].calls;
+		check_profile_totals[i].groups += check_profile_local[i].groups;
+		check_profile_totals[i].seconds += check_profile_local[i].seconds;
+	}
+	pthread_mutex_unlock(&check_profile_mutex);
+	memset(check_profile_local, 0, sizeof(check_profile_local));
+}
+
+static void check_profile_add_cell(si2drGroupIdT cell, double seconds)
+{
+	si2drErrorT err;
+	int i;
+	
+	check_profile_cellcount++;
+	if( check_profile_ncells == check_profile_maxcells
+		&& (!check_profile_ncells || check_profile_cells[check_profile_ncells-1].seconds >= seconds) )
+		return;
+	if( check_profile_ncells < check_profile_maxcells )
+		check_profile_ncells++;
+	for(i=check_profile_ncells-1; i>0 && check_profile_cells[i-1].seconds < seconds; i--)
+		check_profile_cells[i] = check_profile_cells[i-1];
+	check_profile_cells[i].name = get_first_group_name(cell);
+	check_profile_cells[i].file = si2drObjectGetFileName(cell,&err);
+	check_profile_cells[i].line = si2drObjectGetLineNo(cell,&err);
+	check_profile_cells[i].seconds = seconds;
+}
+
+static int check_profile_cmp(const void *a, const void *b)
+{
+	double x = check_profile_totals[*(const int*)a].seconds;
+	double y = check_profile_totals[*(const int*)b].seconds;
+	
+	return x < y ? 1 : x > y ? -1 : 0;
+}
+
+static void check_profile_json_string(FILE *f, const char *str)
+{
+	fputc('"', f);
+	for(; str && *str; str++)
+	{
+		if( *str == '"' || *str == '\\' )
+			fprintf(f, "\\%c", *str);
+		else if( (unsigned char)*str < 0x20 )
+			fprintf(f, "\\u%04x", *str);
+		else
+			fputc(*str, f);
+	}
+	fputc('"', f);
+}
+
+/* the report goes to stderr, so it doesn't mix with the messages */
+static void check_profile_report(char *format, double seconds)
+{
+	int order[CHECK_ROUTINE_COUNT], i, n = 0;
+	int json = !strcmp(format, "json");
+	
+	for(i=0; i<CHECK_ROUTINE_COUNT; i++)
+		if( check_profile_totals[i].calls )
+			order[n++] = i;
+	qsort(order, n, sizeof(int), check_profile_cmp);
+	
+	if( json )
+	{
+		fprintf(stderr, "{\"seconds\": %.6f, \"cells\": %d, \"checks\": [", seconds, check_profile_cellcount);
+		for(i=0; i<n; i++)
+			fprintf(stderr, "%s\n  {\"name\": \"%s\", \"calls\": %ld, \"groups\": %ld, \"seconds\": %.6f}",
+					i ? "," : "", check_profile_names[order[i]], check_profile_totals[order[i]].calls,
+					check_profile_totals[order[i]].groups, check_profile_totals[order[i]].seconds);
+		fprintf(stderr, "],\n \"slowest_cells\": [");
+		for(i=0; i<check_profile_ncells; i++)
+		{
+			fprintf(stderr, "%s\n  {\"name\": ", i ? "," : "");
+			check_profile_json_string(stderr, check_profile_cells[i].name);
+			fprintf(stderr, ", \"file\": ");
+			check_profile_json_string(stderr, check_profile_cells[i].file);
+			fprintf(stderr, ", \"line\": %d, \"seconds\": %.6f}", check_profile_cells[i].line, check_profile_cells[i].seconds);
+		}
+		fprintf(stderr, "]}\n");
+		return;
+	}
+	fprintf(stderr, "Check profile: %.3f s, %d cells\n", seconds, check_profile_cellcount);
+	fprintf(stderr, "%-36s %10s %10s %12s %10s\n", "check", "calls", "groups", "total ms", "mean us");
+	for(i=0; i<n; i++)
+		fprintf(stderr, "%-36s %10ld %10ld %12.3f %10.3f\n", check_profile_names[order[i]],
+				check_profile_totals[order[i]].calls, check_profile_totals[order[i]].groups,
+				check_profile_totals[order[i]].seconds*1e3,
+				check_profile_totals[order[i]].seconds*1e6/check_profile_totals[order[i]].calls);
+	if( check_profile_ncells )
+		fprintf(stderr, "Slowest cells:\n%12s  %s\n", "ms", "cell");
+	for(i=0; i<check_profile_ncells; i++)
+		fprintf(stderr, "%12.3f  %s (%s:%d)\n", check_profile_cells[i].seconds*1e3,
+				check_profile_cells[i].name ? check_profile_cells[i].name : "",
+				check_profile_cells[i].file ? check_profile_cells[i].file : "", check_profile_cells[i].line);
+}
+
+static void check_profile_start(void)
+{
+	si2drErrorT err;
+	
+	check_profiling = si2drPIGetCheckProfile(&err) != NULL;
+	if( !check_profiling )
+		return;
+	memset(check_profile_totals, 0, sizeof(check_profile_totals));
+	memset(check_profile_local, 0, sizeof(check_profile_local));
+	check_profile_maxcells = si2drPIGetCheckProfileCells(&err);
+	check_profile_cells = (struct check_profile_cell*)calloc(check_profile_maxcells ? check_profile_maxcells : 1, sizeof(struct check_profile_cell));
+	check_profile_ncells = 0;
+	check_profile_cellcount = 0;
+}
+
+static void check_profile_finish(double seconds)
+{
+	si2drErrorT err;
+	
+	if( !check_profiling )
+		return;
+	check_profile_flush();
+	check_profile_report(si2drPIGetCheckProfile(&err), seconds);
+	free(check_profile_cells);
+	check_profile_cells = NULL;
+	check_profiling = 0;
+}
+
+/* SILIMATE: with a maximum error count, the slots are replayed only up to
+   the one that reaches it. check_done_errors counts the errors before
+   check_done_slots, the run of slots from the first that are all done; a
+   slot at or after that point is not worth checking once the count is
+   reached, since it will not be replayed anyway. */
+
+static struct check_slot *check_done_list;
+static int check_done_nslots;
+static atomic_int check_done_slots;
+static atomic_int check_done_errors;
+static pthread_mutex_t check_done_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static int check_past_error_limit(int index)
+{
+	/* the frontier moves before the count does, so the count read here never
+	   includes the errors of a slot at or after the frontier read next */
+	int errors = atomic_load(&check_done_errors);
+	
+	return check_max_errors && errors >= check_max_errors && index >= atomic_load(&check_done_slots);
+}
+
+static void check_slot_done(struct check_slot *s)
+{
+	int f;
+	
+	if( !check_max_errors )
+		return;
+	pthread_mutex_lock(&check_done_mutex);
+	s->done = 1;
+	for(f=atomic_load(&check_done_slots); f < check_done_nslots && check_done_list[f].done; f++)
+	{
+		atomic_store(&check_done_slots, f+1);
+		atomic_fetch_add(&check_done_errors, check_done_list[f].errors);
+	}
+	pthread_mutex_unlock(&check_done_mutex);
+}
+
+/* polled between attributes and groups; true once the rest of the current
+   group should not be checked */
+static int check_stop(void)
+{
+	struct check_slot *s = curr_check_slot;
+	
+	if( !check_max_errors && check_cell_budget <= 0 )
+		return 0;
+	if( check_max_errors && check_errors >= check_max_errors )
+		return 1;
+	if( !s )
+		return 0;
+	if( !s->stopped && check_past_error_limit(s->index) )
+		s->stopped = CHECK_SKIPPED;
+	if( !s->stopped && check_cell_budget > 0 && check_profile_since(&s->start) > check_cell_budget )
+		s->stopped = CHECK_OUT_OF_TIME;
+	return s->stopped;
+}
+
+static void check_run_slot(struct check_slot *s, libsynt_group_info *gi, char *gtype, struct check_cache *cache)
+{
+	struct check_cache_entry *e;
+	si2drErrorT err;
+	struct timespec start;
+	int k;
+	
+	if( check_past_error_limit(s->index) )
+	{
+		s->stopped = CHECK_SKIPPED;
+		check_slot_done(s);
+		return;
+	}
+	if( check_profiling )
+		clock_gettime(CLOCK_MONOTONIC, &start);
+	if( check_cell_budget > 0 )
+		clock_gettime(CLOCK_MONOTONIC, &s->start);
+	if( cache )
+	{
+		s->line = si2drObjectGetLineNo(s->group,&err);
+		s->key = check_hash_group(cache->context, s->group, s->line, 0);
+		if( !s->key )
+			s->key = 1; /* 0 marks slots that are not cached */
+		e = check_cache_lookup(cache, s->key);
+		/* a cell that moved is checked again if it reported anything, since
+		   the messages carry line numbers */
+		if( e && (e->line == s->line || !e->nmsgs) )
+		{
+			s->msgs = check_copy_msgs(e->msgs, e->nmsgs);
+			s->nmsgs = s->maxmsgs = e->nmsgs;
+			s->errcount = e->errcount;
+			for(k=0; k<s->nmsgs; k++)
+				if( !s->msgs[k].raw && s->msgs[k].sev == SI2DR_SEVERITY_ERR )
+					s->errors++;
+			if( check_profiling )
+				s->seconds = check_profile_since(&start);
+			check_slot_done(s);
+			return;
+		}
+	}
+	curr_check_slot = s;
+	errcount = 0;
+	check_errors = 0;
+	check_subgroup_correspondence(s->group, gi, gtype);
+	if( s->stopped == CHECK_OUT_OF_TIME )
+	{
+		check_report(SI2DR_SEVERITY_WARN, SI2DR_NO_ERROR, "%s:%d, Stopped checking the %s group %s after %g ms.",
+				si2drObjectGetFileName(s->group,&err), (int)si2drObjectGetLineNo(s->group,&err),
+				si2drGroupGetGroupType(s->group,&err), get_first_group_name(s->group), check_cell_budget*1e3);
+	}
+	s->errcount = errcount;
+	s->errors = check_errors;
+	errcount = 0;
+	check_errors = 0;
+	curr_check_slot = NULL;
+	if( check_profiling )
+		s->seconds = check_profile_since(&start);
+	check_slot_done(s);
+}
+
+static void *check_worker(void *arg)
+{
+	struct check_work *w = (struct check_work*)arg;
+	int i;
+	
+	while( (i = atomic_fetch_add(&w->next, 1)) < w->ncells )
+		check_run_slot(&w->slots[w->cells[i]], w->gi, w->gtype, w->cache);
+	if( check_profiling )
+		check_profile_flush();
+	return NULL;
+}
+
+static void check_library_children( si2drGroupIdT lib, si2drGroupsIdT groups, libsynt_group_info *gi, char *gtype )
+{
+	si2drErrorT err;
+	si2drGroupIdT group;
+	struct check_work w;
+	struct check_cache cache;
+	char *cachefile = si2drPIGetCheckCache(&err);
+	struct check_slot *slots = NULL;
+	int nslots = 0, maxslots = 0, nthreads = check_thread_count(), started = 0, saved = errcount, errors = check_errors, cached = 1, reported, i, k;
+	pthread_t *threads;
+	pthread_attr_t attr;
+
+	while( !(si2drObjectIsNull((group = si2drIterNextGroup(groups,&err) ), &err)) )
+	{
+		if( nslots == maxslots )
+		{
+			maxslots = maxslots ? 2*maxslots : 64;
+			slots = realloc(slots, maxslots*sizeof(struct check_slot));
+		}
+		memset(&slots[nslots], 0, sizeof(struct check_slot));
+		slots[nslots].index = nslots;
+		slots[nslots++].group = group;
+	}
+	reported = nslots;
+	check_done_list = slots;
+	check_done_nslots = nslots;
+	atomic_store(&check_done_slots, 0);
+	atomic_store(&check_done_errors, check_errors);
+	
+	/* everything but the cells is checked here first; some of those checks keep
+	   state of their own (operating_conds_checked) */
+	w.slots = slots;
+	w.cells = (int*)malloc((nslots ? nslots : 1)*sizeof(int));
+	w.ncells = 0;
+	w.gi = gi;
+	w.gtype = gtype;
+	w.cache = NULL;
+	atomic_init(&w.next, 0);
+	if( cachefile )
+	{
+		uint64_t h = check_hash_int(14695981039346656037ULL, CHECK_CACHE_VERSION);
+		h = check_hash_int(h, check_categories);
+		h = check_hash_int(h, check_min_severity);
+		cache.context = check_hash_group(h, lib, 0, 1);
+		check_cache_load(&cache, cachefile);
+		w.cache = &cache;
+	}
+	for(i=0; i<nslots; i++)
+	{
+		if( si2drGroupGetID(slots[i].group,&err) == LIBERTY_GROUPENUM_cell )
+			w.cells[w.ncells++] = i;
+		else
+			check_run_slot(&slots[i], gi, gtype, NULL);
+	}
+
+	/* the calling thread is one of the workers */
+	if( nthreads > w.ncells )
+		nthreads = w.ncells;
+	threads = (pthread_t*)malloc((nthreads ? nthreads : 1)*sizeof(pthread_t));
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, CHECK_THREAD_STACK);
+	for(started=0; started < nthreads-1; started++)
+	{
+		if( pthread_create(&threads[started], &attr, check_worker, &w) )
+			break; /* whoever is running picks up the rest */
+	}
+	pthread_attr_destroy(&attr);
+	check_worker(&w);
+	for(i=0; i<started; i++)
+		pthread_join(threads[i], NULL);
+	free(threads);
+	if( check_profiling )
+		for(i=0; i<w.ncells; i++)
+			check_profile_add_cell(slots[w.cells[i]].group, slots[w.cells[i]].seconds);
+	free(w.cells);
+
+	if( cachefile )
+	{
+		for(i=0; i<nslots; i++)
+			if( slots[i].stopped )
+				slots[i].key = 0; /* only what was checked all the way is cached */
+		check_cache_free(&cache);
+		cached = check_cache_save(&cache, cachefile, slots, nslots);
+	}
+	errcount = saved;
+	if( check_max_errors )
+	{
+		/* up to the slot that reaches the limit */
+		for(reported=0; reported < nslots && errors < check_max_errors; reported++)
+			errors += slots[reported].errors;
+	}
+	else
+		for(i=0; i<nslots; i++)
+			errors += slots[i].errors;
+	for(i=0; i<nslots; i++)
+	{
+		for(k=0; k<slots[i].nmsgs; k++)
+		{
+			if( i < reported )
+			{
+				if( slots[i].msgs[k].raw )
+					printf("%s", slots[i].msgs[k].text);
+				else
+					(*MsgPrinter)(slots[i].msgs[k].sev, slots[i].msgs[k].errToPrint, check_msg_text(&slots[i].msgs[k]), &err);
+			}
+			check_free_args(&slots[i].msgs[k]);
+			free(slots[i].msgs[k].text);
+		}
+		free(slots[i].msgs);
+		if( i < reported )
+			errcount += slots[i].errcount;
+	}
+	check_errors = errors;
+	if( reported < nslots )
+	{
+		check_report(SI2DR_SEVERITY_NOTE, SI2DR_NO_ERROR, "Stopped after %d errors (the limit is %d); the last %d groups of the library were not checked.",
+				errors, check_max_errors, nslots-reported);
+	}
+	free(slots);
+	check_done_list = NULL;
+	if( !cached )
+	{
+		check_report(SI2DR_SEVERITY_WARN, SI2DR_INTERNAL_SYSTEM_ERROR, "Could not write the check cache %s.", cachefile);
+	}
+}
+
+void check_group_correspondence( si2drGroupIdT g, libsynt_group_info *gi )
+{
+	int nc;
+	si2drNamesIdT names;
+	si2drErrorT err;
+	si2drStringT str;
+	si2drAttrIdT attr;
+	si2drAttrsIdT attrs;
+	si2drGroupIdT group;
+	si2drGroupsIdT groups;
+	
+	int gl   = si2drObjectGetLineNo(g,&err);
+	char *gf = si2drObjectGetFileName(g,&err);
+	char gtype[SI2DR_MAX_STRING_LEN];
+	
+	/* check all group attributes, including names, etc. to constraints */
+
+	if( gi && gi->ref )
+		gi = gi->ref;
+	
+	strcpy( gtype, si2drGroupGetGroupType(g,&err) );
+	
+	/* names */
+	nc = 0;
+	names = si2drGroupGetNames(g, &err);
+	while( (str = si2drIterNextName(names,&err)) )
+	{
+		nc++;
+	}
+	si2drIterQuit(names,&err);
+
+	if( gi )
+	{
+		
+		switch( gi->name_constraints )
+		{
+		case SYNTAX_GNAME_NONE:
+			if( nc > 0 )
+			{
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The %s group in this context is not supposed to have any names, but %d name(s) is(are) there.",
+					   gf, gl, gtype, nc);
+				errcount++;
+			}
+			break;
+		case SYNTAX_GNAME_ONE:
+			if( nc != 1 )
+			{
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The %s group in this context should have 1 name, but %d names are there.",
+					   gf, gl, gtype, nc);
+				errcount++;
+			}
+			break;
+		case SYNTAX_GNAME_TWO:
+			if( nc != 2 )
+			{
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The %s group in this context should have 2 nams, but %d name(s) is(are) there.",
+					   gf, gl, gtype, nc);
+				errcount++;
+			}
+			break;
+		case SYNTAX_GNAME_THREE:
+			if( nc != 3 )
+			{
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The %s group in this context should have 3 nams, but %d name(s) is(are) there.",
+					   gf, gl, gtype, nc);
+				errcount++;
+			}
+			break;
+		case SYNTAX_GNAME_NONE_OR_ONE:
+			if( nc != 1 && nc != 0 )
+			{
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The %s group in this context should have 0 or 1 names, but %d names are there.",
+					   gf, gl, gtype, nc);
+				errcount++;
+			}
+			break;
+		case SYNTAX_GNAME_ONE_OR_MORE:
+			if( nc == 0  )
+			{
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The %s group in this context should have 1 or more names, but no names are there.",
+					   gf, gl, gtype);
+				errcount++;
+			}
+			break;
+		}
+	}
+	
+	/* attrs */
+	attrs = si2drGroupGetAttrs(g, &err);
+	while( !check_stop() && !(si2drObjectIsNull((attr = si2drIterNextAttr(attrs,&err) ), &err)) )
+	{
+		si2drStringT anam = si2drAttrGetName(attr,&err);
+		si2drAttrTypeT at = si2drAttrGetAttrType(attr,&err);
+		si2drObjectIdT toid;
+		int al = si2drObjectGetLineNo(attr,&err);
+		char *af = si2drObjectGetFileName(attr,&err);
+		
+		toid.v1 = NULL;
+		
+		if( at == SI2DR_SIMPLE )
+		{
+			int isvar = si2drSimpleAttrGetIsVar(attr,&err);
 		
 			if( isvar ) /* don't check a variable definition */
 				continue;
@@ -6524,7 +7210,7 @@ void check_group_correspondence( si2drGroupIdT g, libsynt_group_info *gi )
 		}
 		
 		if( gi )
-			liberty_hash_lookup(gi->attr_hash, anam, &toid);
+			toid.v1 = syntax_attr_info(gi, attr, anam);
 		
 		if( toid.v1 == NULL )
 		{
@@ -6537,11 +7223,8 @@ void check_group_correspondence( si2drGroupIdT g, libsynt_group_info *gi )
 			def = si2drPIFindDefineByName(anam, &err);
 			if( err != SI2DR_NO_ERROR )
 			{
-				sprintf(EB,"%s:%d, The %s attribute is not allowed in the %s group in this context.",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, "%s:%d, The %s attribute is not allowed in the %s group in this context.",
 					   af ? af : "", al, anam, gtype);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 			}
 			else
@@ -6572,21 +7255,15 @@ void check_group_correspondence( si2drGroupIdT g, libsynt_group_info *gi )
 					}
 					if( !found )
 					{
-						sprintf(EB,"%s:%d, The %s attribute was defined to be used in the %s group, not the %s group.",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The %s attribute was defined to be used in the %s group, not the %s group.",
 							   af ? af : "", al, anam, allowed_group, gtype);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 				}
 				if( t != SI2DR_SIMPLE )
 				{
-					sprintf(EB,"%s:%d, The %s attribute was defined and needs to used as a simple attribute.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The %s attribute was defined and needs to used as a simple attribute.",
 						   af ? af : "", al, anam);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 				}
 				/* #ifdef DONT_VERIFY_DEFINE_ATTRIBUTE_TYPE */
@@ -6602,51 +7279,36 @@ void check_group_correspondence( si2drGroupIdT g, libsynt_group_info *gi )
 							e = si2drSimpleAttrGetExprValue(attr,&err);
 							if( e->valuetype != SI2DR_STRING)
 							{
-								sprintf(EB,"%s:%d, The %s attribute should be of type String.(See the define at line %d of file %s.)",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The %s attribute should be of type String.(See the define at line %d of file %s.)",
 										af ? af : "", al, anam,dl,df);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 							
 						}
 						else
 						{
-							sprintf(EB,"%s:%d, The %s attribute should be of type String.(See the define at line %d of file %s.)",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The %s attribute should be of type String.(See the define at line %d of file %s.)",
 									af ? af : "", al, anam,dl,df);
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-										  EB, 
-										  &err);
 							errcount++;
 						}
 					}
 					if( valtype != SI2DR_STRING && vt == SI2DR_STRING )
 					{
-						sprintf(EB,"%s:%d, The %s attribute should not be of type String.(See the define at line %d of file %s.)",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The %s attribute should not be of type String.(See the define at line %d of file %s.)",
 							   af ? af : "", al, anam,dl,df);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 					if( valtype == SI2DR_INT32 && vt != SI2DR_INT32 )
 					{
-						sprintf(EB,"%s:%d, The %s attribute should be of type 'integer'.(See the define at line %d of file %s.)",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The %s attribute should be of type 'integer'.(See the define at line %d of file %s.)",
 								af ? af : "", al, anam, dl, df);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 
 					if( valtype == SI2DR_FLOAT64 && vt != SI2DR_FLOAT64 && vt != SI2DR_INT32 )
 					{
-						sprintf(EB,"%s:%d, The %s attribute should be of type 'float'.(See the define at line %d of file %s.)",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, The %s attribute should be of type 'float'.(See the define at line %d of file %s.)",
 								af ? af : "", al, anam, dl, df);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 				}
@@ -6655,7 +7317,7 @@ void check_group_correspondence( si2drGroupIdT g, libsynt_group_info *gi )
 		}
 		else
 		{
-			check_attr_correspondence(attr, (libsynt_attribute_info*)toid.v1);
+			CHECK_CALL(check_attr_correspondence, g, attr, (libsynt_attribute_info*)toid.v1);
 		}
 	}
 	si2drIterQuit(attrs,&err);
@@ -6663,126 +7325,15 @@ void check_group_correspondence( si2drGroupIdT g, libsynt_group_info *gi )
 	
 	/* subgroups */
 	groups = si2drGroupGetGroups(g, &err);
-	while( !(si2drObjectIsNull((group = si2drIterNextGroup(groups,&err) ), &err)) )
-	{
-		si2drStringT gt = si2drGroupGetGroupType(group,&err);
-		si2drObjectIdT toid;
-		int al = si2drObjectGetLineNo(group,&err);
-		char *af = si2drObjectGetFileName(group,&err);
-
-		toid.v1 = NULL;
-		
-		if( gi )
-			liberty_hash_lookup(gi->group_hash, gt, &toid);
-
-		if( toid.v1 == NULL )
-		{
-			si2drDefineIdT def;
-			/* check to see if a define_group is defined for this situation */
-			def = si2drPIFindDefineByName(gt, &err);
-			if( err != SI2DR_NO_ERROR )
-			{
-				sprintf(EB,"%s:%d, The %s group is not allowed in the %s group in this context.",
-					   af ? af : "", al, gt, gtype);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-							  EB, 
-							  &err);
-				errcount++;
-			}
-			else
-			{
-				si2drStringT grname, grall;
-				si2drValueTypeT grval;
-				char *allowedParents;
-				char *nextParent;
-				int groupInListOfParents = 0;
-				
-				si2drDefineGetInfo( def,
-									&grname,
-									&grall,
-									&grval,
-									&err);
-
-				/* the following code is a fix provided by David Mallis of SI2 */
-				/* many thanks, David! */
-
-				/* If group allowed in > 1 parents, grall comes in as "grp1|grp2|..."
-				// The original check "strcmp(grall,gtype)" only works if there is only 1.
-				// Instead, it is necessary to loop through the grall entries checking
-				// each one against the current parent group.
-				//
-				// See if this group is allowed in its parent by its define_group statement.
-				// - allowedParents must be turned to NULL for subsequent calls to strtok.
-				// - strdup the grall so strtok's NULL planting on delims doesn't hose it.
-				*/
-
-				allowedParents = strdup(grall);
-				nextParent=allowedParents;
-				do
-				{
-					char *sep = strchr(nextParent,'|');
-					if( sep )
-						*sep = 0;
-					if ( !strcmp(nextParent,gtype) )
-					{
-						groupInListOfParents = 1;
-						break;
-					}
-					if( sep )
-						nextParent = sep+1;
-					else
-						nextParent = NULL;
-				} while ( nextParent );
-				free(allowedParents);
-            allowedParents = NULL;
-				/* Synopsys infopop user Roman reports that the original version of the
-				   above code would leak allowedParents. He offered a variation that
-				   would eliminate the problem.
-				   I decided to modify the above to eliminate the use of strtok, whose
-				   linux man page advises "Never use these functions.", giving some 
-				   reasons, and this was a perfect example of why not.
-				*/
-
-				if( grval == SI2DR_UNDEFINED_VALUETYPE )
-				{
-					/* if this is a group, I hear it MUST have at least one name associated with it! */
-					si2drErrorT err;
-					si2drStringT str;
-					si2drNamesIdT names;
-					names = si2drGroupGetNames(group,&err);
-					str = si2drIterNextName(names,&err);
-					if (!str || !str[0] )
-					{
-						sprintf(EB,"%s:%d, The %s group (a user defined group) should have a name associated with it .",
-								af ? af : "", al, gt);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-									  EB, 
-									  &err);
-						errcount++;
-					}
-					si2drIterQuit(names,&err);
-				}
-				if( !groupInListOfParents && grval == SI2DR_UNDEFINED_VALUETYPE ) /* OLD TEST: if( strcmp(grall,gtype) && grval == SI2DR_UNDEFINED_VALUETYPE ) */
-				{
-					sprintf(EB,"%s:%d, The %s group is allowed in the %s group, but not allowed in the %s group in this case.",
-						   af ? af : "", al, gt, grall, gtype);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SEMANTIC_ERROR, 
-								  EB, 
-								  &err);
-					errcount++;
-				}
-				else
-					check_group_correspondence(group, (libsynt_group_info*)toid.v1);
-					
-			}
-		}
-		else
-		{
-			check_group_correspondence(group, (libsynt_group_info*)toid.v1);
-		}
-	}
+	if( gi && si2drGroupGetID(g,&err) == LIBERTY_GROUPENUM_library
+		&& (check_thread_count() > 1 || si2drPIGetCheckCache(&err) || check_profiling
+			|| check_max_errors || check_cell_budget > 0) )
+		check_library_children(g, groups, gi, gtype);
+	else
+		while( !check_stop() && !(si2drObjectIsNull((group = si2drIterNextGroup(groups,&err) ), &err)) )
+			check_subgroup_correspondence(group, gi, gtype);
 	si2drIterQuit(groups,&err);
-	if( gi )
+	if( gi && !check_stop() )
 		group_specific_checks( g );
 }
 
@@ -6807,11 +7358,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 			ai->type == SYNTAX_ATTRTYPE_COMPLEX_UNKNOWN ||
 			ai->type == SYNTAX_ATTRTYPE_COMPLEX_LIST )
 		{
-			sprintf(EB,"%s:%d, Attribute %s should be complex, but is simple here.",
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s should be complex, but is simple here.",
 				   af ? af : "", al, aname);
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 		}
 		else
@@ -6839,11 +7387,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 				switch( ai->type )
 				{
 				case SYNTAX_ATTRTYPE_STRING:
-					sprintf(EB,"%s:%d, Attribute %s should be a string Attribute, but is integer instead.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s should be a string Attribute, but is integer instead.",
 						   af ? af : "", al, aname);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 					break;
 					
@@ -6854,11 +7399,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 						{
 							if( intgr < ai->u.intcon->greater_than )
 							{
-								sprintf(EB,"%s:%d, Attribute %s has value %d, but it should be greater than %d.",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s has value %d, but it should be greater than %d.",
 									   af ? af : "", al, aname, (int)intgr, ai->u.intcon->greater_than);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 						}
@@ -6866,11 +7408,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 						{
 							if( intgr > ai->u.intcon->less_than )
 							{
-								sprintf(EB,"%s:%d, Attribute %s has value %d, but it should be less than %d.",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s has value %d, but it should be less than %d.",
 									   af ? af : "", al, aname, (int)intgr, ai->u.intcon->less_than);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 						}
@@ -6884,11 +7423,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 						{
 							if( (double)intgr < ai->u.floatcon->greater_than )
 							{
-								sprintf(EB,"%s:%d, Attribute %s has value %d, but it should be greater than %g.",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s has value %d, but it should be greater than %g.",
 									   af ? af : "", al, aname, (int)intgr, ai->u.floatcon->greater_than);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 						}
@@ -6896,11 +7432,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 						{
 							if( (double)intgr > ai->u.floatcon->less_than )
 							{
-								sprintf(EB,"%s:%d, Attribute %s has value %d, but it should be less than %g.",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s has value %d, but it should be less than %g.",
 									   af ? af : "", al, aname, (int)intgr, ai->u.floatcon->less_than);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 						}
@@ -6910,21 +7443,15 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 				case SYNTAX_ATTRTYPE_VIRTUAL:
 					break;
 				case SYNTAX_ATTRTYPE_BOOLEAN:
-					sprintf(EB,"%s:%d, Attribute %s should be a boolean Attribute, but is integer instead.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s should be a boolean Attribute, but is integer instead.",
 						   af ? af : "", al, aname);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 					break;
 					
 					
 				case SYNTAX_ATTRTYPE_ENUM:
-					sprintf(EB,"%s:%d, Attribute %s should be a string Attribute, but is integer instead.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s should be a string Attribute, but is integer instead.",
 						   af ? af : "", al, aname);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 					break;
 				default:
@@ -6956,15 +7483,12 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 					}
 					if( !found )
 					{
-						sprintf(EB,"%s:%d, Attribute %s has value %s, which does not match any of the following values:\n     ",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s has value %s, which does not match any of the following values:\n     ",
 							   af ? af : "", al, aname, string);
-						
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-									  EB, 
-									  &err);
 						for(i=0;i<ai->u.stringenum->size;i++)
 						{
-							printf( "%s  ", ai->u.stringenum->array[i]);
+							sprintf(EB, "%s  ", ai->u.stringenum->array[i]);
+							check_print_raw(EB);
 						}
 						EB[0] = 0;
 					}
@@ -6973,11 +7497,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 				case SYNTAX_ATTRTYPE_BOOLEAN:
 					if( strcasecmp(string,"false") && strcasecmp(string,"true") )
 					{
-						sprintf(EB,"%s:%d, Attribute %s should be a boolean Attribute, but is a string (%s) instead.",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s should be a boolean Attribute, but is a string (%s) instead.",
 							   af ? af : "", al, aname, string);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-									  EB, 
-									  &err);
 					}
 					break;
 					
@@ -6988,11 +7509,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 					{
 						if( !isa_formula(string) )
 						{
-							sprintf(EB,"%s:%d, Attribute %s should be an integer or float Attribute, but is a string (%s) instead.",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s should be an integer or float Attribute, but is a string (%s) instead.",
 								   af ? af : "", al, aname, string);
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-										  EB, 
-										  &err);
 							errcount++;
 						}
 					}
@@ -7011,20 +7529,14 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 				switch( ai->type )
 				{
 				case SYNTAX_ATTRTYPE_STRING:
-					sprintf(EB,"%s:%d, Attribute %s should be a string Attribute, but is float instead.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s should be a string Attribute, but is float instead.",
 						   af ? af : "", al, aname);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 					break;
 					
 				case SYNTAX_ATTRTYPE_BOOLEAN:
-					sprintf(EB,"%s:%d, Attribute %s should be a boolean Attribute, but is float instead.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s should be a boolean Attribute, but is float instead.",
 						   af ? af : "", al, aname);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 					break;
 
@@ -7035,11 +7547,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 						{
 							if( float64 < ai->u.intcon->greater_than )
 							{
-								sprintf(EB,"%s:%d, Attribute %s has value %g, but it should be greater than %d.",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s has value %g, but it should be greater than %d.",
 									   af ? af : "", al, aname, float64, ai->u.intcon->greater_than);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 						}
@@ -7047,11 +7556,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 						{
 							if( float64 > ai->u.intcon->less_than )
 							{
-								sprintf(EB,"%s:%d, Attribute %s has value %g, but it should be less than %d.",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s has value %g, but it should be less than %d.",
 									   af ? af : "", al, aname, float64, ai->u.intcon->less_than);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 						}
@@ -7065,11 +7571,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 						{
 							if( (double)float64 < ai->u.floatcon->greater_than )
 							{
-								sprintf(EB,"%s:%d, Attribute %s has value %g, but it should be greater than %g.",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s has value %g, but it should be greater than %g.",
 									   af ? af : "", al, aname, float64, ai->u.floatcon->greater_than);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 						}
@@ -7077,11 +7580,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 						{
 							if( (double)float64 > ai->u.floatcon->less_than )
 							{
-								sprintf(EB,"%s:%d, Attribute %s has value %g, but it should be less than %g.",
+								check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s has value %g, but it should be less than %g.",
 									   af ? af : "", al, aname, float64, ai->u.floatcon->less_than);
-								(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-											  EB, 
-											  &err);
 								errcount++;
 							}
 						}
@@ -7093,11 +7593,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 					break;
 					
 				case SYNTAX_ATTRTYPE_ENUM:
-					sprintf(EB,"%s:%d, Attribute %s should be an enumerated string Attribute, but is float instead.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s should be an enumerated string Attribute, but is float instead.",
 						   af ? af : "", al, aname);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 					break;
 				default:
@@ -7114,11 +7611,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 				switch( ai->type )
 				{
 				case SYNTAX_ATTRTYPE_STRING:
-					sprintf(EB,"%s:%d, Attribute %s should be a string Attribute, but is boolean instead.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s should be a string Attribute, but is boolean instead.",
 						   af ? af : "", al, aname);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 					break;
 					
@@ -7128,20 +7622,14 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 					
 				case SYNTAX_ATTRTYPE_INT:
 				case SYNTAX_ATTRTYPE_FLOAT:
-					sprintf(EB,"%s:%d, Attribute %s should be an integer/float Attribute, but is boolean instead.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s should be an integer/float Attribute, but is boolean instead.",
 						   af ? af : "", al, aname);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 					break;
 					
 				case SYNTAX_ATTRTYPE_ENUM:
-					sprintf(EB,"%s:%d, Attribute %s should be an enumerated string Attribute, but is boolean instead.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s should be an enumerated string Attribute, but is boolean instead.",
 						   af ? af : "", al, aname);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 					break;
 				default:
@@ -7160,11 +7648,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 			ai->type != SYNTAX_ATTRTYPE_COMPLEX_UNKNOWN &&
 			ai->type != SYNTAX_ATTRTYPE_COMPLEX_LIST )
 		{
-			sprintf(EB,"%s:%d, Attribute %s should be simple, but is complex here.",
+			check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Attribute %s should be simple, but is complex here.",
 				   af ? af : "", al, aname);
-			(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-						  EB, 
-						  &err);
 			errcount++;
 		}
 		else
@@ -7184,11 +7669,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 			{
 				if( !arg )
 				{
-					sprintf(EB,"%s:%d, %s has too many arguments.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, %s has too many arguments.",
 						   af ? af : "", al, aname);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 				}
 				/* [nanda:20060824] Check if arg is NULL before dereferencing */
@@ -7200,11 +7682,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 
 				if( arg && ( arg->type == SYNTAX_ATTRTYPE_STRING && type != SI2DR_STRING ) )
 				{
-					sprintf(EB,"%s:%d, Argument #%d of %s should be a string, but it is not.",
+					check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Argument #%d of %s should be a string, but it is not.",
 						   af ? af : "", al, argnum, aname);
-					(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-								  EB, 
-								  &err);
 					errcount++;
 				}
 				else if(arg && (arg->type == SYNTAX_ATTRTYPE_FLOAT && (type == SI2DR_STRING
@@ -7215,21 +7694,15 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 						/* it's ok, if what's in the string is an int! */
 						if(strspn(string,"0123456789.Ee-+")!=strlen(string))
 						{
-							sprintf(EB,"%s:%d, Argument #%d of %s should be an int, but it has non-integer characters in it (%s).",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Argument #%d of %s should be an int, but it has non-integer characters in it (%s).",
 						  		 af ? af : "", al, argnum, aname, string);
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-										  EB, 
-										  &err);
 							errcount++;
 						}
 					}
 					else
 					{
-						sprintf(EB,"%s:%d, Argument #%d of %s should be a float, but it is not.",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Argument #%d of %s should be a float, but it is not.",
 							   af ? af : "", al, argnum, aname);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 				}
@@ -7241,21 +7714,15 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 						/* it's ok, if what's in the string is an int! */
 						if(strspn(string,"0123456789+-")!=strlen(string))
 						{
-							sprintf(EB,"%s:%d, Argument #%d of %s should be an int, but it has non-integer characters in it (%s).",
+							check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Argument #%d of %s should be an int, but it has non-integer characters in it (%s).",
 						  		 af ? af : "", al, argnum, aname, string);
-							(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-										  EB, 
-										  &err);
 							errcount++;
 						}
 					}
 					else
 					{
-						sprintf(EB,"%s:%d, Argument #%d of %s should be an int, but it is not.",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Argument #%d of %s should be an int, but it is not.",
 							   af ? af : "", al, argnum, aname);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 				}
@@ -7263,11 +7730,8 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 				{
 					if( type != SI2DR_STRING || (strcasecmp(string,"true") && strcasecmp(string,"false") ) )
 					{
-						sprintf(EB,"%s:%d, Argument #%d of %s should be a boolean (true or false), but it is not.",
+						check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, Argument #%d of %s should be a boolean (true or false), but it is not.",
 							   af ? af : "", al, argnum, aname);
-						(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-									  EB, 
-									  &err);
 						errcount++;
 					}
 				}
@@ -7279,14 +7743,11 @@ static void check_attr_correspondence( si2drAttrIdT attr, libsynt_attribute_info
 			si2drIterQuit(vals,&err);
 			if( arg )
 			{
-				sprintf(EB,"%s:%d, %s has too few arguments.",
+				check_report(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, "%s:%d, %s has too few arguments.",
 					   af ? af : "", al, aname);
-				(*MsgPrinter)(SI2DR_SEVERITY_ERR, SI2DR_SYNTAX_ERROR, 
-							  EB, 
-							  &err);
 				errcount++;
 			}
 		}
 	}
-	attribute_specific_checks( attr );
+	CHECK_CALL(attribute_specific_checks, si2drObjectGetOwner(attr,&err), attr);
 }
@@ -0,0 +1,606 @@
+// Checks of the table, formula and CCS interfaces on the Liberty files in
+// this directory, run by run-tests.py. Each test prints "Test passed for"
+// or "Test failed for" its name; with --bench, batched interpolation is
+// also timed against one lookup per point, and packed tables against the
+// doubles they are packed from.
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <thread>
+#include "liberty_parser.hpp"
+
+static string test_dir = ".";
+static bool bench = false;
+static int failures = 0;
+
+static void report(const string &name, bool passed, const string &detail = "") {
+	std::cout << "Test " << (passed ? "passed" : "failed") << " for " << name;
+	if (!passed && !detail.empty()) std::cout << ": " << detail;
+	std::cout << std::endl;
+	if (!passed) failures++;
+}
+
+// Every group under root that has a values attribute
+static void find_tables(si2drGroupIdT root, std::vector<si2drGroupIdT> &tables) {
+	si2drErrorT err;
+	si2drGroupsIdT iter = si2drGroupGetGroups(root, &err);
+	si2drGroupIdT group;
+	while (!si2drObjectIsNull((group = si2drIterNextGroup(iter, &err)), &err)) {
+		if (!si2drObjectIsNull(si2drGroupFindAttrByName(group, const_cast<char *>("values"), &err), &err)) tables.push_back(group);
+		find_tables(group, tables);
+	}
+	si2drIterQuit(iter, &err);
+}
+
+// Random points over each index, reaching a tenth of its span past either end
+static std::vector<std::vector<double>> random_points(const LibertyTable &table, size_t n, std::mt19937 &rng) {
+	std::vector<std::vector<double>> coords(table.dimensions(), std::vector<double>(n));
+	for (int d = 0; d < table.dimensions(); d++) {
+		std::vector<double> index = table.index(d);
+		double span = index.back() - index.front();
+		std::uniform_real_distribution<double> coordinate(index.front() - span / 10, index.back() + span / 10);
+		for (double &x : coords[d]) x = coordinate(rng);
+	}
+	return coords;
+}
+
+// Multilinear interpolation written out plainly, from copies of the
+// table's arrays: on each axis the interval holding x (the first or last
+// one past the ends), and every corner of the cell weighted by the product
+// of its axes' weights
+struct ReferenceTable {
+	explicit ReferenceTable(const LibertyTable &table) : values(table.values()), stride(table.dimensions(), 1) {
+		for (int d = 0; d < table.dimensions(); d++) index.push_back(table.index(d));
+		for (int d = table.dimensions() - 2; d >= 0; d--) stride[d] = stride[d + 1] * table.size(d + 1);
+	}
+	double lookup(const std::vector<double> &point) const {
+		int n = index.size();
+		int lo[7], pos;
+		double w[7], result = 0, weight;
+		for (int d = 0; d < n; d++) {
+			const std::vector<double> &x = index[d];
+			lo[d] = 0;
+			w[d] = 0;
+			if (x.size() < 2) continue;
+			while (lo[d] < (int)x.size() - 2 && x[lo[d] + 1] <= point[d]) lo[d]++;
+			if (x[lo[d] + 1] != x[lo[d]]) w[d] = (point[d] - x[lo[d]]) / (x[lo[d] + 1] - x[lo[d]]);
+		}
+		for (int corner = 0; corner < (1 << n); corner++) {
+			bool inside = true;
+			weight = 1;
+			pos = 0;
+			for (int d = 0; d < n; d++) {
+				bool upper = corner >> d & 1;
+				if (upper && index[d].size() < 2) inside = false;
+				weight *= upper ? w[d] : 1 - w[d];
+				pos += (lo[d] + upper) * stride[d];
+			}
+			if (inside) result += weight * values[pos];
+		}
+		return result;
+	}
+	std::vector<std::vector<double>> index;
+	std::vector<double> values;
+	std::vector<int> stride;
+};
+
+static double largest_magnitude(const std::vector<double> &values) {
+	double m = 0;
+	for (double v : values) m = std::max(m, std::fabs(v));
+	return m;
+}
+
+static void test_interpolation() {
+	LibertyParser parser(test_dir + "/inverter_nldm.lib");
+	std::vector<si2drGroupIdT> groups;
+	find_tables(parser.library(), groups);
+	std::mt19937 rng(41);
+	int tables = 0;
+	double worst = 0;
+	for (si2drGroupIdT group : groups) {
+		LibertyTable table = parser.table(group);
+		if (table.dimensions() == 0) continue;
+		std::vector<std::vector<double>> coords = random_points(table, 1000, rng);
+		std::vector<double> batch = table.interpolate(coords);
+		ReferenceTable reference(table);
+		double scale = std::max(1.0, largest_magnitude(table.values()));
+		for (size_t p = 0; p < batch.size(); p++) {
+			std::vector<double> point(table.dimensions());
+			for (int d = 0; d < table.dimensions(); d++) point[d] = coords[d][p];
+			double one = table.interpolate(point), ref = reference.lookup(point);
+			worst = std::max(worst, std::max(std::fabs(batch[p] - ref), std::fabs(one - ref)) / scale);
+		}
+		tables++;
+	}
+	report("interpolation", tables >= 10 && worst <= 1e-12, std::to_string(tables) + " tables, worst relative difference " + std::to_string(worst));
+	if (!bench) return;
+	// the largest table, a million points
+	LibertyTable *largest = nullptr;
+	std::vector<LibertyTable> all;
+	for (si2drGroupIdT group : groups) all.push_back(parser.table(group));
+	for (LibertyTable &table : all) {
+		if (table.dimensions() > 0 && (!largest || table.values().size() > largest->values().size())) largest = &table;
+	}
+	ReferenceTable reference(*largest);
+	std::vector<std::vector<double>> coords = random_points(*largest, 1000000, rng);
+	std::vector<double> point(largest->dimensions()), batch;
+	double sum = 0;
+	auto a = std::chrono::steady_clock::now();
+	for (size_t p = 0; p < coords[0].size(); p++) {
+		for (int d = 0; d < largest->dimensions(); d++) point[d] = coords[d][p];
+		sum += reference.lookup(point);
+	}
+	auto b = std::chrono::steady_clock::now();
+	for (size_t p = 0; p < coords[0].size(); p++) {
+		for (int d = 0; d < largest->dimensions(); d++) point[d] = coords[d][p];
+		sum += largest->interpolate(point);
+	}
+	auto c = std::chrono::steady_clock::now();
+	batch = largest->interpolate(coords);
+	auto e = std::chrono::steady_clock::now();
+	auto ns = [&](auto from, auto to) { return std::chrono::duration<double>(to - from).count() / coords[0].size() * 1e9; };
+	std::cout << "Interpolation of " << coords[0].size() << " points in a " << largest->dimensions() << "-dimensional table of " << largest->values().size() << " values: "
+	          << ns(a, b) << " ns per point written out plainly, " << ns(b, c) << " ns one lookup at a time, " << ns(c, e) << " ns batched (" << sum + batch[0] << ")" << std::endl;
+}
+
+// A fixed-dimension view reads the same numbers as the table, and
+// interpolates as it does; under each table precision, the view of that
+// element type reads the stored arrays themselves, and one of another
+// stored type is refused
+template <typename T>
+static bool same_view(LibertyParser &parser, si2drGroupIdT group) {
+	LibertyTable table = parser.table(group);
+	LibertyTableView<2, T> view = table.view<2, T>();
+	bool same = view.size(0) == table.size(0) && view.size(1) == table.size(1);
+	for (int d = 0; d < 2; d++) {
+		std::vector<double> index = table.index(d);
+		for (int i = 0; i < table.size(d); i++) same = same && double(view.index(d, i)) == index[i];
+	}
+	for (int i = 0; i < table.size(0); i++) {
+		for (int j = 0; j < table.size(1); j++) same = same && double(view(i, j)) == table.at({i, j});
+	}
+	return same;
+}
+
+static void test_views() {
+	LibertyParser parser(test_dir + "/inverter_nldm.lib");
+	std::vector<si2drGroupIdT> groups;
+	find_tables(parser.library(), groups);
+	std::mt19937 rng(42);
+	int tables = 0;
+	double worst = 0;
+	bool same = true;
+	for (si2drGroupIdT group : groups) {
+		LibertyTable table = parser.table(group);
+		if (table.dimensions() != 2) continue;
+		LibertyTableView<2> view = table.view<2>();
+		same = same && same_view<double>(parser, group);
+		std::vector<std::vector<double>> coords = random_points(table, 200, rng);
+		double scale = std::max(1.0, largest_magnitude(table.values()));
+		for (size_t p = 0; p < coords[0].size(); p++) {
+			double x = coords[0][p], y = coords[1][p];
+			worst = std::max(worst, std::fabs(view.interpolate(x, y) - table.interpolate({x, y})) / scale);
+		}
+		for (si2drTablePrecisionT precision : {SI2DR_TABLE_LONG_DOUBLE, SI2DR_TABLE_FLOAT64, SI2DR_TABLE_FLOAT32}) {
+			parser.set_table_precision(precision);
+			same = same && same_view<double>(parser, group);
+			if (precision == SI2DR_TABLE_LONG_DOUBLE) same = same && same_view<LONG_DOUBLE>(parser, group);
+			if (precision == SI2DR_TABLE_FLOAT32) same = same && same_view<float>(parser, group);
+			try {
+				if (precision == SI2DR_TABLE_LONG_DOUBLE) parser.table(group).view<2, float>();
+				else parser.table(group).view<2, LONG_DOUBLE>();
+				same = false;
+			} catch (const std::invalid_argument &) {
+			}
+		}
+		parser.set_table_precision(SI2DR_TABLE_LONG_DOUBLE);
+		tables++;
+	}
+	report("table views", tables >= 4 && same && worst <= 1e-12, std::to_string(tables) + " tables, worst relative difference " + std::to_string(worst));
+}
+
+// Under a FLOAT64 table precision every value and index of a table is the
+// LONG_DOUBLE one rounded to double, and under FLOAT32 within 2^-24 of it;
+// the checker reads the narrowed tables too, and says the same about them
+static std::vector<string> *check_messages = nullptr;
+
+static si2drVoidT collect_message(si2drSeverityT, si2drErrorT, si2drStringT text, si2drErrorT *err) {
+	check_messages->push_back(text ? text : "");
+	*err = SI2DR_NO_ERROR;
+}
+
+static std::vector<std::vector<double>> table_numbers(LibertyParser &parser, si2drTablePrecisionT precision) {
+	std::vector<si2drGroupIdT> groups;
+	std::vector<std::vector<double>> numbers;
+	parser.set_table_precision(precision);
+	find_tables(parser.library(), groups);
+	for (si2drGroupIdT group : groups) {
+		LibertyTable table = parser.table(group);
+		numbers.push_back(table.values());
+		for (int d = 0; d < table.dimensions(); d++) numbers.push_back(table.index(d));
+	}
+	parser.set_table_precision(SI2DR_TABLE_LONG_DOUBLE);
+	return numbers;
+}
+
+static std::vector<string> checked(const string &file, si2drTablePrecisionT precision) {
+	std::vector<string> messages;
+	si2drErrorT err;
+	LibertyParser parser(file);
+	check_messages = &messages;
+	si2drMessageHandlerT handler = si2drPIGetMessageHandler(&err);
+	si2drPISetMessageHandler(collect_message, &err);
+	parser.set_table_precision(precision);
+	parser.check();
+	parser.set_table_precision(SI2DR_TABLE_LONG_DOUBLE);
+	si2drPISetMessageHandler(handler, &err);
+	check_messages = nullptr;
+	return messages;
+}
+
+static void test_precisions() {
+	int files = 0;
+	long numbers = 0, wrong = 0;
+	bool same_checks = true;
+	for (const char *name : {"example.lut.lib", "example.lut2.lib", "example.powerlut.lib", "example.ccs.lib"}) {
+		string file = test_dir + "/" + name;
+		std::vector<std::vector<double>> wide, f64, f32;
+		{
+			// one parser at a time: they share the PI database
+			LibertyParser parser(file);
+			wide = table_numbers(parser, SI2DR_TABLE_LONG_DOUBLE);
+			f64 = table_numbers(parser, SI2DR_TABLE_FLOAT64);
+			f32 = table_numbers(parser, SI2DR_TABLE_FLOAT32);
+		}
+		if (f64.size() != wide.size() || f32.size() != wide.size()) {
+			wrong++;
+			continue;
+		}
+		for (size_t a = 0; a < wide.size(); a++) {
+			if (f64[a].size() != wide[a].size() || f32[a].size() != wide[a].size()) {
+				wrong++;
+				continue;
+			}
+			for (size_t i = 0; i < wide[a].size(); i++) {
+				if (f64[a][i] != wide[a][i] || std::fabs(f32[a][i] - wide[a][i]) > std::ldexp(std::fabs(wide[a][i]), -24)) wrong++;
+				numbers++;
+			}
+		}
+		files++;
+		same_checks = same_checks && checked(file, SI2DR_TABLE_FLOAT32) == checked(file, SI2DR_TABLE_LONG_DOUBLE);
+	}
+	report("table precisions", files == 4 && numbers > 0 && wrong == 0 && same_checks, std::to_string(numbers) + " numbers, " + std::to_string(wrong) + " wrong" + (same_checks ? "" : ", check messages differ"));
+}
+
+// Index vectors written alike in several places decode to one shared
+// block, and the statistics count the saving
+static void test_decoded_stats() {
+	LibertyParser parser(test_dir + "/inverter_nldm.lib");
+	std::map<string, const liberty_decoded_numbers *> first;
+	si2drErrorT err;
+	int repeated = 0;
+	bool shared = true;
+	std::function<void(si2drGroupIdT)> visit = [&](si2drGroupIdT group) {
+		for (const char *name : {"index_1", "index_2"}) {
+			si2drAttrIdT attr = si2drGroupFindAttrByName(group, const_cast<char *>(name), &err);
+			if (si2drObjectIsNull(attr, &err)) continue;
+			si2drValuesIdT values = si2drComplexAttrGetValues(attr, &err);
+			si2drValueTypeT type;
+			si2drInt32T i;
+			si2drFloat64T f;
+			si2drStringT text = nullptr;
+			si2drBooleanT b;
+			si2drExprT *e;
+			si2drIterNextComplexValue(values, &type, &i, &f, &text, &b, &e, &err);
+			si2drIterQuit(values, &err);
+			if (type != SI2DR_STRING || !text) continue;
+			const liberty_decoded_numbers *dn = liberty_get_decoded_numbers(attr);
+			auto found = first.emplace(text, dn);
+			if (!found.second) {
+				shared = shared && found.first->second == dn;
+				repeated++;
+			}
+		}
+		si2drGroupsIdT subs = si2drGroupGetGroups(group, &err);
+		si2drGroupIdT sub;
+		while (!si2drObjectIsNull((sub = si2drIterNextGroup(subs, &err)), &err)) visit(sub);
+		si2drIterQuit(subs, &err);
+	};
+	visit(parser.library());
+	json stats = parser.stats();
+	liberty_decoded_stats st;
+	liberty_get_decoded_stats(&st);
+	bool counted = st.attributes > 0 && st.blocks < st.attributes && st.numbers_stored < st.numbers_referenced && st.bytes_stored < st.bytes_referenced
+		&& stats["attributes"] == st.attributes && stats["blocks"] == st.blocks && stats["bytes_stored"] == st.bytes_stored && stats["bytes_referenced"] == st.bytes_referenced;
+	report("decoded number sharing", repeated > 0 && shared && counted, std::to_string(st.attributes) + " attributes, " + std::to_string(st.blocks) + " blocks, " + std::to_string(st.bytes_referenced) + " bytes referenced, " + std::to_string(st.bytes_stored) + " stored");
+}
+
+// Truth tables of compiled formulas against the same functions written in
+// C++, bit r of a table having variable i at bit i of r
+static void test_formulas() {
+	struct case_t {
+		const char *text;
+		std::function<bool(const bool *)> fn;
+	};
+	std::vector<case_t> cases = {
+		{"A B", [](const bool *v) { return v[0] && v[1]; }},
+		{"A & !B", [](const bool *v) { return v[0] && !v[1]; }},
+		{"A + B'", [](const bool *v) { return v[0] || !v[1]; }},
+		{"!(A ^ B)", [](const bool *v) { return v[0] == v[1]; }},
+		{"(A | B) * C'", [](const bool *v) { return (v[0] || v[1]) && !v[2]; }},
+		{"A*B + C*D + E*F + G", [](const bool *v) { return (v[0] && v[1]) || (v[2] && v[3]) || (v[4] && v[5]) || v[6]; }},
+		{"S A' + S' B 1 + 0", [](const bool *v) { return v[0] ? !v[1] : v[2]; }},
+	};
+	bool same = true;
+	for (const case_t &c : cases) {
+		int errpos;
+		liberty_formula *f = liberty_formula_compile(c.text, &errpos);
+		if (!f) {
+			same = false;
+			continue;
+		}
+		std::vector<uint64_t> table(f->nvars <= 6 ? 1 : size_t(1) << (f->nvars - 6));
+		liberty_formula_truth_table(f, table.data());
+		for (uint64_t r = 0; r < (uint64_t(1) << f->nvars); r++) {
+			bool v[64];
+			for (int i = 0; i < f->nvars; i++) v[i] = r >> i & 1;
+			same = same && (table[r / 64] >> (r % 64) & 1) == c.fn(v);
+		}
+		liberty_formula_free(f);
+	}
+	int errpos = -1;
+	same = same && !liberty_formula_compile("A + (B", &errpos) && errpos == 6 && !liberty_formula_compile("", &errpos);
+	// a function attribute, its variables bound to the cell's pins
+	LibertyParser parser(test_dir + "/example.lut2.lib");
+	LibertyFormula xor2 = parser.formula(parser.pin("AN2", "Z"));
+	si2drErrorT err;
+	same = same && xor2.truth_table()[0] == 0x6 && !si2drObjectIsNull(xor2.pin(0), &err) && !si2drObjectIsNull(xor2.pin(1), &err);
+	report("formulas", same);
+}
+
+// Numbers written back into a table's text read back as the same doubles,
+// in as few digits as that takes
+static void test_rewritten_numbers() {
+	LibertyParser parser(test_dir + "/inverter_nldm.lib");
+	std::vector<si2drGroupIdT> groups;
+	find_tables(parser.library(), groups);
+	std::mt19937 rng(49);
+	std::uniform_real_distribution<double> factor(1e-3, 1e3);
+	si2drErrorT err;
+	int attrs = 0;
+	bool same = true;
+	for (si2drGroupIdT group : groups) {
+		si2drAttrIdT values = si2drGroupFindAttrByName(group, const_cast<char *>("values"), &err);
+		const liberty_decoded_numbers *dn = liberty_get_decoded_numbers(values);
+		if (!dn || dn->starts[dn->nvalues] == 0) continue;
+		std::vector<double> nums(dn->nums, dn->nums + dn->starts[dn->nvalues]);
+		double f = factor(rng);
+		for (double &x : nums) x *= f;
+		nums[0] = 0.1 * 3;  // 0.30000000000000004, which needs 17 digits
+		same = same && liberty_set_decoded_numbers(values, nums.data());
+		dn = liberty_get_decoded_numbers(values);
+		same = same && dn && dn->starts[dn->nvalues] == (int)nums.size() && std::equal(nums.begin(), nums.end(), dn->nums);
+		attrs++;
+	}
+	report("rewritten numbers", attrs >= 10 && same);
+}
+
+// A packed table keeps every value within its measured max_error, which is
+// within the tolerance asked for (0 keeps the values exact), and lookups
+// inside the table are off by no more than that
+static void test_packing() {
+	LibertyParser parser(test_dir + "/inverter_nldm.lib");
+	std::vector<si2drGroupIdT> groups;
+	find_tables(parser.library(), groups);
+	std::mt19937 rng(47);
+	int tables = 0;
+	bool within = true;
+	for (si2drGroupIdT group : groups) {
+		LibertyTable table = parser.table(group);
+		if (table.dimensions() == 0) continue;
+		std::vector<double> values = table.values();
+		double scale = largest_magnitude(values);
+		for (double tolerance : {0.0, 1e-4, 1e-2}) {
+			LibertyPackedTable packed = table.pack(tolerance);
+			std::vector<double> unpacked = packed.values();
+			double error = 0;
+			for (size_t i = 0; i < values.size(); i++) error = std::max(error, std::fabs(unpacked[i] - values[i]));
+			within = within && error <= packed.max_error() && packed.max_error() <= tolerance * scale;
+			for (int d = 0; d < table.dimensions(); d++) {
+				std::vector<double> index = table.index(d), packed_index = packed.index(d);
+				double magnitude = largest_magnitude(index);
+				for (size_t i = 0; i < index.size(); i++) within = within && std::fabs(packed_index[i] - index[i]) <= 1e-12 * magnitude;
+			}
+			std::vector<std::vector<double>> coords = random_points(table, 200, rng);
+			std::vector<double> point(table.dimensions());
+			for (size_t p = 0; p < coords[0].size(); p++) {
+				for (int d = 0; d < table.dimensions(); d++) {
+					std::vector<double> index = table.index(d);
+					point[d] = std::min(std::max(coords[d][p], index.front()), index.back());
+				}
+				within = within && std::fabs(packed.interpolate(point) - table.interpolate(point)) <= packed.max_error() + 1e-12 * scale;
+			}
+		}
+		tables++;
+	}
+	report("packed tables", tables >= 10 && within);
+	if (!bench) return;
+	// what packing saves against what it costs a lookup, on the largest table
+	std::vector<LibertyTable> all;
+	LibertyTable *largest = nullptr;
+	for (si2drGroupIdT group : groups) all.push_back(parser.table(group));
+	for (LibertyTable &table : all) {
+		if (table.dimensions() > 0 && (!largest || table.values().size() > largest->values().size())) largest = &table;
+	}
+	std::vector<std::vector<double>> coords = random_points(*largest, 1000000, rng);
+	std::vector<std::vector<double>> points(coords[0].size(), std::vector<double>(largest->dimensions()));
+	double bytes = largest->values().size() * sizeof(double), sum = 0;
+	for (int d = 0; d < largest->dimensions(); d++) {
+		std::vector<double> index = largest->index(d);
+		bytes += index.size() * sizeof(double);
+		for (size_t p = 0; p < points.size(); p++) points[p][d] = std::min(std::max(coords[d][p], index.front()), index.back());
+	}
+	auto ns = [&](auto from, auto to) { return std::chrono::duration<double>(to - from).count() / points.size() * 1e9; };
+	auto a = std::chrono::steady_clock::now();
+	for (const std::vector<double> &point : points) sum += largest->interpolate(point);
+	auto b = std::chrono::steady_clock::now();
+	std::cout << "Lookups of " << points.size() << " points in a " << largest->dimensions() << "-dimensional table of " << largest->values().size() << " values: "
+	          << ns(a, b) << " ns per point from " << bytes << " bytes of doubles";
+	for (double tolerance : {0.0, 1e-4, 1e-2}) {
+		LibertyPackedTable packed = largest->pack(tolerance);
+		auto c = std::chrono::steady_clock::now();
+		for (const std::vector<double> &point : points) sum += packed.interpolate(point);
+		auto e = std::chrono::steady_clock::now();
+		std::cout << "; " << ns(c, e) << " ns packed to " << tolerance << " in " << packed.bytes() << " bytes";
+	}
+	std::cout << " (" << sum << ")" << std::endl;
+}
+
+// A lookup through a hint gives the same result as one without, whether the
+// point moves a little, jumps, or leaves the table
+static void test_hints() {
+	LibertyParser parser(test_dir + "/inverter_nldm.lib");
+	std::vector<si2drGroupIdT> groups;
+	find_tables(parser.library(), groups);
+	std::mt19937 rng(48);
+	std::normal_distribution<double> step(0, 1);
+	int tables = 0, different = 0;
+	for (si2drGroupIdT group : groups) {
+		LibertyTable table = parser.table(group);
+		if (table.dimensions() == 0) continue;
+		std::vector<std::vector<double>> jumps = random_points(table, 100, rng);
+		std::vector<double> point(table.dimensions());
+		liberty_lut_hint hint = {};
+		for (int d = 0; d < table.dimensions(); d++) point[d] = jumps[d][0];
+		for (int q = 0; q < 10000; q++) {
+			for (int d = 0; d < table.dimensions(); d++) {
+				std::vector<double> index = table.index(d);
+				if (q % 100 == 0) point[d] = jumps[d][q / 100];
+				else point[d] += step(rng) * (index.back() - index.front()) / 20;
+			}
+			if (table.interpolate(point, hint) != table.interpolate(point)) different++;
+		}
+		tables++;
+	}
+	report("interval hints", tables >= 10 && different == 0, std::to_string(different) + " lookups differ");
+}
+
+// The store holds every table in file order, with the same numbers as the
+// tables themselves, in 64-byte aligned buffers
+static void test_table_store() {
+	LibertyParser parser(test_dir + "/inverter_nldm.lib");
+	std::vector<si2drGroupIdT> groups;
+	find_tables(parser.library(), groups);
+	LibertyTableStore store = parser.table_store();
+	si2drErrorT err;
+	size_t t = 0;
+	bool same = ((uintptr_t)store.values() & 63) == 0;
+	for (si2drGroupIdT group : groups) {
+		LibertyTable table = parser.table(group);
+		if (table.dimensions() == 0) continue;
+		if (t == store.size() || !si2drObjectIsSame(store.descriptor(t).group, group, &err)) {
+			same = false;
+			break;
+		}
+		std::vector<double> values = table.values();
+		same = same && std::equal(values.begin(), values.end(), store.values(t));
+		for (int d = 0; d < table.dimensions(); d++) {
+			std::vector<double> index = table.index(d);
+			same = same && store.descriptor(t).dim_sizes[d] == table.size(d) && std::equal(index.begin(), index.end(), store.index(t, d));
+		}
+		t++;
+	}
+	report("table store", same && t == store.size() && t >= 10, std::to_string(store.size()) + " tables stored, " + std::to_string(t) + " matched");
+}
+
+// At a point of the grid a query gets the charge of the vector there; at
+// any point the charge and the time half of it is delivered agree with the
+// waveform integrated numerically
+static void test_ccs() {
+	LibertyParser parser(test_dir + "/ccs_waveforms.lib");
+	std::vector<si2drGroupIdT> arcs = parser.timing_arcs(parser.cell("INV"));
+	LibertyCcsArc arc = parser.ccs(arcs.at(0));
+	const liberty_ccs_arc &data = arc.data();
+	std::vector<double> slews, loads;
+	bool same = data.nvectors > 0;
+	for (int s = 0; s < data.nslew; s++) {
+		for (int l = 0; l < data.nload; l++) {
+			int k = data.vector_at[s * data.nload + l];
+			if (k < 0) continue;
+			same = same && arc.charge({data.slews[s]}, {data.loads[l]})[0] == data.charge[k];
+			slews.push_back(data.slews[s]);
+			loads.push_back(data.loads[l]);
+		}
+	}
+	slews.push_back((data.slews[0] + data.slews[data.nslew - 1]) / 2);
+	loads.push_back((data.loads[0] + data.loads[data.nload - 1]) / 2);
+	slews.push_back(data.slews[data.nslew - 1] * 2);
+	loads.push_back(data.loads[0] / 2);
+	std::vector<double> charge = arc.charge(slews, loads), half = arc.crossing(slews, loads, 0.5), times;
+	double first = data.times[0], last = data.times[0], worst = 0;
+	for (long i = 0; i < data.nsamples; i++) {
+		first = std::min(first, data.times[i]);
+		last = std::max(last, data.times[i]);
+	}
+	for (int i = 0; i <= 100000; i++) times.push_back(first - 0.1 + (last - first + 0.2) * i / 100000);
+	std::vector<double> current = arc.waveforms(slews, loads, times);
+	for (size_t q = 0; q < slews.size(); q++) {
+		const double *c = &current[q * times.size()];
+		double delivered = 0, at_half = NAN;
+		for (size_t i = 1; i < times.size(); i++) {
+			delivered += (c[i] + c[i - 1]) / 2 * (times[i] - times[i - 1]);
+			if (std::isnan(at_half) && delivered >= charge[q] / 2) at_half = times[i];
+		}
+		worst = std::max(worst, std::fabs(delivered - charge[q]) / std::fabs(charge[q]));
+		worst = std::max(worst, std::fabs(at_half - half[q]) / (last - first));
+	}
+	report("CCS queries", same && worst < 1e-3, std::to_string(slews.size()) + " queries, worst relative difference " + std::to_string(worst));
+}
+
+// Lookups from several threads at once on a freshly loaded library, whose
+// per-type child indexes they build between them, find what one thread does
+static void test_concurrent_lookups() {
+	LibertyParser parser(test_dir + "/inverter_nldm.lib");
+	auto lookups = [&parser]() {
+		std::vector<si2drGroupIdT> found = parser.groups(parser.library(), "cell");
+		for (si2drGroupIdT cell : parser.groups(parser.library(), "cell")) {
+			std::vector<si2drGroupIdT> arcs = parser.timing_arcs(cell);
+			found.insert(found.end(), arcs.begin(), arcs.end());
+		}
+		return found;
+	};
+	std::vector<std::vector<si2drGroupIdT>> found(8);
+	std::vector<std::thread> threads;
+	for (auto &f : found) threads.emplace_back([&f, &lookups]() { f = lookups(); });
+	for (std::thread &t : threads) t.join();
+	std::vector<si2drGroupIdT> expected = lookups();
+	si2drErrorT err;
+	bool same = expected.size() > 1;
+	for (const auto &f : found) {
+		same = same && f.size() == expected.size();
+		for (size_t i = 0; same && i < f.size(); i++) same = si2drObjectIsSame(f[i], expected[i], &err);
+	}
+	report("concurrent lookups", same, std::to_string(expected.size()) + " groups expected");
+}
+
+int main(int argc, char *argv[]) {
+	for (int i = 1; i < argc; i++) {
+		if (string(argv[i]) == "--bench") bench = true;
+		else test_dir = argv[i];
+	}
+	test_interpolation();
+	test_hints();
+	test_views();
+	test_precisions();
+	test_packing();
+	test_table_store();
+	test_formulas();
+	test_rewritten_numbers();
+	test_decoded_stats();
+	test_ccs();
+	test_concurrent_lookups();
+	return failures ? 1 : 0;
+}
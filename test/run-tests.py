@@ -1,9 +1,11 @@
 import os
+import shutil
 import subprocess
 import filecmp
 
 TEST_DIR = "."
 LIBERTY2JSON_EXE = "../build/liberty2json"
+API_TESTS_EXE = "../build/api_tests"
 
 def check_liberty_json(json_filename):
   """Load a Liberty JSON file"""
@@ -14,6 +16,95 @@ def check_liberty_json(json_filename):
     if '"output_current_rise":' in json_contents or '"output_current_fall":' in json_contents:
       print("  CCS timing found in file:", json_filename)
 
+# Runs with options: (Liberty file, options, reference). The reference is the
+# output file, the output directory for --outdir, or what liberty2json prints
+# for --check; the test output goes next to it with .test. for .ref.
+OPTION_TESTS = [
+	("example.lut2.lib", ["--select", 'library/cell[name=~"*2"]/pin[*]/capacitance'], "example.lut2.select.ref.json"),
+	("example.lut2.lib", ["--format=jsonl", "--threads", "2"], "example.lut2.ref.jsonl"),
+	("example.lut2.lib", ["--threads", "2", "--outdir"], "example.lut2.ref.outdir"),
+	("example.ccs.lib", ["--check", "--threads", "2", "--check-categories", "all,-ccs"], "example.ccs.nocheck-ccs.ref.txt"),
+	("example.ccs.lib", ["--check", "--threads", "2", "--check-categories", "ccs", "--max-errors", "5"], "example.ccs.max-errors.ref.txt"),
+	("newstuff.lib", ["--check", "--min-severity", "warning"], "newstuff.min-severity.ref.txt"),
+	("inverter_nldm.lib", ["--normalize-units", "time=1ps,capacitance=1ff"], "inverter_nldm.normalized.ref.json"),
+]
+
+def run_option_test(lib_file, options, out_file):
+	if "--outdir" in options:
+		shutil.rmtree(out_file, ignore_errors=True)
+		subprocess.run([LIBERTY2JSON_EXE, lib_file] + options + [out_file])
+	elif "--check" in options:
+		with open(out_file, "w", encoding="utf-8") as out:
+			subprocess.run([LIBERTY2JSON_EXE, lib_file] + options + ["--outfile", os.devnull], stdout=out, stderr=subprocess.STDOUT)
+	else:
+		subprocess.run([LIBERTY2JSON_EXE, lib_file] + options + ["--outfile", out_file])
+
+def same_output(test_file, ref_file):
+	if not os.path.isdir(ref_file):
+		return filecmp.cmp(test_file, ref_file, shallow=False)
+	for dir_name, _, file_names in os.walk(ref_file):
+		for file_name in file_names:
+			ref = os.path.join(dir_name, file_name)
+			if not filecmp.cmp(ref.replace(ref_file, test_file, 1), ref, shallow=False):
+				return False
+	return sum(len(f) for _, _, f in os.walk(test_file)) == sum(len(f) for _, _, f in os.walk(ref_file))
+
+# Conversions with --cache-dir: (Liberty file, whether it may be cached). A
+# cached file is converted twice; the second run must read the snapshot the
+# first one wrote, leaving it in place, and both must match the reference.
+CACHE_TESTS = [
+	("example.lut2.lib", True),
+	("cache_include.lib", False),
+]
+
+def snapshots(cache_dir):
+	if not os.path.isdir(cache_dir):
+		return []
+	return [os.stat(os.path.join(cache_dir, f)) for f in os.listdir(cache_dir) if f.endswith(".snap")]
+
+def run_cache_test(lib_file, cached):
+	cache_dir = lib_file.replace(".lib", ".test.cache")
+	json_file = lib_file.replace(".lib", ".test.json")
+	ref_file = lib_file.replace(".lib", ".ref.json")
+	shutil.rmtree(cache_dir, ignore_errors=True)
+	subprocess.run([LIBERTY2JSON_EXE, lib_file, "--cache-dir", cache_dir, "--outfile", json_file])
+	first = snapshots(cache_dir)
+	if not cached:
+		passed = not first and filecmp.cmp(json_file, ref_file, shallow=False)
+	else:
+		passed = len(first) == 1 and filecmp.cmp(json_file, ref_file, shallow=False)
+		subprocess.run([LIBERTY2JSON_EXE, lib_file, "--cache-dir", cache_dir, "--outfile", json_file])
+		second = snapshots(cache_dir)
+		passed = passed and len(second) == 1 and (second[0].st_ino, second[0].st_mtime_ns) == (first[0].st_ino, first[0].st_mtime_ns)
+		passed = passed and filecmp.cmp(json_file, ref_file, shallow=False)
+	shutil.rmtree(cache_dir, ignore_errors=True)
+	return passed
+
+# Checks with --check-cache: the second run replays the diagnostics the
+# first one cached, and must print the same. To show they really come from
+# the cache, a third run after a word in the cache was changed must print
+# the changed word.
+CHECK_CACHE_TESTS = [
+	("example.ccs.lib", ["--check", "--threads", "2"], b"digits of precision", b"DIGITS of precision"),
+]
+
+def run_check_cache_test(lib_file, options, cached_text, changed_text):
+	cache_file = lib_file.replace(".lib", ".test.checkcache")
+	if os.path.exists(cache_file):
+		os.remove(cache_file)
+	runs = []
+	for _ in range(3):
+		run = subprocess.run([LIBERTY2JSON_EXE, lib_file] + options + ["--check-cache", cache_file, "--outfile", os.devnull], stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+		runs.append(run.stdout)
+		if len(runs) == 2 and os.path.exists(cache_file):
+			with open(cache_file, "rb") as f:
+				cache = f.read()
+			with open(cache_file, "wb") as f:
+				f.write(cache.replace(cached_text, changed_text))
+	if os.path.exists(cache_file):
+		os.remove(cache_file)
+	return cached_text in runs[0] and runs[1] == runs[0] and runs[2] == runs[0].replace(cached_text, changed_text)
+
 def create_reference_files():
 	for file_name in os.listdir(TEST_DIR):
 		if file_name.endswith(".lib"):
@@ -22,6 +113,8 @@ def create_reference_files():
 			
 			# Run liberty2json on the .lib file to create the reference JSON file
 			subprocess.run([LIBERTY2JSON_EXE, lib_file, "--outfile", ref_file])
+	for file_name, options, ref_name in OPTION_TESTS:
+		run_option_test(os.path.join(TEST_DIR, file_name), options, os.path.join(TEST_DIR, ref_name))
 
 def run_tests():
 	# Delete old .test.json files
@@ -48,6 +141,32 @@ def run_tests():
 					print(f"Test failed for {file_name}")
 			except FileNotFoundError:
 				print(f"File not found: check {json_file} or {ref_file}")
+	for file_name, options, ref_name in OPTION_TESTS:
+		ref_file = os.path.join(TEST_DIR, ref_name)
+		test_file = ref_file.replace(".ref.", ".test.")
+		run_option_test(os.path.join(TEST_DIR, file_name), options, test_file)
+		try:
+			if same_output(test_file, ref_file):
+				print(f"Test passed for {file_name} {' '.join(options)}")
+			else:
+				print(f"Test failed for {file_name} {' '.join(options)}")
+		except FileNotFoundError:
+			print(f"File not found: check {test_file} or {ref_file}")
+
+	for file_name, cached in CACHE_TESTS:
+		if run_cache_test(os.path.join(TEST_DIR, file_name), cached):
+			print(f"Test passed for {file_name} --cache-dir")
+		else:
+			print(f"Test failed for {file_name} --cache-dir")
+
+	for file_name, options, cached_text, changed_text in CHECK_CACHE_TESTS:
+		if run_check_cache_test(os.path.join(TEST_DIR, file_name), options, cached_text, changed_text):
+			print(f"Test passed for {file_name} {' '.join(options)} --check-cache")
+		else:
+			print(f"Test failed for {file_name} {' '.join(options)} --check-cache")
+
+	# The table, formula and CCS interfaces; they print their own results
+	subprocess.run([API_TESTS_EXE, TEST_DIR])
 
 if __name__ == "__main__":
 	# create_reference_files()